@@ -0,0 +1,130 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include "audio/adpcm_decoder.h"
+
+
+// Size of the header at the start of each block
+#define ADPCM_BLOCK_HEADER_SIZE 4
+
+// Largest valid step index
+#define ADPCM_MAX_STEP_INDEX 88
+
+
+// IMA-ADPCM quantizer step sizes
+static const int16_t AdpcmStepTable[ADPCM_MAX_STEP_INDEX + 1] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+// IMA-ADPCM step index adjustment per nibble
+static const int8_t AdpcmIndexTable[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+
+static inline int16_t decode_nibble(adpcm_decoder_t* decoder, uint8_t nibble) {
+    const int32_t step = AdpcmStepTable[decoder->stepIndex];
+
+    int32_t difference = step >> 3;
+    if (nibble & 1) {
+        difference += step >> 2;
+    }
+    if (nibble & 2) {
+        difference += step >> 1;
+    }
+    if (nibble & 4) {
+        difference += step;
+    }
+
+    int32_t predictor = (nibble & 8) ? decoder->predictor - difference : decoder->predictor + difference;
+    if (predictor > INT16_MAX) {
+        predictor = INT16_MAX;
+    } else if (predictor < INT16_MIN) {
+        predictor = INT16_MIN;
+    }
+    decoder->predictor = predictor;
+
+    int32_t stepIndex = decoder->stepIndex + AdpcmIndexTable[nibble];
+    if (stepIndex < 0) {
+        stepIndex = 0;
+    } else if (stepIndex > ADPCM_MAX_STEP_INDEX) {
+        stepIndex = ADPCM_MAX_STEP_INDEX;
+    }
+    decoder->stepIndex = stepIndex;
+
+    return (int16_t) predictor;
+}
+
+
+void adpcm_decoder_init(adpcm_decoder_t* decoder, const uint8_t* data, size_t dataSize, size_t blockSize, uint32_t sampleCount) {
+    decoder->data = data;
+    decoder->dataSize = dataSize;
+    decoder->blockSize = blockSize;
+    decoder->samplesRemaining = blockSize > ADPCM_BLOCK_HEADER_SIZE ? sampleCount : 0;
+
+    decoder->blockOffset = 0;
+    decoder->byteInBlock = 0;
+    decoder->highNibblePending = 0;
+
+    decoder->predictor = 0;
+    decoder->stepIndex = 0;
+}
+
+size_t adpcm_decode(adpcm_decoder_t* decoder, int16_t* samples, size_t maxSamples) {
+    size_t produced = 0;
+    while ((produced < maxSamples) && (decoder->samplesRemaining > 0)) {
+        // Start of a block - The header carries the first sample
+        if (decoder->byteInBlock == 0) {
+            if (decoder->blockOffset + ADPCM_BLOCK_HEADER_SIZE > decoder->dataSize) {
+                decoder->samplesRemaining = 0;
+                break;
+            }
+
+            const uint8_t* header = decoder->data + decoder->blockOffset;
+            decoder->predictor = (int16_t) (header[0] | (header[1] << 8));
+            decoder->stepIndex = header[2] > ADPCM_MAX_STEP_INDEX ? ADPCM_MAX_STEP_INDEX : header[2];
+            decoder->byteInBlock = ADPCM_BLOCK_HEADER_SIZE;
+            decoder->highNibblePending = 0;
+
+            samples[produced++] = (int16_t) decoder->predictor;
+            decoder->samplesRemaining--;
+            continue;
+        }
+
+        // Decode as many nibbles as possible from the current block
+        const size_t blockEnd = decoder->blockOffset + decoder->blockSize < decoder->dataSize ? decoder->blockOffset + decoder->blockSize : decoder->dataSize;
+        const uint8_t* cursor = decoder->data + decoder->blockOffset + decoder->byteInBlock;
+        const uint8_t* const end = decoder->data + blockEnd;
+
+        while ((cursor < end) && (produced < maxSamples) && (decoder->samplesRemaining > 0)) {
+            if (decoder->highNibblePending) {
+                samples[produced++] = decode_nibble(decoder, *cursor >> 4);
+                decoder->highNibblePending = 0;
+                cursor++;
+            } else {
+                samples[produced++] = decode_nibble(decoder, *cursor & 0x0F);
+                decoder->highNibblePending = 1;
+            }
+            decoder->samplesRemaining--;
+        }
+
+        decoder->byteInBlock = cursor - (decoder->data + decoder->blockOffset);
+
+        // Move to the next block once this one is consumed
+        if (cursor >= end) {
+            if (blockEnd >= decoder->dataSize) {
+                decoder->samplesRemaining = 0;
+            }
+            decoder->blockOffset += decoder->blockSize;
+            decoder->byteInBlock = 0;
+        }
+    }
+
+    return produced;
+}
@@ -0,0 +1,42 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+// -----------------------------------------------------------------------------------
+// IMA-ADPCM (mono, 4 bits per sample) block decoder
+//
+// Data is organized in blocks of 'blockSize' bytes, as in WAV IMA-ADPCM:
+//  * 4 bytes header: int16_t predictor (little endian), uint8_t step index, uint8_t reserved
+//  * (blockSize - 4) bytes of nibbles, low nibble first
+// Each block yields 1 + 2 * (blockSize - 4) samples. The header sample is the first sample.
+// The decoder reads straight from 'data' (flash mapped memory) and keeps no copy of it
+// -----------------------------------------------------------------------------------
+
+typedef struct {
+    const uint8_t* data;
+    size_t dataSize;
+    size_t blockSize;
+    uint32_t samplesRemaining;
+
+    size_t blockOffset;
+    size_t byteInBlock;
+    uint8_t highNibblePending;
+
+    int32_t predictor;
+    int32_t stepIndex;
+} adpcm_decoder_t;
+
+
+void adpcm_decoder_init(adpcm_decoder_t* decoder, const uint8_t* data, size_t dataSize, size_t blockSize, uint32_t sampleCount);
+size_t adpcm_decode(adpcm_decoder_t* decoder, int16_t* samples, size_t maxSamples);
+
+static inline bool adpcm_decoder_done(const adpcm_decoder_t* decoder) {
+    return decoder->samplesRemaining == 0;
+}
@@ -0,0 +1,202 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <string.h>
+#include <math.h>
+
+#include <esp_timer.h>
+
+#include "sdkconfig.h"
+
+#include "audio/audio_snapshot_ring.h"
+#include "audio/audio_level.h"
+#include "audio/audio_analysis.h"
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+#include "audio/audio_spectrum.h"
+#endif
+
+
+// Rate the mono signal is decimated to before filtering
+static const uint32_t AnalysisTargetRate = 11025;
+
+// Band edges - One low pass filter per edge
+#define AUDIO_ANALYSIS_EDGE_COUNT (AudioAnalysisBandCount - 1)
+static const float BandEdgesHz[AUDIO_ANALYSIS_EDGE_COUNT] = { 150.0f, 600.0f, 2500.0f };
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+// Decimated samples handed to the spectrum analyzer at once
+#define AUDIO_ANALYSIS_SPECTRUM_CHUNK 64
+#endif
+
+
+// Analysis state - Only accessed by the I2S task
+typedef struct {
+    uint32_t sampleRate;
+    uint32_t decimation;
+
+    // Decimator - Box filter over 'decimation' mono samples, carried over between blocks
+    int32_t decimatorSum;
+    uint32_t decimatorCount;
+
+    // One pole low pass filters - Q15 coefficients, state in sample units
+    int32_t lowPassCoefficients[AUDIO_ANALYSIS_EDGE_COUNT];
+    int32_t lowPassStates[AUDIO_ANALYSIS_EDGE_COUNT];
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+    uint32_t spectrumChunkCount;
+    int64_t spectrumChunkPlayoutTimeUs;
+    int16_t spectrumChunk[AUDIO_ANALYSIS_SPECTRUM_CHUNK];
+#endif
+} audio_analysis_state_t;
+
+static audio_analysis_state_t s_analysis;
+
+
+// Snapshots ordered by playout time
+static audio_analysis_snapshot_t s_snapshots[AUDIO_SNAPSHOT_RING_SLOTS];
+static audio_snapshot_ring_t s_snapshot_ring = AUDIO_SNAPSHOT_RING_INITIALIZER(s_snapshots);
+
+
+static void configure_analysis(uint32_t sampleRate);
+static void publish_snapshot(uint16_t rms, uint16_t peak, const uint16_t* bands, int64_t playoutTimeUs);
+
+
+void analyze_audio_block(const int16_t* samples, uint32_t frameCount, uint8_t channelCount, uint32_t sampleRate, int64_t playoutTimeUs) {
+    if ((frameCount == 0) || (channelCount == 0) || (sampleRate == 0)) {
+        return;
+    }
+    if (sampleRate != s_analysis.sampleRate) {
+        configure_analysis(sampleRate);
+    }
+
+    int32_t peak = 0;
+    uint64_t energy = 0;
+    uint64_t bandEnergies[AudioAnalysisBandCount] = { 0 };
+    uint32_t decimatedCount = 0;
+
+    const uint32_t decimation = s_analysis.decimation;
+    int32_t decimatorSum = s_analysis.decimatorSum;
+    uint32_t decimatorCount = s_analysis.decimatorCount;
+
+    for (uint32_t frameIndex = 0; frameIndex < frameCount; frameIndex++) {
+        // Mono down mix and peak on every frame
+        const int16_t* frame = &samples[frameIndex * channelCount];
+        int32_t mono = frame[0];
+        int32_t magnitude = mono < 0 ? -mono : mono;
+        if (channelCount > 1) {
+            const int32_t right = frame[1];
+            const int32_t rightMagnitude = right < 0 ? -right : right;
+            magnitude = rightMagnitude > magnitude ? rightMagnitude : magnitude;
+            mono = (mono + right) >> 1;
+        }
+        peak = magnitude > peak ? magnitude : peak;
+
+        decimatorSum += mono;
+        if (++decimatorCount < decimation) {
+            continue;
+        }
+
+        // Decimated sample - Level and band split
+        const int32_t sample = decimatorSum / (int32_t) decimation;
+        decimatorSum = 0;
+        decimatorCount = 0;
+        decimatedCount++;
+
+        energy += (uint64_t) (sample * sample);
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+        // Batch decimated samples for the spectrum analyzer - A chunk carries the playout time of its first sample
+        if (s_analysis.spectrumChunkCount == 0) {
+            s_analysis.spectrumChunkPlayoutTimeUs = playoutTimeUs + ((int64_t) frameIndex * 1000000) / sampleRate;
+        }
+        s_analysis.spectrumChunk[s_analysis.spectrumChunkCount++] = (int16_t) sample;
+        if (s_analysis.spectrumChunkCount == AUDIO_ANALYSIS_SPECTRUM_CHUNK) {
+            submit_audio_spectrum_samples(s_analysis.spectrumChunk, AUDIO_ANALYSIS_SPECTRUM_CHUNK, s_analysis.sampleRate / decimation, s_analysis.spectrumChunkPlayoutTimeUs);
+            s_analysis.spectrumChunkCount = 0;
+        }
+#endif
+
+        int32_t upper = sample;
+        for (uint32_t edge = AUDIO_ANALYSIS_EDGE_COUNT; edge > 0; edge--) {
+            // |sample - state| < 2^16 and coefficients < 2^15 - The product fits in 32 bits
+            int32_t* state = &s_analysis.lowPassStates[edge - 1];
+            *state += (s_analysis.lowPassCoefficients[edge - 1] * (sample - *state) + (1 << 14)) >> 15;
+
+            const int32_t band = upper - *state;
+            bandEnergies[edge] += (uint64_t) ((int64_t) band * band);
+            upper = *state;
+        }
+        bandEnergies[AudioAnalysisBandBass] += (uint64_t) ((int64_t) upper * upper);
+    }
+
+    s_analysis.decimatorSum = decimatorSum;
+    s_analysis.decimatorCount = decimatorCount;
+
+    // Short blocks may not complete a decimated sample - Levels are then carried by the next block
+    if (decimatedCount == 0) {
+        return;
+    }
+
+    uint16_t bands[AudioAnalysisBandCount];
+    for (uint32_t band = 0; band < AudioAnalysisBandCount; band++) {
+        bands[band] = audio_level_sqrt(bandEnergies[band] / decimatedCount);
+    }
+    publish_snapshot(audio_level_sqrt(energy / decimatedCount), (uint16_t) (peak > INT16_MAX ? INT16_MAX : peak), bands, playoutTimeUs);
+}
+
+void reset_audio_analysis() {
+    // Publish silence - Readers see levels drop when the output stops
+    s_analysis.decimatorSum = 0;
+    s_analysis.decimatorCount = 0;
+    memset(s_analysis.lowPassStates, 0, sizeof(s_analysis.lowPassStates));
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+    s_analysis.spectrumChunkCount = 0;
+    reset_audio_spectrum();
+#endif
+
+    const uint16_t silentBands[AudioAnalysisBandCount] = { 0 };
+    publish_snapshot(0, 0, silentBands, esp_timer_get_time());
+}
+
+bool get_audio_analysis_snapshot(audio_analysis_snapshot_t* snapshot) {
+    return read_latest_audio_snapshot(&s_snapshot_ring, snapshot);
+}
+
+bool get_audio_analysis_snapshot_at(int64_t timeUs, audio_analysis_snapshot_t* snapshot) {
+    return read_audio_snapshot_at(&s_snapshot_ring, timeUs, snapshot);
+}
+
+static void configure_analysis(uint32_t sampleRate) {
+    s_analysis.sampleRate = sampleRate;
+    s_analysis.decimation = sampleRate > AnalysisTargetRate ? (sampleRate + AnalysisTargetRate / 2) / AnalysisTargetRate : 1;
+    s_analysis.decimatorSum = 0;
+    s_analysis.decimatorCount = 0;
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+    s_analysis.spectrumChunkCount = 0;
+#endif
+
+    // One pole low pass: coefficient = 1 - e^(-2 * pi * fc / fs) - Edges above the decimated Nyquist frequency pass everything
+    const float decimatedRate = (float) sampleRate / s_analysis.decimation;
+    for (uint32_t edge = 0; edge < AUDIO_ANALYSIS_EDGE_COUNT; edge++) {
+        const float coefficient = 1.0f - expf(-2.0f * (float) M_PI * BandEdgesHz[edge] / decimatedRate);
+        s_analysis.lowPassCoefficients[edge] = (int32_t) lroundf(coefficient * 32767.0f);
+        s_analysis.lowPassStates[edge] = 0;
+    }
+}
+
+static void publish_snapshot(uint16_t rms, uint16_t peak, const uint16_t* bands, int64_t playoutTimeUs) {
+    uint32_t sequence = 0;
+    audio_analysis_snapshot_t* snapshot = begin_audio_snapshot(&s_snapshot_ring, &sequence);
+
+    snapshot->sequence = sequence;
+    snapshot->timestampUs = esp_timer_get_time();
+    snapshot->playoutTimeUs = playoutTimeUs;
+    snapshot->rms = rms;
+    snapshot->peak = peak;
+    memcpy(snapshot->bands, bands, sizeof(snapshot->bands));
+
+    publish_audio_snapshot(&s_snapshot_ring, playoutTimeUs);
+}
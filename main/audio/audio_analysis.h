@@ -0,0 +1,47 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// -----------------------------------------------------------------------------------
+// Audio analysis tap - Runs on the I2S task for every block written to I2S
+//
+//  * Peak is measured on every sample, everything else on a mono signal decimated to about 11kHz
+//  * Band levels come from a cascade of one pole low pass filters (integer math)
+//  * Results are published in a lock free ring of snapshots tagged with their playout time - Readers never block the I2S task
+//
+// CPU cost per frame is reported by 'audio_bench analysis' (CONFIG_HOLIDAYTREE_AUDIO_BENCHMARK)
+// -----------------------------------------------------------------------------------
+
+typedef enum {
+    AudioAnalysisBandBass = 0,      // Below 150Hz
+    AudioAnalysisBandLowMid = 1,    // 150Hz - 600Hz
+    AudioAnalysisBandHighMid = 2,   // 600Hz - 2.5kHz
+    AudioAnalysisBandTreble = 3,    // Above 2.5kHz
+    AudioAnalysisBandCount
+} audio_analysis_band_t;
+
+typedef struct {
+    uint32_t sequence;      // Incremented for every analyzed block - 0 until the first block
+    int64_t timestampUs;    // esp_timer time of the analysis
+    int64_t playoutTimeUs;  // esp_timer time the first frame of the block is predicted to reach the DAC
+    uint16_t rms;           // Levels are in 16 bits sample units (0 - 32767)
+    uint16_t peak;
+    uint16_t bands[AudioAnalysisBandCount];
+} audio_analysis_snapshot_t;
+
+
+// I2S task side
+void analyze_audio_block(const int16_t* samples, uint32_t frameCount, uint8_t channelCount, uint32_t sampleRate, int64_t playoutTimeUs);
+void reset_audio_analysis();
+
+// Any task - Returns false if a consistent snapshot could not be copied, which only happens under heavy preemption
+bool get_audio_analysis_snapshot(audio_analysis_snapshot_t* snapshot);
+
+// Any task - Levels of the audio being heard at 'timeUs' (esp_timer time)
+bool get_audio_analysis_snapshot_at(int64_t timeUs, audio_analysis_snapshot_t* snapshot);
@@ -0,0 +1,371 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <string.h>
+#include <math.h>
+
+#include <esp_timer.h>
+
+#include "audio/audio_snapshot_ring.h"
+#include "audio/audio_beat.h"
+
+
+// Frames of onset history - Must be a power of two longer than the slowest beat period
+#define AUDIO_BEAT_HISTORY 64
+
+// Bands considered for the spectral flux
+#define AUDIO_BEAT_MAX_BANDS 32
+
+// One beat in Q16
+#define AUDIO_BEAT_PHASE_ONE (1UL << 16)
+
+// Candidate beat phases scored against the onset envelope - Must be a power of two
+#define AUDIO_BEAT_PHASE_BINS 16
+#define AUDIO_BEAT_PHASE_BIN_SHIFT 12
+
+
+// Tempo range and preferred tempo
+static const float SlowestBpm = 60.0f;
+static const float FastestBpm = 180.0f;
+static const float PreferredBpm = 120.0f;
+static const float TempoPriorOctaves = 1.0f;
+
+// Adaptive threshold - Mean flux of the last frames times ThresholdRatio (Q8) plus MinimumFlux (Q8 log2 units)
+#define AUDIO_BEAT_THRESHOLD_FRAMES 16
+static const int32_t ThresholdRatio = 384;
+static const int32_t MinimumFlux = 512;
+
+// Onsets closer than this are merged
+static const float MinimumOnsetIntervalMs = 100.0f;
+
+// Autocorrelation time constant - 2^7 frames is about 3 seconds
+static const uint32_t AutocorrelationDecayShift = 7;
+
+// Confidence needed to emit beats, tempo smoothing and phase correction (Q8)
+static const uint8_t LockConfidence = 64;
+static const int32_t PeriodSmoothing = 64;
+static const int32_t PhaseCorrection = 64;
+
+// Only onsets within an eighth of a beat of the predicted beat correct the phase - Off beat onsets are ignored, larger
+// errors are left to phase acquisition
+static const int32_t PhaseCorrectionWindow = AUDIO_BEAT_PHASE_ONE / 8;
+
+// Phase score time constant - 2^6 frames is about 1.5 seconds
+static const uint32_t PhaseScoreDecayShift = 6;
+
+// Frames the best candidate phase must stay outside the correction window before the tracker jumps to it - About half a second
+static const uint32_t PhaseReacquireFrames = 24;
+
+// Frames a different tempo must win before the tracker jumps to it - About one second
+static const uint32_t TempoChangeFrames = 48;
+
+
+// Detector state - Only accessed by the spectrum analyzer task
+typedef struct {
+    uint32_t framePeriodUs;
+    uint32_t minimumLag;
+    uint32_t maximumLag;
+    uint32_t minimumOnsetFrames;
+    int32_t lagWeights[AUDIO_BEAT_HISTORY];         // Tempo prior - Q8
+
+    bool hasPreviousLogs;
+    int32_t previousLogs[AUDIO_BEAT_MAX_BANDS];     // log2 of band levels - Q8
+
+    uint32_t frameIndex;
+    int32_t flux[AUDIO_BEAT_HISTORY];
+    int32_t envelope[AUDIO_BEAT_HISTORY];           // Flux above its recent mean
+    int64_t autocorrelation[AUDIO_BEAT_HISTORY];
+    uint32_t lastOnsetFrame;
+
+    uint32_t periodQ8;                              // Beat period in frames - Q8, 0 until a tempo is found
+    uint32_t tempoChangeFrames;
+    uint32_t phase;                                 // Q16 fraction of a beat
+    int32_t phaseScores[AUDIO_BEAT_PHASE_BINS];     // Onset envelope folded on the beat, bin 0 centered on the beat
+    uint32_t phaseReacquireFrames;
+    uint8_t confidence;
+
+    uint32_t onsetCount;
+    uint32_t beatCount;
+    int64_t lastBeatUs;
+} audio_beat_state_t;
+
+static audio_beat_state_t s_beat;
+
+
+// Snapshots ordered by playout time
+static audio_beat_snapshot_t s_snapshots[AUDIO_SNAPSHOT_RING_SLOTS];
+static audio_snapshot_ring_t s_snapshot_ring = AUDIO_SNAPSHOT_RING_INITIALIZER(s_snapshots);
+
+
+static void configure_beat_detector(uint32_t framePeriodUs);
+static bool detect_onset(const uint16_t* bandLevels, uint32_t bandCount);
+static void track_tempo();
+static void acquire_phase(bool locked);
+static void publish_snapshot(int64_t playoutTimeUs);
+static int32_t log2_q8(uint32_t value);
+
+static inline int32_t flux_at(uint32_t frame) {
+    return s_beat.flux[frame & (AUDIO_BEAT_HISTORY - 1)];
+}
+
+
+void detect_audio_beat(const uint16_t* bandLevels, uint32_t bandCount, uint32_t framePeriodUs, int64_t playoutTimeUs) {
+    if ((framePeriodUs == 0) || (bandCount == 0)) {
+        return;
+    }
+    if (framePeriodUs != s_beat.framePeriodUs) {
+        configure_beat_detector(framePeriodUs);
+    }
+
+    const bool onset = detect_onset(bandLevels, bandCount);
+    track_tempo();
+
+    // The onset peak was the previous frame - Pull the phase the previous frame had towards a beat
+    const bool locked = (s_beat.periodQ8 > 0) && (s_beat.confidence >= LockConfidence);
+    if (onset) {
+        s_beat.onsetCount++;
+        const int32_t error = s_beat.phase < AUDIO_BEAT_PHASE_ONE / 2 ? (int32_t) s_beat.phase : (int32_t) s_beat.phase - (int32_t) AUDIO_BEAT_PHASE_ONE;
+        if ((s_beat.periodQ8 > 0) && (error < PhaseCorrectionWindow) && (error > -PhaseCorrectionWindow)) {
+            s_beat.phase = (uint32_t) ((int32_t) s_beat.phase - ((error * PhaseCorrection) >> 8)) & (AUDIO_BEAT_PHASE_ONE - 1);
+        }
+    }
+    if (s_beat.periodQ8 > 0) {
+        acquire_phase(locked);
+    }
+
+    // Advance one frame - A wrap is a beat
+    if (s_beat.periodQ8 > 0) {
+        s_beat.phase += (AUDIO_BEAT_PHASE_ONE << 8) / s_beat.periodQ8;
+        if (s_beat.phase >= AUDIO_BEAT_PHASE_ONE) {
+            s_beat.phase -= AUDIO_BEAT_PHASE_ONE;
+            if (locked) {
+                s_beat.beatCount++;
+                s_beat.lastBeatUs = playoutTimeUs;
+            }
+        }
+    }
+
+    s_beat.frameIndex++;
+    publish_snapshot(playoutTimeUs);
+}
+
+void reset_audio_beat_detector() {
+    // Keep counters - Readers compare them to detect new onsets and beats
+    const uint32_t onsetCount = s_beat.onsetCount;
+    const uint32_t beatCount = s_beat.beatCount;
+    const int64_t lastBeatUs = s_beat.lastBeatUs;
+    const uint32_t framePeriodUs = s_beat.framePeriodUs;
+
+    memset(&s_beat, 0, sizeof(s_beat));
+    s_beat.onsetCount = onsetCount;
+    s_beat.beatCount = beatCount;
+    s_beat.lastBeatUs = lastBeatUs;
+    if (framePeriodUs > 0) {
+        configure_beat_detector(framePeriodUs);
+    }
+
+    publish_snapshot(esp_timer_get_time());
+}
+
+bool get_audio_beat_snapshot(audio_beat_snapshot_t* snapshot) {
+    return read_latest_audio_snapshot(&s_snapshot_ring, snapshot);
+}
+
+bool get_audio_beat_snapshot_at(int64_t timeUs, audio_beat_snapshot_t* snapshot) {
+    return read_audio_snapshot_at(&s_snapshot_ring, timeUs, snapshot);
+}
+
+static void configure_beat_detector(uint32_t framePeriodUs) {
+    s_beat.framePeriodUs = framePeriodUs;
+
+    // Lags are in frames - The slowest tempo must fit in the history
+    const float framesPerMinute = 60e6f / framePeriodUs;
+    s_beat.minimumLag = (uint32_t) ceilf(framesPerMinute / FastestBpm);
+    s_beat.maximumLag = (uint32_t) floorf(framesPerMinute / SlowestBpm);
+    s_beat.maximumLag = s_beat.maximumLag > AUDIO_BEAT_HISTORY - 2 ? AUDIO_BEAT_HISTORY - 2 : s_beat.maximumLag;
+    s_beat.minimumLag = s_beat.minimumLag < 2 ? 2 : s_beat.minimumLag;
+    s_beat.minimumOnsetFrames = (uint32_t) ceilf(MinimumOnsetIntervalMs * 1000.0f / framePeriodUs);
+
+    // Log normal prior centered on the preferred tempo
+    for (uint32_t lag = 0; lag < AUDIO_BEAT_HISTORY; lag++) {
+        const float octaves = lag > 0 ? log2f(framesPerMinute / lag / PreferredBpm) / TempoPriorOctaves : 0.0f;
+        s_beat.lagWeights[lag] = (int32_t) lroundf(256.0f * expf(-0.5f * octaves * octaves));
+    }
+
+    // History is meaningless at another frame rate
+    s_beat.hasPreviousLogs = false;
+    memset(s_beat.flux, 0, sizeof(s_beat.flux));
+    memset(s_beat.envelope, 0, sizeof(s_beat.envelope));
+    memset(s_beat.autocorrelation, 0, sizeof(s_beat.autocorrelation));
+    s_beat.periodQ8 = 0;
+    s_beat.tempoChangeFrames = 0;
+    s_beat.phase = 0;
+    memset(s_beat.phaseScores, 0, sizeof(s_beat.phaseScores));
+    s_beat.phaseReacquireFrames = 0;
+    s_beat.confidence = 0;
+}
+
+static bool detect_onset(const uint16_t* bandLevels, uint32_t bandCount) {
+    bandCount = bandCount > AUDIO_BEAT_MAX_BANDS ? AUDIO_BEAT_MAX_BANDS : bandCount;
+
+    // Spectral flux - Log compression makes it independent of the volume
+    int32_t flux = 0;
+    for (uint32_t band = 0; band < bandCount; band++) {
+        const int32_t level = log2_q8((uint32_t) bandLevels[band] + 1);
+        const int32_t increase = level - s_beat.previousLogs[band];
+        flux += (s_beat.hasPreviousLogs && (increase > 0)) ? increase : 0;
+        s_beat.previousLogs[band] = level;
+    }
+    s_beat.hasPreviousLogs = true;
+
+    // Threshold from the frames before the candidate peak
+    const uint32_t frame = s_beat.frameIndex;
+    int32_t fluxSum = 0;
+    for (uint32_t offset = 2; offset < AUDIO_BEAT_THRESHOLD_FRAMES + 2; offset++) {
+        fluxSum += flux_at(frame - offset);
+    }
+    const int32_t meanFlux = fluxSum / AUDIO_BEAT_THRESHOLD_FRAMES;
+
+    s_beat.flux[frame & (AUDIO_BEAT_HISTORY - 1)] = flux;
+    s_beat.envelope[frame & (AUDIO_BEAT_HISTORY - 1)] = flux > meanFlux ? flux - meanFlux : 0;
+
+    // The previous frame is an onset when it is a local maximum above the threshold
+    const int32_t candidate = flux_at(frame - 1);
+    const int32_t threshold = ((meanFlux * ThresholdRatio) >> 8) + MinimumFlux;
+    if ((frame < 2) || (candidate <= threshold) || (candidate <= flux_at(frame - 2)) || (candidate < flux)) {
+        return false;
+    }
+    if ((s_beat.onsetCount > 0) && (frame - 1 - s_beat.lastOnsetFrame < s_beat.minimumOnsetFrames)) {
+        return false;
+    }
+
+    s_beat.lastOnsetFrame = frame - 1;
+    return true;
+}
+
+static void track_tempo() {
+    // Running autocorrelation of the onset envelope - One product per candidate lag and frame
+    const uint32_t frame = s_beat.frameIndex;
+    const int64_t current = s_beat.envelope[frame & (AUDIO_BEAT_HISTORY - 1)];
+    for (uint32_t lag = s_beat.minimumLag - 1; lag <= s_beat.maximumLag + 1; lag++) {
+        const int64_t product = current * s_beat.envelope[(frame - lag) & (AUDIO_BEAT_HISTORY - 1)];
+        s_beat.autocorrelation[lag] += (product - s_beat.autocorrelation[lag]) >> AutocorrelationDecayShift;
+    }
+
+    // Strongest weighted lag
+    uint32_t bestLag = 0;
+    int64_t bestScore = 0;
+    int64_t scoreSum = 0;
+    for (uint32_t lag = s_beat.minimumLag; lag <= s_beat.maximumLag; lag++) {
+        const int64_t score = (s_beat.autocorrelation[lag] * s_beat.lagWeights[lag]) >> 8;
+        scoreSum += score;
+        if (score > bestScore) {
+            bestScore = score;
+            bestLag = lag;
+        }
+    }
+    if (bestLag == 0) {
+        s_beat.confidence = 0;
+        return;
+    }
+
+    // Confidence - How much the best lag stands out
+    const int64_t meanScore = scoreSum / (int64_t) (s_beat.maximumLag - s_beat.minimumLag + 1);
+    const int64_t confidence = ((bestScore - meanScore) * 255) / bestScore;
+    s_beat.confidence = (uint8_t) (confidence < 0 ? 0 : (confidence > 255 ? 255 : confidence));
+
+    // Parabolic interpolation around the best lag for a fractional period
+    const int64_t before = s_beat.autocorrelation[bestLag - 1];
+    const int64_t peak = s_beat.autocorrelation[bestLag];
+    const int64_t after = s_beat.autocorrelation[bestLag + 1];
+    const int64_t curvature = before - 2 * peak + after;
+    int64_t offsetQ8 = curvature < 0 ? ((before - after) * 128) / curvature : 0;
+    offsetQ8 = offsetQ8 > 128 ? 128 : (offsetQ8 < -128 ? -128 : offsetQ8);
+    const uint32_t periodQ8 = (uint32_t) ((int64_t) (bestLag << 8) + offsetQ8);
+
+    // Follow small tempo changes smoothly, jump to a new tempo once it has been winning for a while
+    const uint32_t difference = periodQ8 > s_beat.periodQ8 ? periodQ8 - s_beat.periodQ8 : s_beat.periodQ8 - periodQ8;
+    if (difference > s_beat.periodQ8 / 8) {
+        if ((s_beat.periodQ8 == 0) || (++s_beat.tempoChangeFrames >= TempoChangeFrames)) {
+            s_beat.periodQ8 = periodQ8;
+            s_beat.tempoChangeFrames = 0;
+        }
+    } else {
+        s_beat.tempoChangeFrames = 0;
+        s_beat.periodQ8 = (uint32_t) ((int32_t) s_beat.periodQ8 + ((((int32_t) periodQ8 - (int32_t) s_beat.periodQ8) * PeriodSmoothing) >> 8));
+    }
+}
+
+static void acquire_phase(bool locked) {
+    // Fold the envelope of the previous frame on the beat - Same alignment as onsets
+    const uint32_t frameBin = ((s_beat.phase + (1UL << (AUDIO_BEAT_PHASE_BIN_SHIFT - 1))) >> AUDIO_BEAT_PHASE_BIN_SHIFT) & (AUDIO_BEAT_PHASE_BINS - 1);
+    for (uint32_t bin = 0; bin < AUDIO_BEAT_PHASE_BINS; bin++) {
+        s_beat.phaseScores[bin] -= s_beat.phaseScores[bin] >> PhaseScoreDecayShift;
+    }
+    s_beat.phaseScores[frameBin] += s_beat.envelope[(s_beat.frameIndex - 1) & (AUDIO_BEAT_HISTORY - 1)];
+
+    // Best candidate phase with its neighbours - Onsets spread over two bins
+    uint32_t bestBin = 0;
+    int32_t bestScore = 0;
+    int32_t beatScore = 0;
+    for (uint32_t bin = 0; bin < AUDIO_BEAT_PHASE_BINS; bin++) {
+        const int32_t score = s_beat.phaseScores[(bin - 1) & (AUDIO_BEAT_PHASE_BINS - 1)] + 2 * s_beat.phaseScores[bin] + s_beat.phaseScores[(bin + 1) & (AUDIO_BEAT_PHASE_BINS - 1)];
+        beatScore = bin == 0 ? score : beatScore;
+        if (score > bestScore) {
+            bestScore = score;
+            bestBin = bin;
+        }
+    }
+
+    // Onsets correct small errors - Jump to a candidate outside the window once it has been winning for a while, at once before lock
+    const int32_t error = (int32_t) (bestBin << AUDIO_BEAT_PHASE_BIN_SHIFT) - (bestBin < AUDIO_BEAT_PHASE_BINS / 2 ? 0 : (int32_t) AUDIO_BEAT_PHASE_ONE);
+    if ((bestScore <= beatScore) || ((error < PhaseCorrectionWindow) && (error > -PhaseCorrectionWindow))) {
+        s_beat.phaseReacquireFrames = 0;
+        return;
+    }
+    if (locked && (++s_beat.phaseReacquireFrames < PhaseReacquireFrames)) {
+        return;
+    }
+
+    // Move the beat onto the candidate, between bins by parabolic interpolation, and rotate the scores with it
+    const int32_t before = s_beat.phaseScores[(bestBin - 1) & (AUDIO_BEAT_PHASE_BINS - 1)];
+    const int32_t peak = s_beat.phaseScores[bestBin];
+    const int32_t after = s_beat.phaseScores[(bestBin + 1) & (AUDIO_BEAT_PHASE_BINS - 1)];
+    const int64_t curvature = (int64_t) before - 2 * peak + after;
+    int64_t offset = curvature < 0 ? (((int64_t) before - after) << (AUDIO_BEAT_PHASE_BIN_SHIFT - 1)) / curvature : 0;
+    offset = offset > (1 << (AUDIO_BEAT_PHASE_BIN_SHIFT - 1)) ? (1 << (AUDIO_BEAT_PHASE_BIN_SHIFT - 1)) : (offset < -(1 << (AUDIO_BEAT_PHASE_BIN_SHIFT - 1)) ? -(1 << (AUDIO_BEAT_PHASE_BIN_SHIFT - 1)) : offset);
+
+    int32_t scores[AUDIO_BEAT_PHASE_BINS];
+    memcpy(scores, s_beat.phaseScores, sizeof(scores));
+    for (uint32_t bin = 0; bin < AUDIO_BEAT_PHASE_BINS; bin++) {
+        s_beat.phaseScores[bin] = scores[(bin + bestBin) & (AUDIO_BEAT_PHASE_BINS - 1)];
+    }
+    s_beat.phase = (uint32_t) ((int64_t) s_beat.phase - (int64_t) (bestBin << AUDIO_BEAT_PHASE_BIN_SHIFT) - offset) & (AUDIO_BEAT_PHASE_ONE - 1);
+    s_beat.phaseReacquireFrames = 0;
+}
+
+static void publish_snapshot(int64_t playoutTimeUs) {
+    uint32_t sequence = 0;
+    audio_beat_snapshot_t* snapshot = begin_audio_snapshot(&s_snapshot_ring, &sequence);
+
+    const bool locked = (s_beat.periodQ8 > 0) && (s_beat.confidence >= LockConfidence);
+    snapshot->sequence = sequence;
+    snapshot->timestampUs = esp_timer_get_time();
+    snapshot->playoutTimeUs = playoutTimeUs;
+    snapshot->onsetCount = s_beat.onsetCount;
+    snapshot->beatCount = s_beat.beatCount;
+    snapshot->lastBeatUs = s_beat.lastBeatUs;
+    snapshot->bpm = locked ? (uint16_t) ((60000000ULL * 16 * 256) / ((uint64_t) s_beat.framePeriodUs * s_beat.periodQ8)) : 0;
+    snapshot->beatPhase = (uint16_t) s_beat.phase;
+    snapshot->confidence = s_beat.confidence;
+
+    publish_audio_snapshot(&s_snapshot_ring, playoutTimeUs);
+}
+
+static int32_t log2_q8(uint32_t value) {
+    // Leading bit plus the next 8 bits as a linear fraction
+    const int32_t leadingBit = 31 - __builtin_clz(value);
+    const uint32_t mantissa = leadingBit >= 8 ? value >> (leadingBit - 8) : value << (8 - leadingBit);
+    return (leadingBit << 8) + (int32_t) (mantissa & 0xFF);
+}
@@ -0,0 +1,45 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// -----------------------------------------------------------------------------------
+// Onset detection and tempo tracking - Runs on the spectrum analyzer task, once per spectrum frame
+//
+//  * Onsets are peaks of the spectral flux (sum of band level increases, log compressed) above an adaptive threshold
+//  * The tempo comes from a running autocorrelation of the onset envelope between 60 and 180 BPM, weighted towards 120 BPM
+//  * A beat phase runs at the tracked tempo and is pulled towards onsets - Beats are emitted on every phase wrap once locked
+//  * Candidate phases (sixteenths of a beat) are scored against the onset envelope folded on the beat - The phase jumps to a
+//    better candidate at once before lock, and after it has been winning for about half a second once locked
+//  * Fixed size state, no allocation
+//
+// Results are published in a lock free ring of snapshots tagged with their playout time, like the analysis tap
+// -----------------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t sequence;      // Incremented for every analyzed frame - 0 until the first frame
+    int64_t timestampUs;    // esp_timer time of the frame
+    int64_t playoutTimeUs;  // esp_timer time the newest sample of the frame is predicted to reach the DAC
+    uint32_t onsetCount;    // Onsets detected since start up
+    uint32_t beatCount;     // Beats emitted by the tempo tracker since start up
+    int64_t lastBeatUs;     // Playout time of the last beat
+    uint16_t bpm;           // Tracked tempo in beats per minute - Q4, 0 when not locked
+    uint16_t beatPhase;     // Position in the current beat - Q16 fraction of a beat
+    uint8_t confidence;     // Tempo confidence - 0 to 255
+} audio_beat_snapshot_t;
+
+
+// Spectrum analyzer task side - 'bandLevels' are unsmoothed band levels, lowest frequencies first
+void detect_audio_beat(const uint16_t* bandLevels, uint32_t bandCount, uint32_t framePeriodUs, int64_t playoutTimeUs);
+void reset_audio_beat_detector();
+
+// Any task - Returns false if a consistent snapshot could not be copied, which only happens under heavy preemption
+bool get_audio_beat_snapshot(audio_beat_snapshot_t* snapshot);
+
+// Any task - Beat state of the audio being heard at 'timeUs' (esp_timer time)
+bool get_audio_beat_snapshot_at(int64_t timeUs, audio_beat_snapshot_t* snapshot);
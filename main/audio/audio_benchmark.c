@@ -0,0 +1,445 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <esp_cpu.h>
+#include <esp_console.h>
+
+
+#include "audio/adpcm_decoder.h"
+#include "audio/audio_mixer.h"
+#include "audio/audio_resampler.h"
+#include "audio/audio_silence.h"
+#include "audio/audio_analysis.h"
+#include "audio/fixed_fft.h"
+#include "audio/sound_bank.h"
+#include "audio/audio_benchmark.h"
+
+#include "bt/i2s_output.h"
+
+
+#if CONFIG_HOLIDAYTREE_AUDIO_BENCHMARK
+
+// Audio benchmark log tag
+static const char* AudioBenchmarkTag = "audio_bench";
+
+
+// Number of samples produced per decoder call - Matches the I2S write size order of magnitude
+#define BENCHMARK_CHUNK_SAMPLES 512
+
+// Synthetic ADPCM data - Used when no sound bank is flashed, for instance under QEMU
+static const size_t SyntheticAdpcmBlockSize = 256;
+static const size_t SyntheticAdpcmBlockCount = 16;
+static const uint32_t SyntheticAdpcmIterations = 64;
+static const uint32_t SyntheticAdpcmSampleRate = 22050;
+
+// Mixer benchmark - One I2S write worth of 16 bits stereo frames at 44.1kHz
+static const uint32_t MixerBenchmarkFrames = 1023;
+static const uint32_t MixerBenchmarkSampleRate = 44100;
+static const uint32_t MixerBenchmarkIterations = 8;
+
+// Silence detection benchmark - Silent blocks are the worst case since every sample is read
+static const uint32_t SilenceBenchmarkIterations = 64;
+
+// Analysis benchmark
+static const uint32_t AnalysisBenchmarkIterations = 64;
+
+// FFT benchmark - The spectrum analyzer runs one transform per 256 samples decimated to about 11kHz
+static const uint32_t FftBenchmarkIterations = 64;
+static const uint32_t FftBenchmarkSampleRate = 11025;
+static const uint32_t FftBenchmarkHop = FIXED_FFT_SIZE / 2;
+
+// Resampler benchmark - Input frames per call and conversions measured
+#define RESAMPLER_BENCHMARK_FRAMES 512
+static const uint32_t ResamplerBenchmarkIterations = 32;
+typedef struct {
+    uint32_t inputRate;
+    uint32_t outputRate;
+    uint8_t channelCount;
+} resampler_benchmark_case_t;
+static const resampler_benchmark_case_t ResamplerBenchmarkCases[] = {
+    { .inputRate = 44100, .outputRate = 48000, .channelCount = 2 },
+    { .inputRate = 48000, .outputRate = 44100, .channelCount = 2 },
+    { .inputRate = 22050, .outputRate = 48000, .channelCount = 1 },
+    { .inputRate = 22050, .outputRate = 44100, .channelCount = 1 }
+};
+
+
+typedef struct {
+    uint64_t samples;
+    uint64_t elapsedUs;
+    uint64_t cycles;
+} benchmark_result_t;
+
+
+static uint8_t* create_synthetic_adpcm_data(size_t* dataSize, uint32_t* sampleCount);
+static void benchmark_adpcm_decoder(const uint8_t* data, size_t dataSize, size_t blockSize, uint32_t sampleCount, uint32_t iterations, benchmark_result_t* result);
+static void print_benchmark_result(const char* const name, const benchmark_result_t* const result, const char* const unit);
+
+static int run_adpcm_benchmark();
+static int run_mixer_benchmark();
+static int run_resampler_benchmark();
+static int run_silence_benchmark();
+static int run_analysis_benchmark();
+static int run_fft_benchmark();
+static int audio_benchmark_console_command(int argc, char** argv);
+
+
+esp_err_t register_audio_benchmark_console_command() {
+    const esp_console_cmd_t benchmarkCommand = {
+        .command = "audio_bench",
+        .help = "Benchmark audio processing - 'audio_bench adpcm|mixer|src|silence|analysis|fft'",
+        .hint = NULL,
+        .func = &audio_benchmark_console_command
+    };
+
+    ESP_RETURN_ON_ERROR(esp_console_cmd_register(&benchmarkCommand), AudioBenchmarkTag, "esp_console_cmd_register() failed");
+    return ESP_OK;
+}
+
+static int audio_benchmark_console_command(int argc, char** argv) {
+    const char* const benchmarkName = argc > 1 ? argv[1] : "adpcm";
+
+    if (strcmp(benchmarkName, "adpcm") == 0) {
+        return run_adpcm_benchmark();
+    }
+    if (strcmp(benchmarkName, "mixer") == 0) {
+        return run_mixer_benchmark();
+    }
+    if (strcmp(benchmarkName, "src") == 0) {
+        return run_resampler_benchmark();
+    }
+    if (strcmp(benchmarkName, "silence") == 0) {
+        return run_silence_benchmark();
+    }
+    if (strcmp(benchmarkName, "analysis") == 0) {
+        return run_analysis_benchmark();
+    }
+    if (strcmp(benchmarkName, "fft") == 0) {
+        return run_fft_benchmark();
+    }
+
+    printf("Unknown benchmark '%s'\n", benchmarkName);
+    return 1;
+}
+
+static int run_adpcm_benchmark() {
+    size_t syntheticSize = 0;
+    uint32_t syntheticSampleCount = 0;
+    uint8_t* syntheticData = create_synthetic_adpcm_data(&syntheticSize, &syntheticSampleCount);
+    if (syntheticData == NULL) {
+        printf("Not enough memory for synthetic ADPCM data\n");
+        return 1;
+    }
+
+    benchmark_result_t result = { 0 };
+    benchmark_adpcm_decoder(syntheticData, syntheticSize, SyntheticAdpcmBlockSize, syntheticSampleCount, SyntheticAdpcmIterations, &result);
+    print_benchmark_result("adpcm (RAM)", &result, "sample");
+
+    heap_caps_free(syntheticData);
+
+    // Every sound of the bank - Decoded straight from flash mapped memory like during playback
+    for (uint32_t soundIndex = 0; soundIndex < get_sound_bank_sound_count(); soundIndex++) {
+        sound_bank_sound_t sound;
+        if (get_sound_bank_sound(soundIndex, &sound) == ESP_OK) {
+            char name[32];
+            snprintf(name, sizeof(name), "adpcm (flash #%lu)", soundIndex);
+            memset(&result, 0, sizeof(result));
+            benchmark_adpcm_decoder(sound.data, sound.dataSize, sound.blockSize, sound.sampleCount, 1, &result);
+            print_benchmark_result(name, &result, "sample");
+        }
+    }
+
+    return 0;
+}
+
+static int run_mixer_benchmark() {
+    // A mixer of its own - The one of the I2S output keeps playing undisturbed
+    size_t syntheticSize = 0;
+    uint32_t syntheticSampleCount = 0;
+    uint8_t* syntheticData = create_synthetic_adpcm_data(&syntheticSize, &syntheticSampleCount);
+    int16_t* samples = heap_caps_malloc(MixerBenchmarkFrames * 2 * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    audio_mixer_t* mixer = heap_caps_malloc(sizeof(audio_mixer_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if ((syntheticData == NULL) || (samples == NULL) || (mixer == NULL)) {
+        printf("Not enough memory for the mixer benchmark\n");
+        heap_caps_free(syntheticData);
+        heap_caps_free(samples);
+        heap_caps_free(mixer);
+        return 1;
+    }
+    audio_mixer_init(mixer);
+
+    const sound_bank_sound_t syntheticSound = {
+        .data = syntheticData,
+        .dataSize = syntheticSize,
+        .sampleCount = syntheticSampleCount,
+        .sampleRate = SyntheticAdpcmSampleRate,
+        .blockSize = SyntheticAdpcmBlockSize
+    };
+
+    // A2DP stream alone, then with an increasing number of effect voices - Effect voices are resampled to the output rate
+    for (uint32_t voiceCount = 0; voiceCount <= CONFIG_HOLIDAYTREE_AUDIO_MIXER_VOICES; voiceCount++) {
+        benchmark_result_t result = { 0 };
+        for (uint32_t iteration = 0; iteration < MixerBenchmarkIterations; iteration++) {
+            for (uint32_t voice = 0; voice < voiceCount; voice++) {
+                start_audio_mixer_voice(mixer, &syntheticSound, AudioMixerUnityGain / 2);
+            }
+            for (uint32_t sampleIndex = 0; sampleIndex < MixerBenchmarkFrames * 2; sampleIndex++) {
+                samples[sampleIndex] = (int16_t) (sampleIndex * 97);
+            }
+
+            const uint64_t startUs = esp_timer_get_time();
+            const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+            mix_audio_block(mixer, samples, MixerBenchmarkFrames, 2, MixerBenchmarkSampleRate, true, AudioMixerUnityGain);
+            result.cycles += esp_cpu_get_cycle_count() - startCycles;
+            result.elapsedUs += esp_timer_get_time() - startUs;
+            result.samples += MixerBenchmarkFrames;
+
+            // Release the voices outside of the measurement
+            stop_all_audio_mixer_voices(mixer);
+            mix_audio_block(mixer, samples, MixerBenchmarkFrames, 2, MixerBenchmarkSampleRate, false, AudioMixerUnityGain);
+        }
+
+        char name[32];
+        snprintf(name, sizeof(name), "mixer (%lu voices)", voiceCount);
+        print_benchmark_result(name, &result, "frame");
+    }
+
+    heap_caps_free(syntheticData);
+    heap_caps_free(samples);
+    heap_caps_free(mixer);
+    return 0;
+}
+
+static int run_resampler_benchmark() {
+    const size_t outputFramesCapacity = 3 * RESAMPLER_BENCHMARK_FRAMES;
+    int16_t* input = heap_caps_malloc(RESAMPLER_BENCHMARK_FRAMES * AUDIO_RESAMPLER_MAX_CHANNELS * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    int16_t* output = heap_caps_malloc(outputFramesCapacity * AUDIO_RESAMPLER_MAX_CHANNELS * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if ((input == NULL) || (output == NULL)) {
+        printf("Not enough memory for the resampler benchmark\n");
+        heap_caps_free(input);
+        heap_caps_free(output);
+        return 1;
+    }
+
+    // Triangle wave - The filter cost does not depend on the signal
+    for (uint32_t sampleIndex = 0; sampleIndex < RESAMPLER_BENCHMARK_FRAMES * AUDIO_RESAMPLER_MAX_CHANNELS; sampleIndex++) {
+        const int32_t ramp = (int32_t) ((sampleIndex * 512) & 0xFFFF) - 32768;
+        input[sampleIndex] = (int16_t) ((ramp < 0 ? -ramp : ramp) - 16384);
+    }
+
+    // Cycles are reported per output frame - A stereo frame is two filtered samples
+    static audio_resampler_t resampler;
+    for (size_t caseIndex = 0; caseIndex < sizeof(ResamplerBenchmarkCases) / sizeof(ResamplerBenchmarkCases[0]); caseIndex++) {
+        const resampler_benchmark_case_t* benchmarkCase = &ResamplerBenchmarkCases[caseIndex];
+        audio_resampler_init(&resampler, benchmarkCase->inputRate, benchmarkCase->outputRate, benchmarkCase->channelCount);
+
+        benchmark_result_t result = { 0 };
+        for (uint32_t iteration = 0; iteration < ResamplerBenchmarkIterations; iteration++) {
+            const uint64_t startUs = esp_timer_get_time();
+            const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+            result.samples += resample_audio(&resampler, input, RESAMPLER_BENCHMARK_FRAMES, NULL, output, outputFramesCapacity);
+            result.cycles += esp_cpu_get_cycle_count() - startCycles;
+            result.elapsedUs += esp_timer_get_time() - startUs;
+        }
+
+        char name[32];
+        snprintf(name, sizeof(name), "src %lu>%lu %s", benchmarkCase->inputRate, benchmarkCase->outputRate, benchmarkCase->channelCount == 1 ? "mono" : "stereo");
+        print_benchmark_result(name, &result, "frame");
+    }
+
+    heap_caps_free(input);
+    heap_caps_free(output);
+    return 0;
+}
+
+static int run_silence_benchmark() {
+    int16_t* samples = heap_caps_calloc(MixerBenchmarkFrames * 2, sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (samples == NULL) {
+        printf("Not enough memory for the silence benchmark\n");
+        return 1;
+    }
+
+    benchmark_result_t result = { 0 };
+    volatile uint32_t silentBlocks = 0;
+    for (uint32_t iteration = 0; iteration < SilenceBenchmarkIterations; iteration++) {
+        const uint64_t startUs = esp_timer_get_time();
+        const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+        silentBlocks += is_audio_block_silent(samples, MixerBenchmarkFrames * 2) ? 1 : 0;
+        result.cycles += esp_cpu_get_cycle_count() - startCycles;
+        result.elapsedUs += esp_timer_get_time() - startUs;
+        result.samples += MixerBenchmarkFrames;
+    }
+    print_benchmark_result("silence (stereo)", &result, "frame");
+
+    heap_caps_free(samples);
+    return silentBlocks == SilenceBenchmarkIterations ? 0 : 1;
+}
+
+static int run_analysis_benchmark() {
+    // The analysis state is shared with the I2S task - Do not race with live playback
+    if (is_i2s_output_playing()) {
+        printf("Audio is playing - Run the analysis benchmark when idle\n");
+        return 1;
+    }
+
+    int16_t* samples = heap_caps_malloc(MixerBenchmarkFrames * 2 * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (samples == NULL) {
+        printf("Not enough memory for the analysis benchmark\n");
+        return 1;
+    }
+
+    // Pseudo random noise - The analysis cost does not depend on the signal
+    uint32_t seed = 0x12345678;
+    for (uint32_t sampleIndex = 0; sampleIndex < MixerBenchmarkFrames * 2; sampleIndex++) {
+        seed = seed * 1664525 + 1013904223;
+        samples[sampleIndex] = (int16_t) (seed >> 16);
+    }
+
+    // Benchmark levels are published for a few milliseconds
+    benchmark_result_t result = { 0 };
+    for (uint32_t iteration = 0; iteration < AnalysisBenchmarkIterations; iteration++) {
+        const uint64_t startUs = esp_timer_get_time();
+        const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+        analyze_audio_block(samples, MixerBenchmarkFrames, 2, MixerBenchmarkSampleRate, (int64_t) startUs);
+        result.cycles += esp_cpu_get_cycle_count() - startCycles;
+        result.elapsedUs += esp_timer_get_time() - startUs;
+        result.samples += MixerBenchmarkFrames;
+    }
+    print_benchmark_result("analysis (stereo)", &result, "frame");
+
+    // Share of one core at the benchmark sample rate, in hundredths of a percent
+    const uint64_t cyclesPerSecond = (result.cycles * MixerBenchmarkSampleRate) / result.samples;
+    const uint64_t coreShare = (cyclesPerSecond * 10000) / (CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1000000ULL);
+    printf("%-20s %llu.%02llu%% of one %d MHz core at %lu Hz\n", "analysis (stereo)", coreShare / 100, coreShare % 100, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, MixerBenchmarkSampleRate);
+
+    reset_audio_analysis();
+    heap_caps_free(samples);
+    return 0;
+}
+
+static int run_fft_benchmark() {
+    int16_t* samples = heap_caps_malloc(FIXED_FFT_SIZE * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    fixed_fft_bin_t* bins = heap_caps_malloc(FIXED_FFT_BIN_COUNT * sizeof(fixed_fft_bin_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    float* cosines = heap_caps_malloc(FIXED_FFT_SIZE * sizeof(float), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if ((samples == NULL) || (bins == NULL) || (cosines == NULL)) {
+        printf("Not enough memory for the FFT benchmark\n");
+        heap_caps_free(samples);
+        heap_caps_free(bins);
+        heap_caps_free(cosines);
+        return 1;
+    }
+
+    fixed_fft_init();
+    for (uint32_t index = 0; index < FIXED_FFT_SIZE; index++) {
+        cosines[index] = cosf(2.0f * (float) M_PI * (float) index / FIXED_FFT_SIZE);
+    }
+
+    // Two tones, one between bins, over pseudo random noise
+    uint32_t seed = 0x12345678;
+    for (uint32_t index = 0; index < FIXED_FFT_SIZE; index++) {
+        seed = seed * 1664525 + 1013904223;
+        const float tones = 12000.0f * sinf(2.0f * (float) M_PI * 37.3f * index / FIXED_FFT_SIZE) + 6000.0f * sinf(2.0f * (float) M_PI * 101.0f * index / FIXED_FFT_SIZE);
+        samples[index] = (int16_t) (tones + (float) ((int16_t) (seed >> 16) >> 3));
+    }
+
+    benchmark_result_t result = { 0 };
+    uint32_t shift = 0;
+    for (uint32_t iteration = 0; iteration < FftBenchmarkIterations; iteration++) {
+        const uint64_t startUs = esp_timer_get_time();
+        const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+        shift = compute_fixed_real_fft(samples, bins);
+        result.cycles += esp_cpu_get_cycle_count() - startCycles;
+        result.elapsedUs += esp_timer_get_time() - startUs;
+        result.samples++;
+    }
+    print_benchmark_result("fft (512 real)", &result, "fft");
+
+    // Share of one core at the spectrum analyzer transform rate, in hundredths of a percent
+    const uint64_t cyclesPerSecond = (result.cycles * FftBenchmarkSampleRate) / (result.samples * FftBenchmarkHop);
+    const uint64_t coreShare = (cyclesPerSecond * 10000) / (CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1000000ULL);
+    printf("%-20s %llu.%02llu%% of one %d MHz core at %lu transforms/s\n", "fft (512 real)", coreShare / 100, coreShare % 100, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ, FftBenchmarkSampleRate / FftBenchmarkHop);
+
+    // Accuracy against a float DFT of the same Hann windowed block
+    float signalEnergy = 0.0f;
+    float errorEnergy = 0.0f;
+    const float binScale = 1.0f / (float) (1UL << shift);
+    for (uint32_t bin = 0; bin < FIXED_FFT_BIN_COUNT; bin++) {
+        float real = 0.0f;
+        float imaginary = 0.0f;
+        for (uint32_t index = 0; index < FIXED_FFT_SIZE; index++) {
+            const float windowed = samples[index] * (0.5f - 0.5f * cosines[index]);
+            const uint32_t phase = (bin * index) & (FIXED_FFT_SIZE - 1);
+            real += windowed * cosines[phase];
+            imaginary -= windowed * cosines[(phase + 3 * FIXED_FFT_SIZE / 4) & (FIXED_FFT_SIZE - 1)];
+        }
+        real /= FIXED_FFT_SIZE;
+        imaginary /= FIXED_FFT_SIZE;
+
+        const float realError = real - bins[bin].real * binScale;
+        const float imaginaryError = imaginary - bins[bin].imaginary * binScale;
+        signalEnergy += real * real + imaginary * imaginary;
+        errorEnergy += realError * realError + imaginaryError * imaginaryError;
+    }
+    printf("%-20s %.1f dB signal to error ratio against a float DFT\n", "fft (512 real)", 10.0f * log10f(signalEnergy / (errorEnergy > 0.0f ? errorEnergy : 1e-12f)));
+
+    heap_caps_free(samples);
+    heap_caps_free(bins);
+    heap_caps_free(cosines);
+    return 0;
+}
+
+static uint8_t* create_synthetic_adpcm_data(size_t* dataSize, uint32_t* sampleCount) {
+    // Synthetic data in RAM - Pseudo random nibbles behind valid block headers
+    const size_t syntheticSize = SyntheticAdpcmBlockSize * SyntheticAdpcmBlockCount;
+    uint8_t* syntheticData = heap_caps_malloc(syntheticSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (syntheticData == NULL) {
+        return NULL;
+    }
+
+    uint32_t seed = 0x12345678;
+    for (size_t offset = 0; offset < syntheticSize; offset++) {
+        seed = seed * 1664525 + 1013904223;
+        syntheticData[offset] = (offset % SyntheticAdpcmBlockSize) < 4 ? 0 : (uint8_t) (seed >> 24);
+    }
+    for (size_t offset = 0; offset < syntheticSize; offset += SyntheticAdpcmBlockSize) {
+        syntheticData[offset + 2] = 40;
+    }
+
+    *dataSize = syntheticSize;
+    *sampleCount = SyntheticAdpcmBlockCount * (1 + 2 * (SyntheticAdpcmBlockSize - 4));
+    return syntheticData;
+}
+
+static void benchmark_adpcm_decoder(const uint8_t* data, size_t dataSize, size_t blockSize, uint32_t sampleCount, uint32_t iterations, benchmark_result_t* result) {
+    static int16_t samples[BENCHMARK_CHUNK_SAMPLES];
+
+    for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+        adpcm_decoder_t decoder;
+        adpcm_decoder_init(&decoder, data, dataSize, blockSize, sampleCount);
+
+        const uint64_t startUs = esp_timer_get_time();
+        const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+        while (!adpcm_decoder_done(&decoder)) {
+            result->samples += adpcm_decode(&decoder, samples, BENCHMARK_CHUNK_SAMPLES);
+        }
+        result->cycles += esp_cpu_get_cycle_count() - startCycles;
+        result->elapsedUs += esp_timer_get_time() - startUs;
+    }
+}
+
+static void print_benchmark_result(const char* const name, const benchmark_result_t* const result, const char* const unit) {
+    const uint64_t samplesPerMs = result->elapsedUs > 0 ? (result->samples * 1000) / result->elapsedUs : 0;
+    const uint64_t cyclesPerSample = result->samples > 0 ? result->cycles / result->samples : 0;
+    printf("%-20s %10llu %ss in %8llu us - %6llu %ss/ms - %4llu cycles/%s\n", name, result->samples, unit, result->elapsedUs, samplesPerMs, unit, cyclesPerSample, unit);
+}
+
+#endif
@@ -0,0 +1,10 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <esp_err.h>
+
+
+esp_err_t register_audio_benchmark_console_command();
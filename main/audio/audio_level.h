@@ -0,0 +1,29 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+
+// -----------------------------------------------------------------------------------
+// Integer helpers shared by the audio analysis tap and the spectrum analyzer
+// -----------------------------------------------------------------------------------
+
+// Level of a mean square (or power) - Bit by bit square root, saturated to 16 bits
+// Mean squares of 16 bits samples and band powers of levels below full scale fit in 32 bits: larger values saturate
+static inline uint16_t audio_level_sqrt(uint64_t value) {
+    uint32_t remainder = value > UINT32_MAX ? UINT32_MAX : (uint32_t) value;
+    uint32_t root = 0;
+    for (uint32_t bit = 1UL << 30; bit != 0; bit >>= 2) {
+        if (remainder >= root + bit) {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+    }
+
+    return (uint16_t) (root > UINT16_MAX ? UINT16_MAX : root);
+}
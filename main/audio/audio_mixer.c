@@ -0,0 +1,241 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "audio/adpcm_decoder.h"
+#include "audio/audio_resampler.h"
+#include "audio/audio_mixer.h"
+
+
+// Gain applied to the A2DP stream while an effect voice plays
+static const uint32_t DuckedA2dpGain = (AudioMixerUnityGain * CONFIG_HOLIDAYTREE_AUDIO_MIXER_DUCKING_PERCENT) / 100;
+
+// Gains are capped so (INT16_MIN * gain) fits in 32 bits
+static const uint32_t MaximumGain = 2 * AudioMixerUnityGain;
+
+// Time for the A2DP gain to travel from unity to silence - Avoids clicks when ducking starts and stops
+static const uint32_t A2dpGainRampTimeMs = 10;
+
+
+// Effect voice life cycle - Only the mixer moves a voice back to 'Idle' so a voice is never reused while the mixer reads it
+typedef enum {
+    MixerVoiceIdle = 0,
+    MixerVoiceClaimed = 1,          // A task is filling in the voice parameters
+    MixerVoiceStartRequested = 2,   // Parameters are ready - The mixer starts the voice on its next block
+    MixerVoicePlaying = 3,
+    MixerVoiceStopRequested = 4     // The mixer releases the voice on its next block
+} mixer_voice_state_t;
+
+
+static void start_requested_voices(audio_mixer_t* mixer, uint32_t sampleRate);
+static bool mix_a2dp_chunk(audio_mixer_t* mixer, const int16_t* samples, uint32_t frameCount, uint8_t channelCount, uint32_t targetGain, uint32_t rampStep, uint32_t masterGain);
+static bool mix_effect_voice_chunk(audio_mixer_t* mixer, audio_mixer_voice_t* voice, uint32_t frameCount, uint8_t channelCount, uint32_t masterGain);
+
+static inline uint32_t combine_gains(uint32_t gain, uint32_t masterGain) {
+    const uint64_t combinedGain = ((uint64_t) gain * masterGain) >> 15;
+    return combinedGain > MaximumGain ? MaximumGain : (uint32_t) combinedGain;
+}
+
+
+void audio_mixer_init(audio_mixer_t* mixer) {
+    memset(mixer, 0, sizeof(*mixer));
+    mixer->a2dpGain = AudioMixerUnityGain;
+}
+
+audio_mixer_voice_id_t start_audio_mixer_voice(audio_mixer_t* mixer, const sound_bank_sound_t* const sound, uint32_t gain) {
+    if (sound == NULL) {
+        return AudioMixerNoVoice;
+    }
+
+    for (audio_mixer_voice_id_t voiceId = 0; voiceId < AUDIO_MIXER_EFFECT_VOICES; voiceId++) {
+        audio_mixer_voice_t* voice = &mixer->effectVoices[voiceId];
+        uint_fast8_t expectedState = MixerVoiceIdle;
+        if (atomic_compare_exchange_strong(&voice->state, &expectedState, MixerVoiceClaimed)) {
+            voice->sound = *sound;
+            atomic_store(&voice->gain, gain > MaximumGain ? MaximumGain : gain);
+
+            // Publish the voice - Parameters written above are visible to the mixer once it observes this state
+            atomic_store(&voice->state, MixerVoiceStartRequested);
+            return voiceId;
+        }
+    }
+
+    return AudioMixerNoVoice;
+}
+
+void stop_audio_mixer_voice(audio_mixer_t* mixer, audio_mixer_voice_id_t voiceId) {
+    if ((voiceId < 0) || (voiceId >= AUDIO_MIXER_EFFECT_VOICES)) {
+        return;
+    }
+
+    audio_mixer_voice_t* voice = &mixer->effectVoices[voiceId];
+    uint_fast8_t expectedState = MixerVoicePlaying;
+    if (!atomic_compare_exchange_strong(&voice->state, &expectedState, MixerVoiceStopRequested)) {
+        expectedState = MixerVoiceStartRequested;
+        atomic_compare_exchange_strong(&voice->state, &expectedState, MixerVoiceStopRequested);
+    }
+}
+
+void stop_all_audio_mixer_voices(audio_mixer_t* mixer) {
+    for (audio_mixer_voice_id_t voiceId = 0; voiceId < AUDIO_MIXER_EFFECT_VOICES; voiceId++) {
+        stop_audio_mixer_voice(mixer, voiceId);
+    }
+}
+
+void set_audio_mixer_voice_gain(audio_mixer_t* mixer, audio_mixer_voice_id_t voiceId, uint32_t gain) {
+    if ((voiceId >= 0) && (voiceId < AUDIO_MIXER_EFFECT_VOICES)) {
+        atomic_store(&mixer->effectVoices[voiceId].gain, gain > MaximumGain ? MaximumGain : gain);
+    }
+}
+
+bool are_audio_mixer_voices_active(audio_mixer_t* mixer) {
+    for (audio_mixer_voice_id_t voiceId = 0; voiceId < AUDIO_MIXER_EFFECT_VOICES; voiceId++) {
+        if (atomic_load(&mixer->effectVoices[voiceId].state) != MixerVoiceIdle) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void mix_audio_block(audio_mixer_t* mixer, int16_t* samples, uint32_t frameCount, uint8_t channelCount, uint32_t sampleRate, bool a2dpAudioPresent, uint32_t masterGain) {
+    if ((channelCount == 0) || (channelCount > AUDIO_MIXER_MAX_CHANNELS) || (sampleRate == 0)) {
+        return;
+    }
+
+    start_requested_voices(mixer, sampleRate);
+
+    // Duck A2DP while any effect voice is active
+    bool effectVoicesPlaying = false;
+    for (audio_mixer_voice_id_t voiceId = 0; voiceId < AUDIO_MIXER_EFFECT_VOICES; voiceId++) {
+        effectVoicesPlaying |= atomic_load(&mixer->effectVoices[voiceId].state) == MixerVoicePlaying;
+    }
+    const uint32_t a2dpTargetGain = effectVoicesPlaying ? DuckedA2dpGain : AudioMixerUnityGain;
+    const uint32_t a2dpRampStep = (AudioMixerUnityGain * 1000) / (A2dpGainRampTimeMs * sampleRate) + 1;
+
+    for (uint32_t chunkStart = 0; chunkStart < frameCount; chunkStart += AUDIO_MIXER_CHUNK_FRAMES) {
+        const uint32_t chunkFrames = frameCount - chunkStart < AUDIO_MIXER_CHUNK_FRAMES ? frameCount - chunkStart : AUDIO_MIXER_CHUNK_FRAMES;
+        int16_t* chunkSamples = samples + chunkStart * channelCount;
+        const uint32_t chunkSampleCount = chunkFrames * channelCount;
+
+        // Voice 0 - A2DP stream
+        bool chunkHasAudio = false;
+        if (a2dpAudioPresent) {
+            chunkHasAudio = mix_a2dp_chunk(mixer, chunkSamples, chunkFrames, channelCount, a2dpTargetGain, a2dpRampStep, masterGain);
+        } else {
+            memset(mixer->accumulator, 0, chunkSampleCount * sizeof(int32_t));
+        }
+
+        // Effect voices
+        for (audio_mixer_voice_id_t voiceId = 0; voiceId < AUDIO_MIXER_EFFECT_VOICES; voiceId++) {
+            audio_mixer_voice_t* voice = &mixer->effectVoices[voiceId];
+            uint_fast8_t state = atomic_load(&voice->state);
+            if (state == MixerVoicePlaying) {
+                const bool voiceContinues = mix_effect_voice_chunk(mixer, voice, chunkFrames, channelCount, masterGain);
+                chunkHasAudio = true;
+
+                if (!voiceContinues) {
+                    // Finished - A concurrent stop request leaves the voice in 'StopRequested' which is released below
+                    if (!atomic_compare_exchange_strong(&voice->state, &state, MixerVoiceIdle)) {
+                        atomic_store(&voice->state, MixerVoiceIdle);
+                    }
+                }
+            } else if (state == MixerVoiceStopRequested) {
+                atomic_store(&voice->state, MixerVoiceIdle);
+            }
+        }
+
+        // Single saturation of the accumulated chunk
+        if (chunkHasAudio) {
+            for (uint32_t sampleIndex = 0; sampleIndex < chunkSampleCount; sampleIndex++) {
+                const int32_t mixed = mixer->accumulator[sampleIndex];
+                chunkSamples[sampleIndex] = mixed > INT16_MAX ? INT16_MAX : (mixed < INT16_MIN ? INT16_MIN : (int16_t) mixed);
+            }
+        } else {
+            memset(chunkSamples, 0, chunkSampleCount * sizeof(int16_t));
+        }
+    }
+}
+
+static void start_requested_voices(audio_mixer_t* mixer, uint32_t sampleRate) {
+    for (audio_mixer_voice_id_t voiceId = 0; voiceId < AUDIO_MIXER_EFFECT_VOICES; voiceId++) {
+        audio_mixer_voice_t* voice = &mixer->effectVoices[voiceId];
+        const uint_fast8_t state = atomic_load(&voice->state);
+        if (state == MixerVoiceStartRequested) {
+            adpcm_decoder_init(&voice->decoder, voice->sound.data, voice->sound.dataSize, voice->sound.blockSize, voice->sound.sampleCount);
+            audio_resampler_init(&voice->resampler, voice->sound.sampleRate, sampleRate, 1);
+            voice->decodedCount = 0;
+            voice->decodedIndex = 0;
+
+            // A stop request may have raced with the start - The voice is then released on this block
+            uint_fast8_t expectedState = MixerVoiceStartRequested;
+            atomic_compare_exchange_strong(&voice->state, &expectedState, MixerVoicePlaying);
+        } else if ((state == MixerVoicePlaying) && (voice->resampler.outputRate != sampleRate)) {
+            // The output rate changed while the voice plays
+            audio_resampler_init(&voice->resampler, voice->sound.sampleRate, sampleRate, 1);
+        }
+    }
+}
+
+static bool mix_a2dp_chunk(audio_mixer_t* mixer, const int16_t* samples, uint32_t frameCount, uint8_t channelCount, uint32_t targetGain, uint32_t rampStep, uint32_t masterGain) {
+    const uint32_t sampleCount = frameCount * channelCount;
+
+    if (mixer->a2dpGain == targetGain) {
+        // Steady gain - One multiply per sample
+        const int32_t gain = (int32_t) combine_gains(mixer->a2dpGain, masterGain);
+        for (uint32_t sampleIndex = 0; sampleIndex < sampleCount; sampleIndex++) {
+            mixer->accumulator[sampleIndex] = (samples[sampleIndex] * gain) >> 15;
+        }
+    } else {
+        // Ramping towards the target gain - The gain is updated once per frame
+        for (uint32_t frameIndex = 0; frameIndex < frameCount; frameIndex++) {
+            if (mixer->a2dpGain < targetGain) {
+                mixer->a2dpGain = targetGain - mixer->a2dpGain > rampStep ? mixer->a2dpGain + rampStep : targetGain;
+            } else if (mixer->a2dpGain > targetGain) {
+                mixer->a2dpGain = mixer->a2dpGain - targetGain > rampStep ? mixer->a2dpGain - rampStep : targetGain;
+            }
+
+            const int32_t gain = (int32_t) combine_gains(mixer->a2dpGain, masterGain);
+            for (uint8_t channel = 0; channel < channelCount; channel++) {
+                const uint32_t sampleIndex = frameIndex * channelCount + channel;
+                mixer->accumulator[sampleIndex] = (samples[sampleIndex] * gain) >> 15;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool mix_effect_voice_chunk(audio_mixer_t* mixer, audio_mixer_voice_t* voice, uint32_t frameCount, uint8_t channelCount, uint32_t masterGain) {
+    // Decode and convert to the output rate until the chunk is full or the sound ends
+    uint32_t framesRendered = 0;
+    while (framesRendered < frameCount) {
+        if (voice->decodedIndex == voice->decodedCount) {
+            voice->decodedCount = adpcm_decode(&voice->decoder, voice->decoded, AUDIO_MIXER_DECODE_SAMPLES);
+            voice->decodedIndex = 0;
+            if (voice->decodedCount == 0) {
+                break;
+            }
+        }
+
+        uint32_t samplesConsumed = 0;
+        framesRendered += resample_audio(&voice->resampler, &voice->decoded[voice->decodedIndex], voice->decodedCount - voice->decodedIndex, &samplesConsumed, &mixer->effectVoiceSamples[framesRendered], frameCount - framesRendered);
+        voice->decodedIndex += samplesConsumed;
+    }
+
+    // Mono effect voices contribute to every output channel
+    const int32_t gain = (int32_t) combine_gains(atomic_load(&voice->gain), masterGain);
+    for (uint32_t frameIndex = 0; frameIndex < framesRendered; frameIndex++) {
+        const int32_t contribution = (mixer->effectVoiceSamples[frameIndex] * gain) >> 15;
+
+        int32_t* frame = &mixer->accumulator[frameIndex * channelCount];
+        for (uint8_t channel = 0; channel < channelCount; channel++) {
+            frame[channel] += contribution;
+        }
+    }
+
+    return framesRendered == frameCount;
+}
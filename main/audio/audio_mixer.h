@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <esp_err.h>
+
+#include "sdkconfig.h"
+
+#include "audio/adpcm_decoder.h"
+#include "audio/audio_resampler.h"
+#include "audio/sound_bank.h"
+
+
+// -----------------------------------------------------------------------------------
+// Fixed point mixer - Mixes the A2DP stream with local sound effect voices
+//
+//  * Gains are Q15 (AudioMixerUnityGain = 1.0)
+//  * Each voice contributes (sample * gain) >> 15 to a 32 bits accumulator, the sum is saturated to 16 bits once
+//  * The A2DP stream is ducked while any effect voice plays
+//  * Effect voices are converted to the output rate by the polyphase resampler - See audio_resampler.h
+//  * Effect voices are started and stopped lock free from any task - mix_audio_block() runs on a single task
+//  * A mixer is a plain struct: the I2S output owns the one which plays, benchmarks measure their own
+//
+// CPU cost per voice and per output frame is reported by 'audio_bench mixer' (CONFIG_HOLIDAYTREE_AUDIO_BENCHMARK).
+// Each effect voice adds an ADPCM decode, a 16 taps resampling filter and one multiply-accumulate per channel to every
+// output frame: about 25ns per frame on a desktop computer, 8 times the cost of the A2DP stream alone (tools/host)
+// -----------------------------------------------------------------------------------
+
+#define AudioMixerUnityGain 32768
+
+// Number of local sound effect voices
+#define AUDIO_MIXER_EFFECT_VOICES CONFIG_HOLIDAYTREE_AUDIO_MIXER_VOICES
+
+// Frames mixed at once - Bounds the size of the 32 bits accumulator
+#define AUDIO_MIXER_CHUNK_FRAMES 128
+
+// Maximum number of interleaved channels
+#define AUDIO_MIXER_MAX_CHANNELS 2
+
+// Samples decoded at once per effect voice
+#define AUDIO_MIXER_DECODE_SAMPLES 64
+
+// Effect voice identifier returned by start_audio_mixer_voice()
+typedef int32_t audio_mixer_voice_id_t;
+#define AudioMixerNoVoice ((audio_mixer_voice_id_t) -1)
+
+
+typedef struct {
+    // Shared with the tasks starting and stopping voices
+    volatile atomic_uint_fast8_t state;
+    volatile atomic_uint_fast32_t gain;
+    sound_bank_sound_t sound;
+
+    // Owned by the mixer
+    adpcm_decoder_t decoder;
+    int16_t decoded[AUDIO_MIXER_DECODE_SAMPLES];
+    uint32_t decodedCount;
+    uint32_t decodedIndex;
+
+    // Effect voices are converted to the output rate
+    audio_resampler_t resampler;
+} audio_mixer_voice_t;
+
+typedef struct {
+    audio_mixer_voice_t effectVoices[AUDIO_MIXER_EFFECT_VOICES];
+
+    // Current A2DP gain - Ramps towards unity or the ducked gain
+    uint32_t a2dpGain;
+
+    // Mixing accumulator - One chunk of interleaved frames
+    int32_t accumulator[AUDIO_MIXER_CHUNK_FRAMES * AUDIO_MIXER_MAX_CHANNELS];
+
+    // One chunk of one effect voice at the output rate
+    int16_t effectVoiceSamples[AUDIO_MIXER_CHUNK_FRAMES];
+} audio_mixer_t;
+
+// Static initializer - Same state as audio_mixer_init(): every voice idle, A2DP at unity gain
+#define AUDIO_MIXER_INITIALIZER { .a2dpGain = AudioMixerUnityGain }
+
+
+void audio_mixer_init(audio_mixer_t* mixer);
+
+audio_mixer_voice_id_t start_audio_mixer_voice(audio_mixer_t* mixer, const sound_bank_sound_t* const sound, uint32_t gain);
+void stop_audio_mixer_voice(audio_mixer_t* mixer, audio_mixer_voice_id_t voiceId);
+void stop_all_audio_mixer_voices(audio_mixer_t* mixer);
+void set_audio_mixer_voice_gain(audio_mixer_t* mixer, audio_mixer_voice_id_t voiceId, uint32_t gain);
+
+bool are_audio_mixer_voices_active(audio_mixer_t* mixer);
+
+void mix_audio_block(audio_mixer_t* mixer, int16_t* samples, uint32_t frameCount, uint8_t channelCount, uint32_t sampleRate, bool a2dpAudioPresent, uint32_t masterGain);
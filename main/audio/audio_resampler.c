@@ -0,0 +1,154 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <string.h>
+#include <math.h>
+
+#include "audio/audio_resampler.h"
+
+
+// Number of filter phases - Must be a power of two
+#define AUDIO_RESAMPLER_PHASE_BITS 7
+#define AUDIO_RESAMPLER_PHASES (1 << AUDIO_RESAMPLER_PHASE_BITS)
+
+// One input sample in Q16
+#define AUDIO_RESAMPLER_ONE (1 << 16)
+
+
+// Low pass cut off relative to the input rate and Kaiser window shape
+static const float CutOff = 0.45f;
+static const float KaiserBeta = 7.0f;
+
+
+// Coefficients for fractional positions 0, 1/128 ... 128/128 - The extra phase avoids wrapping when rounding to the nearest phase
+// Written once by audio_resampler_coefficients_init() before any task resamples, read only afterwards
+static int16_t s_coefficients[AUDIO_RESAMPLER_PHASES + 1][AUDIO_RESAMPLER_TAPS];
+
+
+static float bessel_i0(float x);
+
+static inline int16_t filter_window(const int16_t* window, const int16_t* coefficients) {
+    int32_t accumulator = 1 << 14;
+    for (uint32_t tap = 0; tap < AUDIO_RESAMPLER_TAPS; tap++) {
+        accumulator += window[tap] * coefficients[tap];
+    }
+
+    // Coefficients of one phase sum to 1.0 and their absolute values to less than 2.0 - The accumulator cannot overflow
+    accumulator >>= 15;
+    return accumulator > INT16_MAX ? INT16_MAX : (accumulator < INT16_MIN ? INT16_MIN : (int16_t) accumulator);
+}
+
+
+void audio_resampler_init(audio_resampler_t* resampler, uint32_t inputRate, uint32_t outputRate, uint8_t channelCount) {
+    memset(resampler, 0, sizeof(audio_resampler_t));
+    resampler->inputRate = inputRate;
+    resampler->outputRate = outputRate;
+    resampler->channelCount = channelCount > AUDIO_RESAMPLER_MAX_CHANNELS ? AUDIO_RESAMPLER_MAX_CHANNELS : channelCount;
+    if (outputRate > 0) {
+        resampler->step = (uint32_t) (((uint64_t) inputRate << 16) / outputRate);
+        resampler->stepRemainder = (uint32_t) (((uint64_t) inputRate << 16) % outputRate);
+    } else {
+        resampler->step = AUDIO_RESAMPLER_ONE;
+    }
+
+    // The first output sample needs one input sample
+    resampler->position = AUDIO_RESAMPLER_ONE;
+}
+
+uint32_t resample_audio(audio_resampler_t* resampler, const int16_t* input, uint32_t inputFrames, uint32_t* inputFramesConsumed, int16_t* output, uint32_t maxOutputFrames) {
+    const uint8_t channelCount = resampler->channelCount;
+    uint32_t position = resampler->position;
+    uint32_t remainder = resampler->remainder;
+    uint32_t historyIndex = resampler->historyIndex;
+
+    uint32_t framesProduced = 0;
+    uint32_t framesConsumed = 0;
+    for (;;) {
+        // Produce every output sample located before the next input sample
+        while ((position < AUDIO_RESAMPLER_ONE) && (framesProduced < maxOutputFrames)) {
+            const uint32_t phase = (position + (1 << (15 - AUDIO_RESAMPLER_PHASE_BITS))) >> (16 - AUDIO_RESAMPLER_PHASE_BITS);
+            const int16_t* coefficients = s_coefficients[phase];
+            for (uint8_t channel = 0; channel < channelCount; channel++) {
+                output[framesProduced * channelCount + channel] = filter_window(&resampler->history[channel][historyIndex], coefficients);
+            }
+
+            position += resampler->step;
+            remainder += resampler->stepRemainder;
+            if (remainder >= resampler->outputRate) {
+                remainder -= resampler->outputRate;
+                position++;
+            }
+            framesProduced++;
+        }
+
+        if ((framesProduced == maxOutputFrames) || (framesConsumed == inputFrames)) {
+            break;
+        }
+
+        // Move one input sample forward
+        for (uint8_t channel = 0; channel < channelCount; channel++) {
+            const int16_t sample = input[framesConsumed * channelCount + channel];
+            resampler->history[channel][historyIndex] = sample;
+            resampler->history[channel][historyIndex + AUDIO_RESAMPLER_TAPS] = sample;
+        }
+        historyIndex = (historyIndex + 1) % AUDIO_RESAMPLER_TAPS;
+        position -= AUDIO_RESAMPLER_ONE;
+        framesConsumed++;
+    }
+
+    resampler->position = position;
+    resampler->remainder = remainder;
+    resampler->historyIndex = historyIndex;
+
+    if (inputFramesConsumed != NULL) {
+        *inputFramesConsumed = framesConsumed;
+    }
+    return framesProduced;
+}
+
+void audio_resampler_coefficients_init() {
+    // Output samples sit between history samples (AUDIO_RESAMPLER_TAPS / 2 - 1) and (AUDIO_RESAMPLER_TAPS / 2)
+    const float halfTaps = AUDIO_RESAMPLER_TAPS / 2;
+    const float windowNormalization = bessel_i0(KaiserBeta);
+
+    for (uint32_t phase = 0; phase <= AUDIO_RESAMPLER_PHASES; phase++) {
+        const float fraction = (float) phase / AUDIO_RESAMPLER_PHASES;
+
+        float taps[AUDIO_RESAMPLER_TAPS];
+        float sum = 0.0f;
+        for (uint32_t tap = 0; tap < AUDIO_RESAMPLER_TAPS; tap++) {
+            const float distance = (float) tap - (halfTaps - 1.0f) - fraction;
+            const float x = 2.0f * CutOff * distance;
+            const float sinc = fabsf(x) < 1e-6f ? 1.0f : sinf((float) M_PI * x) / ((float) M_PI * x);
+
+            const float windowPosition = distance / halfTaps;
+            const float window = fabsf(windowPosition) >= 1.0f ? 0.0f : bessel_i0(KaiserBeta * sqrtf(1.0f - windowPosition * windowPosition)) / windowNormalization;
+
+            taps[tap] = sinc * window;
+            sum += taps[tap];
+        }
+
+        // Unity gain at DC - Rounding residue goes to the largest tap
+        int32_t quantizedSum = 0;
+        uint32_t largestTap = 0;
+        for (uint32_t tap = 0; tap < AUDIO_RESAMPLER_TAPS; tap++) {
+            s_coefficients[phase][tap] = (int16_t) lroundf(32768.0f * taps[tap] / sum);
+            quantizedSum += s_coefficients[phase][tap];
+            largestTap = s_coefficients[phase][tap] > s_coefficients[phase][largestTap] ? tap : largestTap;
+        }
+        s_coefficients[phase][largestTap] += 32768 - quantizedSum;
+    }
+}
+
+static float bessel_i0(float x) {
+    // Power series - Converges quickly for the small arguments of a Kaiser window
+    float sum = 1.0f;
+    float term = 1.0f;
+    for (uint32_t k = 1; k < 32; k++) {
+        term *= (x / (2.0f * k)) * (x / (2.0f * k));
+        sum += term;
+    }
+
+    return sum;
+}
@@ -0,0 +1,49 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+
+// -----------------------------------------------------------------------------------
+// Polyphase fixed point sample rate converter
+//
+//  * 16 taps windowed sinc (Kaiser) in 128 phases - Q15 coefficients shared by every converter, computed once at start
+//    up by audio_resampler_coefficients_init() before any converter runs
+//  * The cut off is 0.45 of the input rate: suited to up sampling and to mild down sampling (output / input >= 0.9).
+//    Stronger down sampling aliases - The fixed I2S output rate is therefore at least 44.1kHz
+//  * Positions are tracked in Q16 input samples - The nearest of the 128 phases is used for each output sample
+//  * Each output sample costs 16 multiply-accumulates per channel - See 'audio_bench src'
+//  * Distortion and noise (THD+N) of a converted sine are checked on the host by tools/host/resampler_thdn.c
+// -----------------------------------------------------------------------------------
+
+#define AUDIO_RESAMPLER_TAPS 16
+#define AUDIO_RESAMPLER_MAX_CHANNELS 2
+
+
+typedef struct {
+    uint32_t inputRate;
+    uint32_t outputRate;
+    uint8_t channelCount;
+
+    uint32_t step;              // Input samples per output sample - Q16, rounded down
+    uint32_t stepRemainder;     // Remainder of the Q16 step in 1 / outputRate units - Keeps the long term rate exact
+    uint32_t remainder;
+    uint32_t position;          // Position of the next output sample relative to the newest history sample - Q16
+
+    // History is stored twice so the filter always reads AUDIO_RESAMPLER_TAPS contiguous samples
+    uint32_t historyIndex;
+    int16_t history[AUDIO_RESAMPLER_MAX_CHANNELS][2 * AUDIO_RESAMPLER_TAPS];
+} audio_resampler_t;
+
+
+// Start up, before any task resamples
+void audio_resampler_coefficients_init();
+
+void audio_resampler_init(audio_resampler_t* resampler, uint32_t inputRate, uint32_t outputRate, uint8_t channelCount);
+
+// Resamples interleaved frames until either the input is consumed or the output is full
+// Returns the number of output frames produced and the number of input frames consumed in 'inputFramesConsumed'
+uint32_t resample_audio(audio_resampler_t* resampler, const int16_t* input, uint32_t inputFrames, uint32_t* inputFramesConsumed, int16_t* output, uint32_t maxOutputFrames);
@@ -0,0 +1,31 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+// -----------------------------------------------------------------------------------
+// Digital silence detection - OR reduction of a block of 16 bits samples, two samples per 32 bits word
+// Cost per frame is reported by 'audio_bench silence' (CONFIG_HOLIDAYTREE_AUDIO_BENCHMARK)
+// -----------------------------------------------------------------------------------
+
+static inline bool is_audio_block_silent(const int16_t* samples, size_t sampleCount) {
+    // Audio buffers are 32 bits aligned - Reduce two samples at a time then fold in the odd sample, if any
+    const uint32_t* words = (const uint32_t*) samples;
+    const size_t wordCount = sampleCount / 2;
+
+    uint32_t bits = 0;
+    for (size_t wordIndex = 0; wordIndex < wordCount; wordIndex++) {
+        bits |= words[wordIndex];
+    }
+    if (sampleCount & 1) {
+        bits |= (uint16_t) samples[sampleCount - 1];
+    }
+
+    return bits == 0;
+}
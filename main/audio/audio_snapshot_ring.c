@@ -0,0 +1,61 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "audio/audio_snapshot_ring.h"
+
+
+// Attempts to copy a consistent snapshot before giving up
+static const uint32_t SnapshotReadAttempts = 4;
+
+
+static inline uint8_t* get_slot(audio_snapshot_ring_t* ring, uint32_t sequence) {
+    return &ring->slots[(sequence & (AUDIO_SNAPSHOT_RING_SLOTS - 1)) * ring->slotSize];
+}
+
+
+void* begin_audio_snapshot(audio_snapshot_ring_t* ring, uint32_t* sequence) {
+    // Slot writes must not be seen before the previous sequence is published
+    atomic_thread_fence(memory_order_release);
+
+    *sequence = ++ring->sequence;
+    return get_slot(ring, ring->sequence);
+}
+
+void publish_audio_snapshot(audio_snapshot_ring_t* ring, int64_t playoutTimeUs) {
+    ring->playoutTimesUs[ring->sequence & (AUDIO_SNAPSHOT_RING_SLOTS - 1)] = playoutTimeUs;
+    atomic_store_explicit(&ring->publishedSequence, ring->sequence, memory_order_release);
+}
+
+bool read_latest_audio_snapshot(audio_snapshot_ring_t* ring, void* snapshot) {
+    return read_audio_snapshot_at(ring, INT64_MAX, snapshot);
+}
+
+bool read_audio_snapshot_at(audio_snapshot_ring_t* ring, int64_t timeUs, void* snapshot) {
+    for (uint32_t attempt = 0; attempt < SnapshotReadAttempts; attempt++) {
+        const uint32_t published = atomic_load_explicit(&ring->publishedSequence, memory_order_acquire);
+        if (published == 0) {
+            memset(snapshot, 0, ring->slotSize);
+            return true;
+        }
+
+        // The slot after the published one may be being written - Walk back from the newest snapshot until one is due
+        const uint32_t oldest = published > AUDIO_SNAPSHOT_RING_SLOTS - 2 ? published - (AUDIO_SNAPSHOT_RING_SLOTS - 2) : 1;
+        uint32_t sequence = published;
+        while ((sequence > oldest) && (ring->playoutTimesUs[sequence & (AUDIO_SNAPSHOT_RING_SLOTS - 1)] > timeUs)) {
+            sequence--;
+        }
+
+        memcpy(snapshot, get_slot(ring, sequence), ring->slotSize);
+
+        // A slot is recycled when the writer starts the sequence AUDIO_SNAPSHOT_RING_SLOTS after it
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&ring->publishedSequence, memory_order_relaxed) - sequence < AUDIO_SNAPSHOT_RING_SLOTS - 1) {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,46 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+// -----------------------------------------------------------------------------------
+// Lock free ring of analysis snapshots ordered by playout time - One writer task, any number of reader tasks
+//
+//  * The writer fills the slot of the next sequence number then publishes it - Writers never wait for readers
+//  * Each snapshot carries the time its audio reaches the DAC so readers can pick what is being heard rather than
+//    what was just analyzed - Audio is analyzed tens of milliseconds before it is played
+//  * Readers copy a slot then check it was not recycled while copying
+// -----------------------------------------------------------------------------------
+
+// Snapshots kept - Must be a power of two and cover the analysis to playout latency
+#define AUDIO_SNAPSHOT_RING_SLOTS 8
+
+
+typedef struct {
+    uint8_t* slots;
+    size_t slotSize;
+    uint32_t sequence;                                      // Writer side - Sequence of the slot being filled
+    int64_t playoutTimesUs[AUDIO_SNAPSHOT_RING_SLOTS];
+    volatile atomic_uint_fast32_t publishedSequence;        // 0 until the first snapshot
+} audio_snapshot_ring_t;
+
+#define AUDIO_SNAPSHOT_RING_INITIALIZER(slotArray) { .slots = (uint8_t*) (slotArray), .slotSize = sizeof((slotArray)[0]), .sequence = 0, .publishedSequence = 0 }
+
+
+// Writer - Fill the returned slot then publish it
+void* begin_audio_snapshot(audio_snapshot_ring_t* ring, uint32_t* sequence);
+void publish_audio_snapshot(audio_snapshot_ring_t* ring, int64_t playoutTimeUs);
+
+// Readers - Snapshots are zeroed until the first one is published
+// Return false if a consistent snapshot could not be copied, which only happens under heavy preemption
+bool read_latest_audio_snapshot(audio_snapshot_ring_t* ring, void* snapshot);
+
+// Newest snapshot played at or before 'timeUs' - The oldest snapshot kept when none is due yet
+bool read_audio_snapshot_at(audio_snapshot_ring_t* ring, int64_t timeUs, void* snapshot);
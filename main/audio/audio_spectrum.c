@@ -0,0 +1,283 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdatomic.h>
+#include <string.h>
+#include <math.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+#include "sdkconfig.h"
+
+#include "audio/fixed_fft.h"
+#include "audio/audio_snapshot_ring.h"
+#include "audio/audio_level.h"
+#include "audio/audio_spectrum.h"
+
+#if CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION
+#include "audio/audio_beat.h"
+#endif
+
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+
+// Audio spectrum log tag
+static const char* AudioSpectrumTag = "audio_spectrum";
+
+
+// Decimated samples per transform - Half the FFT size for 50% overlap
+#define AUDIO_SPECTRUM_HOP (FIXED_FFT_SIZE / 2)
+
+// Blocks in flight between the I2S task and the analyzer task - Must be a power of two
+#define AUDIO_SPECTRUM_QUEUE_BLOCKS 4
+
+// Bands are log spaced from LowestBandHz to HighestBandFraction of the decimated sample rate
+static const float LowestBandHz = 40.0f;
+static const float HighestBandFraction = 0.45f;
+
+// Level smoothing time constants
+static const float AttackMs = 10.0f;
+static const float DecayMs = 300.0f;
+
+// Analyzer task stack size and priority - Below the Bluetooth dispatcher sharing its core
+static const uint32_t AnalyzerTaskStackSize = 3072;
+static const UBaseType_t AnalyzerTaskPriority = 5;
+
+// Analyzer task notification slot - Counts blocks queued and reset requests
+static const UBaseType_t AnalyzerTaskNotificationIndex = 0;
+
+
+// Single producer (I2S task) single consumer (analyzer task) queue - Head and tail are free running block counters
+typedef struct {
+    uint32_t sampleRate;
+    int64_t playoutTimeUs;      // Playout time of the last sample
+    int16_t samples[AUDIO_SPECTRUM_HOP];
+} audio_spectrum_block_t;
+
+static audio_spectrum_block_t s_queue[AUDIO_SPECTRUM_QUEUE_BLOCKS];
+static volatile atomic_uint_fast32_t s_atomic_queue_head = 0;
+static volatile atomic_uint_fast32_t s_atomic_queue_tail = 0;
+static volatile atomic_bool s_atomic_reset_requested = false;
+
+// Samples already written to the block at the head of the queue - Only accessed by the I2S task
+static uint32_t s_queue_fill = 0;
+
+static TaskHandle_t s_analyzer_task_handle = NULL;
+
+
+// Analyzer state - Only accessed by the analyzer task
+typedef struct {
+    uint32_t sampleRate;
+    uint32_t framePeriodUs;
+
+    // Band b covers bins bandFirstBins[b] to bandFirstBins[b + 1] - 1
+    uint16_t bandFirstBins[AUDIO_SPECTRUM_BAND_COUNT + 1];
+
+    // Smoothing coefficients per transform - Q15
+    int32_t attackCoefficient;
+    int32_t decayCoefficient;
+
+    // Smoothed levels - Q8 sample units
+    int32_t levels[AUDIO_SPECTRUM_BAND_COUNT];
+
+    int16_t window[FIXED_FFT_SIZE];
+    fixed_fft_bin_t bins[FIXED_FFT_BIN_COUNT];
+} audio_spectrum_state_t;
+
+static audio_spectrum_state_t s_spectrum;
+
+
+// Snapshots ordered by playout time
+static audio_spectrum_snapshot_t s_snapshots[AUDIO_SNAPSHOT_RING_SLOTS];
+static audio_snapshot_ring_t s_snapshot_ring = AUDIO_SNAPSHOT_RING_INITIALIZER(s_snapshots);
+
+
+static void analyzer_task(void* pvParameters);
+static void configure_spectrum(uint32_t sampleRate);
+static void analyze_spectrum_block(const audio_spectrum_block_t* block);
+static void clear_spectrum();
+static void publish_snapshot(int64_t timestampUs, int64_t playoutTimeUs);
+
+
+esp_err_t start_audio_spectrum_analyzer() {
+    if (s_analyzer_task_handle != NULL) {
+        return ESP_OK;
+    }
+
+    fixed_fft_init();
+
+    // Run next to Bluedroid - The I2S task has the other core to itself
+    BaseType_t taskCreated = xTaskCreatePinnedToCore(analyzer_task, "ht-spectrum", AnalyzerTaskStackSize, NULL, AnalyzerTaskPriority, &s_analyzer_task_handle, CONFIG_BT_BLUEDROID_PINNED_TO_CORE);
+    ESP_RETURN_ON_FALSE(taskCreated == pdPASS, ESP_FAIL, AudioSpectrumTag, "xTaskCreatePinnedToCore() failed");
+
+    return ESP_OK;
+}
+
+void submit_audio_spectrum_samples(const int16_t* samples, uint32_t sampleCount, uint32_t sampleRate, int64_t playoutTimeUs) {
+    uint32_t submittedCount = 0;
+    while (sampleCount > 0) {
+        // A partially written block means the queue had room - Only check again when starting a new block
+        const uint32_t head = atomic_load_explicit(&s_atomic_queue_head, memory_order_relaxed);
+        if (s_queue_fill == 0) {
+            const uint32_t tail = atomic_load_explicit(&s_atomic_queue_tail, memory_order_acquire);
+            if (head - tail >= AUDIO_SPECTRUM_QUEUE_BLOCKS) {
+                // The analyzer is behind - Drop samples, the I2S task never waits
+                return;
+            }
+        }
+
+        // Blocks carry a single sample rate
+        audio_spectrum_block_t* block = &s_queue[head & (AUDIO_SPECTRUM_QUEUE_BLOCKS - 1)];
+        if ((s_queue_fill == 0) || (block->sampleRate != sampleRate)) {
+            block->sampleRate = sampleRate;
+            s_queue_fill = 0;
+        }
+
+        const uint32_t copyCount = sampleCount < AUDIO_SPECTRUM_HOP - s_queue_fill ? sampleCount : AUDIO_SPECTRUM_HOP - s_queue_fill;
+        memcpy(&block->samples[s_queue_fill], samples, copyCount * sizeof(int16_t));
+        s_queue_fill += copyCount;
+        samples += copyCount;
+        sampleCount -= copyCount;
+        submittedCount += copyCount;
+
+        if (s_queue_fill == AUDIO_SPECTRUM_HOP) {
+            block->playoutTimeUs = playoutTimeUs + ((int64_t) (submittedCount - 1) * 1000000) / sampleRate;
+            s_queue_fill = 0;
+            atomic_store_explicit(&s_atomic_queue_head, head + 1, memory_order_release);
+            if (s_analyzer_task_handle != NULL) {
+                xTaskNotifyGiveIndexed(s_analyzer_task_handle, AnalyzerTaskNotificationIndex);
+            }
+        }
+    }
+}
+
+void reset_audio_spectrum() {
+    // Queued blocks are discarded by the analyzer task which then publishes silence
+    s_queue_fill = 0;
+    atomic_store_explicit(&s_atomic_reset_requested, true, memory_order_release);
+    if (s_analyzer_task_handle != NULL) {
+        xTaskNotifyGiveIndexed(s_analyzer_task_handle, AnalyzerTaskNotificationIndex);
+    }
+}
+
+bool get_audio_spectrum_snapshot(audio_spectrum_snapshot_t* snapshot) {
+    return read_latest_audio_snapshot(&s_snapshot_ring, snapshot);
+}
+
+bool get_audio_spectrum_snapshot_at(int64_t timeUs, audio_spectrum_snapshot_t* snapshot) {
+    return read_audio_snapshot_at(&s_snapshot_ring, timeUs, snapshot);
+}
+
+static void analyzer_task(void* pvParameters) {
+    for (;;) {
+        ulTaskNotifyTakeIndexed(AnalyzerTaskNotificationIndex, pdTRUE, portMAX_DELAY);
+
+        uint32_t tail = atomic_load_explicit(&s_atomic_queue_tail, memory_order_relaxed);
+        if (atomic_exchange_explicit(&s_atomic_reset_requested, false, memory_order_acquire)) {
+            tail = atomic_load_explicit(&s_atomic_queue_head, memory_order_acquire);
+            atomic_store_explicit(&s_atomic_queue_tail, tail, memory_order_release);
+            clear_spectrum();
+            const int64_t nowUs = esp_timer_get_time();
+            publish_snapshot(nowUs, nowUs);
+#if CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION
+            reset_audio_beat_detector();
+#endif
+        }
+
+        // Release each block as soon as it is analyzed so the I2S task can refill it
+        while (tail != atomic_load_explicit(&s_atomic_queue_head, memory_order_acquire)) {
+            analyze_spectrum_block(&s_queue[tail & (AUDIO_SPECTRUM_QUEUE_BLOCKS - 1)]);
+            atomic_store_explicit(&s_atomic_queue_tail, ++tail, memory_order_release);
+        }
+    }
+}
+
+static void configure_spectrum(uint32_t sampleRate) {
+    s_spectrum.sampleRate = sampleRate;
+    s_spectrum.framePeriodUs = (uint32_t) ((AUDIO_SPECTRUM_HOP * 1000000ULL) / sampleRate);
+
+    // Log spaced band edges - Every band gets at least one bin, bins 0 and 1 mostly carry DC leaking through the window
+    const float binHz = (float) sampleRate / FIXED_FFT_SIZE;
+    const float highestBandHz = HighestBandFraction * sampleRate;
+    for (uint32_t band = 0; band <= AUDIO_SPECTRUM_BAND_COUNT; band++) {
+        const float edgeHz = LowestBandHz * powf(highestBandHz / LowestBandHz, (float) band / AUDIO_SPECTRUM_BAND_COUNT);
+        int32_t bin = (int32_t) lroundf(edgeHz / binHz);
+        bin = bin < 2 ? 2 : bin;
+        if ((band > 0) && (bin <= s_spectrum.bandFirstBins[band - 1])) {
+            bin = s_spectrum.bandFirstBins[band - 1] + 1;
+        }
+        const int32_t lastUsableBin = FIXED_FFT_BIN_COUNT - (int32_t) (AUDIO_SPECTRUM_BAND_COUNT - band);
+        s_spectrum.bandFirstBins[band] = (uint16_t) (bin > lastUsableBin ? lastUsableBin : bin);
+    }
+
+    // One pole smoothing per transform: coefficient = 1 - e^(-hop duration / time constant)
+    const float hopMs = 1000.0f * AUDIO_SPECTRUM_HOP / sampleRate;
+    s_spectrum.attackCoefficient = (int32_t) lroundf((1.0f - expf(-hopMs / AttackMs)) * 32767.0f);
+    s_spectrum.decayCoefficient = (int32_t) lroundf((1.0f - expf(-hopMs / DecayMs)) * 32767.0f);
+
+    clear_spectrum();
+}
+
+static void analyze_spectrum_block(const audio_spectrum_block_t* block) {
+    if (block->sampleRate != s_spectrum.sampleRate) {
+        configure_spectrum(block->sampleRate);
+    }
+
+    // Slide the window by one hop
+    memmove(s_spectrum.window, &s_spectrum.window[AUDIO_SPECTRUM_HOP], (FIXED_FFT_SIZE - AUDIO_SPECTRUM_HOP) * sizeof(int16_t));
+    memcpy(&s_spectrum.window[FIXED_FFT_SIZE - AUDIO_SPECTRUM_HOP], block->samples, AUDIO_SPECTRUM_HOP * sizeof(int16_t));
+
+    const int64_t timestampUs = esp_timer_get_time();
+    const uint32_t shift = compute_fixed_real_fft(s_spectrum.window, s_spectrum.bins);
+
+    uint16_t bandLevels[AUDIO_SPECTRUM_BAND_COUNT];
+    for (uint32_t band = 0; band < AUDIO_SPECTRUM_BAND_COUNT; band++) {
+        uint64_t power = 0;
+        for (uint32_t bin = s_spectrum.bandFirstBins[band]; bin < s_spectrum.bandFirstBins[band + 1]; bin++) {
+            const int64_t real = s_spectrum.bins[bin].real;
+            const int64_t imaginary = s_spectrum.bins[bin].imaginary;
+            power += (uint64_t) (real * real + imaginary * imaginary);
+        }
+
+        // One sided spectrum of a Hann windowed block: RMS^2 = 16 / 3 * sum of |X / N|^2
+        bandLevels[band] = audio_level_sqrt(((power * 16) / 3) >> (2 * shift));
+        const int32_t target = (int32_t) bandLevels[band] << 8;
+        int32_t* level = &s_spectrum.levels[band];
+        const int32_t coefficient = target > *level ? s_spectrum.attackCoefficient : s_spectrum.decayCoefficient;
+        *level += (int32_t) (((int64_t) coefficient * (target - *level)) >> 15);
+    }
+
+    publish_snapshot(timestampUs, block->playoutTimeUs);
+
+#if CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION
+    // Onsets need the unsmoothed levels
+    detect_audio_beat(bandLevels, AUDIO_SPECTRUM_BAND_COUNT, s_spectrum.framePeriodUs, block->playoutTimeUs);
+#endif
+}
+
+static void clear_spectrum() {
+    memset(s_spectrum.window, 0, sizeof(s_spectrum.window));
+    memset(s_spectrum.levels, 0, sizeof(s_spectrum.levels));
+}
+
+static void publish_snapshot(int64_t timestampUs, int64_t playoutTimeUs) {
+    uint32_t sequence = 0;
+    audio_spectrum_snapshot_t* snapshot = begin_audio_snapshot(&s_snapshot_ring, &sequence);
+
+    snapshot->sequence = sequence;
+    snapshot->timestampUs = timestampUs;
+    snapshot->playoutTimeUs = playoutTimeUs;
+    for (uint32_t band = 0; band < AUDIO_SPECTRUM_BAND_COUNT; band++) {
+        snapshot->bands[band] = (uint16_t) (s_spectrum.levels[band] >> 8);
+    }
+
+    publish_audio_snapshot(&s_snapshot_ring, playoutTimeUs);
+}
+
+#endif
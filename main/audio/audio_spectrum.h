@@ -0,0 +1,47 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <esp_err.h>
+
+#include "sdkconfig.h"
+
+
+// -----------------------------------------------------------------------------------
+// Audio spectrum analyzer - Runs on its own task, on the core Bluedroid is pinned to
+//
+//  * The I2S task hands the mono signal decimated by the analysis tap over a lock free single producer single consumer queue
+//  * 512 points fixed point FFT (Hann window, 50% overlap) - One transform per 256 decimated samples, about 43 per second
+//  * Bins are aggregated into CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM_BANDS log spaced bands, smoothed with a fast attack and a slow decay
+//  * Results are published in a lock free ring of snapshots tagged with their playout time, like the analysis tap
+//
+// FFT cost and accuracy are reported by 'audio_bench fft' (CONFIG_HOLIDAYTREE_AUDIO_BENCHMARK)
+// -----------------------------------------------------------------------------------
+
+#define AUDIO_SPECTRUM_BAND_COUNT CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM_BANDS
+
+
+typedef struct {
+    uint32_t sequence;      // Incremented for every transform - 0 until the first transform
+    int64_t timestampUs;    // esp_timer time of the transform
+    int64_t playoutTimeUs;  // esp_timer time the newest sample of the transform is predicted to reach the DAC
+    uint16_t bands[AUDIO_SPECTRUM_BAND_COUNT];  // RMS level of each band in 16 bits sample units, lowest frequencies first
+} audio_spectrum_snapshot_t;
+
+
+esp_err_t start_audio_spectrum_analyzer();
+
+// I2S task side - Samples which do not fit in the queue are dropped
+void submit_audio_spectrum_samples(const int16_t* samples, uint32_t sampleCount, uint32_t sampleRate, int64_t playoutTimeUs);
+void reset_audio_spectrum();
+
+// Any task - Returns false if a consistent snapshot could not be copied, which only happens under heavy preemption
+bool get_audio_spectrum_snapshot(audio_spectrum_snapshot_t* snapshot);
+
+// Any task - Band levels of the audio being heard at 'timeUs' (esp_timer time)
+bool get_audio_spectrum_snapshot_at(int64_t timeUs, audio_spectrum_snapshot_t* snapshot);
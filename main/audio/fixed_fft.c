@@ -0,0 +1,198 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <math.h>
+
+#include "audio/fixed_fft.h"
+
+
+// Complex transform size - 4^4 points
+#define FIXED_FFT_COMPLEX_SIZE (FIXED_FFT_SIZE / 2)
+
+// e^(-2 * pi * i * k / FIXED_FFT_SIZE) - The complex transform uses even entries up to 3 * (FIXED_FFT_COMPLEX_SIZE / 4 - 1)
+#define FIXED_FFT_TWIDDLE_COUNT (3 * FIXED_FFT_SIZE / 4)
+
+
+typedef struct {
+    int16_t cosine;
+    int16_t sine;
+} fixed_fft_twiddle_t;
+
+static fixed_fft_twiddle_t s_twiddles[FIXED_FFT_TWIDDLE_COUNT];
+static int16_t s_hann_window[FIXED_FFT_SIZE];
+static uint8_t s_digit_reversal[FIXED_FFT_COMPLEX_SIZE];
+static bool s_tables_ready = false;
+
+
+static uint32_t load_windowed_samples(const int16_t* samples, fixed_fft_bin_t* data);
+static void transform_complex(fixed_fft_bin_t* data);
+static void split_real_spectrum(fixed_fft_bin_t* data);
+
+static inline int16_t to_q15(float value) {
+    const long quantized = lroundf(value * 32768.0f);
+    return (int16_t) (quantized > INT16_MAX ? INT16_MAX : (quantized < INT16_MIN ? INT16_MIN : quantized));
+}
+
+
+void fixed_fft_init() {
+    if (s_tables_ready) {
+        return;
+    }
+
+    for (uint32_t index = 0; index < FIXED_FFT_TWIDDLE_COUNT; index++) {
+        const float angle = 2.0f * (float) M_PI * (float) index / FIXED_FFT_SIZE;
+        s_twiddles[index].cosine = to_q15(cosf(angle));
+        s_twiddles[index].sine = to_q15(sinf(angle));
+    }
+
+    // Periodic Hann window - Spectral leakage is what matters for band levels, not the shape of the main lobe
+    for (uint32_t index = 0; index < FIXED_FFT_SIZE; index++) {
+        s_hann_window[index] = to_q15(0.5f - 0.5f * cosf(2.0f * (float) M_PI * (float) index / FIXED_FFT_SIZE));
+    }
+
+    // Radix-4 decimation in frequency leaves the output in base 4 digit reversed order
+    for (uint32_t index = 0; index < FIXED_FFT_COMPLEX_SIZE; index++) {
+        uint32_t reversed = 0;
+        for (uint32_t remaining = index, digits = FIXED_FFT_COMPLEX_SIZE; digits > 1; digits >>= 2, remaining >>= 2) {
+            reversed = (reversed << 2) | (remaining & 3);
+        }
+        s_digit_reversal[index] = (uint8_t) reversed;
+    }
+
+    s_tables_ready = true;
+}
+
+uint32_t compute_fixed_real_fft(const int16_t* samples, fixed_fft_bin_t* bins) {
+    const uint32_t shift = load_windowed_samples(samples, bins);
+    transform_complex(bins);
+    split_real_spectrum(bins);
+
+    return shift;
+}
+
+static uint32_t load_windowed_samples(const int16_t* samples, fixed_fft_bin_t* data) {
+    // The OR of magnitudes has the same leading bit as the peak
+    int32_t magnitudeBits = 0;
+    for (uint32_t index = 0; index < FIXED_FFT_SIZE; index++) {
+        const int32_t sample = samples[index];
+        magnitudeBits |= sample < 0 ? -sample : sample;
+    }
+
+    // Normalize the peak to 15 bits before windowing so quiet blocks keep their precision - Twiddle products then fit in 32 bits at every stage
+    uint32_t shift = 0;
+    if (magnitudeBits != 0) {
+        while ((magnitudeBits << shift) < (1 << 14)) {
+            shift++;
+        }
+    }
+
+    // Even samples become real parts and odd samples imaginary parts - Scaled by a multiply, shifting negative values left is undefined
+    const int32_t scale = 1 << shift;
+    for (uint32_t index = 0; index < FIXED_FFT_COMPLEX_SIZE; index++) {
+        data[index].real = ((samples[2 * index] * scale) * s_hann_window[2 * index] + (1 << 14)) >> 15;
+        data[index].imaginary = ((samples[2 * index + 1] * scale) * s_hann_window[2 * index + 1] + (1 << 14)) >> 15;
+    }
+
+    return shift;
+}
+
+static void transform_complex(fixed_fft_bin_t* data) {
+    // Each stage splits groups of 'span' points into four - Twiddle stride doubles since the table holds 2 * N points
+    uint32_t stride = 2;
+    for (uint32_t span = FIXED_FFT_COMPLEX_SIZE; span >= 4; span >>= 2, stride <<= 2) {
+        const uint32_t quarter = span >> 2;
+        for (uint32_t group = 0; group < FIXED_FFT_COMPLEX_SIZE; group += span) {
+            for (uint32_t index = 0; index < quarter; index++) {
+                fixed_fft_bin_t* a = &data[group + index];
+                fixed_fft_bin_t* b = a + quarter;
+                fixed_fft_bin_t* c = b + quarter;
+                fixed_fft_bin_t* d = c + quarter;
+
+                // Butterfly then scale by 1/4 - Inputs are at most 2^15 so sums of four fit comfortably
+                const int32_t sumAcReal = a->real + c->real;
+                const int32_t sumAcImaginary = a->imaginary + c->imaginary;
+                const int32_t differenceAcReal = a->real - c->real;
+                const int32_t differenceAcImaginary = a->imaginary - c->imaginary;
+                const int32_t sumBdReal = b->real + d->real;
+                const int32_t sumBdImaginary = b->imaginary + d->imaginary;
+                const int32_t differenceBdReal = b->real - d->real;
+                const int32_t differenceBdImaginary = b->imaginary - d->imaginary;
+
+                a->real = (sumAcReal + sumBdReal + 2) >> 2;
+                a->imaginary = (sumAcImaginary + sumBdImaginary + 2) >> 2;
+                if (index == 0) {
+                    // Unit twiddles
+                    b->real = (differenceAcReal + differenceBdImaginary + 2) >> 2;
+                    b->imaginary = (differenceAcImaginary - differenceBdReal + 2) >> 2;
+                    c->real = (sumAcReal - sumBdReal + 2) >> 2;
+                    c->imaginary = (sumAcImaginary - sumBdImaginary + 2) >> 2;
+                    d->real = (differenceAcReal - differenceBdImaginary + 2) >> 2;
+                    d->imaginary = (differenceAcImaginary + differenceBdReal + 2) >> 2;
+                    continue;
+                }
+
+                // Outputs 1, 2 and 3 are rotated by W^index, W^(2 * index) and W^(3 * index)
+                const int32_t y1Real = (differenceAcReal + differenceBdImaginary + 2) >> 2;
+                const int32_t y1Imaginary = (differenceAcImaginary - differenceBdReal + 2) >> 2;
+                const int32_t y2Real = (sumAcReal - sumBdReal + 2) >> 2;
+                const int32_t y2Imaginary = (sumAcImaginary - sumBdImaginary + 2) >> 2;
+                const int32_t y3Real = (differenceAcReal - differenceBdImaginary + 2) >> 2;
+                const int32_t y3Imaginary = (differenceAcImaginary + differenceBdReal + 2) >> 2;
+
+                const fixed_fft_twiddle_t* w1 = &s_twiddles[index * stride];
+                const fixed_fft_twiddle_t* w2 = &s_twiddles[2 * index * stride];
+                const fixed_fft_twiddle_t* w3 = &s_twiddles[3 * index * stride];
+
+                // (x + iy)(cos - i sin) - |x + iy| < 2^15.5 so each difference of products fits in 32 bits
+                b->real = (y1Real * w1->cosine + y1Imaginary * w1->sine + (1 << 14)) >> 15;
+                b->imaginary = (y1Imaginary * w1->cosine - y1Real * w1->sine + (1 << 14)) >> 15;
+                c->real = (y2Real * w2->cosine + y2Imaginary * w2->sine + (1 << 14)) >> 15;
+                c->imaginary = (y2Imaginary * w2->cosine - y2Real * w2->sine + (1 << 14)) >> 15;
+                d->real = (y3Real * w3->cosine + y3Imaginary * w3->sine + (1 << 14)) >> 15;
+                d->imaginary = (y3Imaginary * w3->cosine - y3Real * w3->sine + (1 << 14)) >> 15;
+            }
+        }
+    }
+
+    for (uint32_t index = 0; index < FIXED_FFT_COMPLEX_SIZE; index++) {
+        const uint32_t reversed = s_digit_reversal[index];
+        if (reversed > index) {
+            const fixed_fft_bin_t swap = data[index];
+            data[index] = data[reversed];
+            data[reversed] = swap;
+        }
+    }
+}
+
+static void split_real_spectrum(fixed_fft_bin_t* data) {
+    // Z = FFT(even + i odd) / 256 - X[k] = (Z[k] + Z*[N - k]) / 2 + W^k (Z[k] - Z*[N - k]) / 2i, one more halving gives X / 512
+    const int32_t dcReal = data[0].real;
+    const int32_t dcImaginary = data[0].imaginary;
+    data[0].real = (dcReal + dcImaginary + 1) >> 1;
+    data[0].imaginary = 0;
+
+    // Bins k and N - k are computed from the same pair of complex bins
+    for (uint32_t index = 1; index <= FIXED_FFT_COMPLEX_SIZE / 2; index++) {
+        const uint32_t mirror = FIXED_FFT_COMPLEX_SIZE - index;
+        const fixed_fft_bin_t z = data[index];
+        const fixed_fft_bin_t zMirror = data[mirror];
+
+        const int32_t aReal = (z.real + zMirror.real + 2) >> 2;
+        const int32_t aImaginary = (z.imaginary - zMirror.imaginary + 2) >> 2;
+        const int32_t bReal = (z.real - zMirror.real + 2) >> 2;
+        const int32_t bImaginary = (z.imaginary + zMirror.imaginary + 2) >> 2;
+
+        const fixed_fft_twiddle_t* w = &s_twiddles[index];
+        const int32_t rotatedReal = (w->cosine * bImaginary - w->sine * bReal + (1 << 14)) >> 15;
+        const int32_t rotatedImaginary = (w->cosine * bReal + w->sine * bImaginary + (1 << 14)) >> 15;
+
+        data[index].real = aReal + rotatedReal;
+        data[index].imaginary = aImaginary - rotatedImaginary;
+        if (mirror != index) {
+            data[mirror].real = aReal - rotatedReal;
+            data[mirror].imaginary = -aImaginary - rotatedImaginary;
+        }
+    }
+}
@@ -0,0 +1,35 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+
+// -----------------------------------------------------------------------------------
+// Fixed point real FFT
+//
+//  * 512 real samples are packed into 256 complex samples and transformed with a radix-4 decimation in frequency FFT
+//  * Every radix-4 stage scales by 1/4 so intermediate values stay within 16 bits - The input is normalized first
+//    (block floating point) so quiet signals keep their precision
+//  * Twiddles (Q15), Hann window (Q15) and digit reversal tables are computed once by fixed_fft_init()
+//  * Cost per transform and accuracy against a float DFT are reported by 'audio_bench fft', and checked against limits on
+//    the host by tools/host/fixed_fft_check.c
+// -----------------------------------------------------------------------------------
+
+#define FIXED_FFT_SIZE 512
+#define FIXED_FFT_BIN_COUNT (FIXED_FFT_SIZE / 2)
+
+
+typedef struct {
+    int32_t real;
+    int32_t imaginary;
+} fixed_fft_bin_t;
+
+
+void fixed_fft_init();
+
+// Applies a Hann window to FIXED_FFT_SIZE samples and transforms them - Bins 0 (DC) to FIXED_FFT_BIN_COUNT - 1
+// Bins are the DFT divided by FIXED_FFT_SIZE, scaled up by 2^shift where shift is the returned value
+uint32_t compute_fixed_real_fft(const int16_t* samples, fixed_fft_bin_t* bins);
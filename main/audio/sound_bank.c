@@ -0,0 +1,117 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <string.h>
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_partition.h>
+
+
+#include "audio/sound_bank.h"
+
+
+// Sound bank log tag
+static const char* SoundBankTag = "sound_bank";
+
+
+// Sound bank partition - See partitions.csv
+static const char* SoundBankPartitionName = "sounds";
+static const esp_partition_subtype_t SoundBankPartitionSubtype = (esp_partition_subtype_t) 0x40;
+
+// Sound bank header constants
+static const char SoundBankMagic[4] = { 'H', 'T', 'S', 'B' };
+static const uint16_t SoundBankVersion = 1;
+static const size_t SoundBankHeaderSize = 12;
+static const size_t SoundBankEntrySize = 16;
+
+
+typedef struct __attribute__((packed)) {
+    char magic[4];
+    uint16_t version;
+    uint16_t soundCount;
+    uint32_t totalSize;
+} sound_bank_header_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t dataOffset;
+    uint32_t dataSize;
+    uint32_t sampleCount;
+    uint16_t sampleRate;
+    uint16_t blockSize;
+} sound_bank_entry_t;
+
+
+// Flash mapping of the whole sound bank - It stays mapped for the lifetime of the application
+static const uint8_t* s_sound_bank = NULL;
+static esp_partition_mmap_handle_t s_sound_bank_mmap_handle = 0;
+static uint32_t s_sound_bank_sound_count = 0;
+
+
+static esp_err_t read_sound_bank_header(const esp_partition_t* partition, sound_bank_header_t* header);
+
+
+esp_err_t mount_sound_bank() {
+    const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, SoundBankPartitionSubtype, SoundBankPartitionName);
+    ESP_RETURN_ON_FALSE(partition != NULL, ESP_ERR_NOT_FOUND, SoundBankTag, "mount_sound_bank() - Partition '%s' not found", SoundBankPartitionName);
+
+    // Validate the header before mapping anything - An unflashed partition reads as 0xFF
+    sound_bank_header_t header = { 0 };
+    ESP_RETURN_ON_ERROR(read_sound_bank_header(partition, &header), SoundBankTag, "mount_sound_bank() - No valid sound bank in partition '%s'", SoundBankPartitionName);
+
+    // Map only the bytes used by the sound bank - Mapping consumes MMU pages shared with the application read only data
+    const void* mappedSoundBank = NULL;
+    ESP_RETURN_ON_ERROR(esp_partition_mmap(partition, 0, header.totalSize, ESP_PARTITION_MMAP_DATA, &mappedSoundBank, &s_sound_bank_mmap_handle), SoundBankTag, "esp_partition_mmap() failed");
+
+    s_sound_bank = (const uint8_t*) mappedSoundBank;
+    s_sound_bank_sound_count = header.soundCount;
+
+    ESP_LOGI(SoundBankTag, "Sound bank mounted - %u sounds - %lu bytes", header.soundCount, header.totalSize);
+    return ESP_OK;
+}
+
+uint32_t get_sound_bank_sound_count() {
+    return s_sound_bank_sound_count;
+}
+
+esp_err_t get_sound_bank_sound(uint32_t soundIndex, sound_bank_sound_t* sound) {
+    ESP_RETURN_ON_FALSE(sound != NULL, ESP_ERR_INVALID_ARG, SoundBankTag, "get_sound_bank_sound() - sound cannot be NULL");
+    if (soundIndex >= s_sound_bank_sound_count) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    sound_bank_entry_t entry;
+    memcpy(&entry, s_sound_bank + SoundBankHeaderSize + soundIndex * SoundBankEntrySize, sizeof(entry));
+
+    sound->data = s_sound_bank + entry.dataOffset;
+    sound->dataSize = entry.dataSize;
+    sound->sampleCount = entry.sampleCount;
+    sound->sampleRate = entry.sampleRate;
+    sound->blockSize = entry.blockSize;
+    return ESP_OK;
+}
+
+static esp_err_t read_sound_bank_header(const esp_partition_t* partition, sound_bank_header_t* header) {
+    ESP_RETURN_ON_ERROR(esp_partition_read(partition, 0, header, sizeof(*header)), SoundBankTag, "esp_partition_read() failed");
+
+    if ((memcmp(header->magic, SoundBankMagic, sizeof(SoundBankMagic)) != 0) || (header->version != SoundBankVersion)) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    const size_t entriesEnd = SoundBankHeaderSize + header->soundCount * SoundBankEntrySize;
+    if ((header->totalSize < entriesEnd) || (header->totalSize > partition->size)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // Every sound must lie within the bank - This keeps the decoder from reading past the mapping
+    for (uint16_t soundIndex = 0; soundIndex < header->soundCount; soundIndex++) {
+        sound_bank_entry_t entry;
+        ESP_RETURN_ON_ERROR(esp_partition_read(partition, SoundBankHeaderSize + soundIndex * SoundBankEntrySize, &entry, sizeof(entry)), SoundBankTag, "esp_partition_read() failed");
+        if ((entry.dataOffset < entriesEnd) || (entry.dataSize > header->totalSize - entry.dataOffset) || (entry.sampleRate == 0) || (entry.blockSize <= 4)) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+    }
+
+    return ESP_OK;
+}
@@ -0,0 +1,32 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+#include <esp_err.h>
+
+
+// -----------------------------------------------------------------------------------
+// Sound bank stored in the 'sounds' data partition - Built by tools/build_sound_bank.py
+//
+//  Header (12 bytes):  char[4] "HTSB", uint16_t version (1), uint16_t soundCount, uint32_t totalSize
+//  Entries (16 bytes): uint32_t dataOffset, uint32_t dataSize, uint32_t sampleCount, uint16_t sampleRate, uint16_t blockSize
+//  Mono IMA-ADPCM data for each sound (see audio/adpcm_decoder.h)
+// -----------------------------------------------------------------------------------
+
+typedef struct {
+    const uint8_t* data;    // Flash mapped ADPCM data
+    uint32_t dataSize;
+    uint32_t sampleCount;
+    uint32_t sampleRate;
+    uint32_t blockSize;
+} sound_bank_sound_t;
+
+
+esp_err_t mount_sound_bank();
+
+uint32_t get_sound_bank_sound_count();
+esp_err_t get_sound_bank_sound(uint32_t soundIndex, sound_bank_sound_t* sound);
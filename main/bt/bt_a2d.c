@@ -7,6 +7,10 @@
 #include <esp_gap_bt_api.h>
 #include <esp_a2dp_api.h>
 
+#if CONFIG_HOLIDAYTREE_A2DP_TRACE_CAPTURE
+#include <esp_timer.h>
+#endif
+
 
 #include "bt/utilities/bt_bd_addr_utilities.h"
 #include "bt/utilities/bt_a2d_utilities.h"
@@ -15,6 +19,10 @@
 #include "bt/i2s_output.h"
 #include "bt/bt_a2d.h"
 
+#if CONFIG_HOLIDAYTREE_A2DP_TRACE_CAPTURE
+#include "bt/bt_a2d_trace.h"
+#endif
+
 
 
 // Bluetooth A2D log tag
@@ -62,7 +70,22 @@ static void a2d_event_callback(esp_a2d_cb_event_t event, esp_a2d_cb_param_t* par
 }
 
 static void a2d_data_sink_callback(const uint8_t* data, uint32_t len) {
+#if CONFIG_HOLIDAYTREE_A2DP_TRACE_CAPTURE
+    // Arrival time is taken before write_to_i2s_output() which can block while the ring buffer is full
+    const bool tracing = is_a2d_trace_capturing();
+    const uint64_t arrivalUs = tracing ? esp_timer_get_time() : 0;
+#endif
+
     uint32_t byteWritten = write_to_i2s_output(data, len);
+
+#if CONFIG_HOLIDAYTREE_A2DP_TRACE_CAPTURE
+    // Record arrival time, size and ring buffer fill - No allocation or logging happens on this path, and the ring
+    // buffer is only queried while capturing
+    if (tracing) {
+        record_a2d_trace_packet(arrivalUs, len, get_i2s_output_ringbuffer_fill());
+    }
+#endif
+
     if (byteWritten != len) {
         ESP_LOGW(BtA2dTag, "a2d_data_sink_callback() failed to write to I2S ring buffer. Expected size: 0x%"PRIu32", Written size: 0x%"PRIu32, len, byteWritten);
     }
@@ -111,25 +134,17 @@ static void a2d_event_handler(uint16_t event, void* rawParams) {
             char bdaStr[18];
             ESP_LOGI(BtA2dTag, "ESP_A2D_CONNECTION_STATE_EVT %s remote [%s]", get_a2d_connection_state_name(params->conn_stat.state), get_bda_string(params->conn_stat.remote_bda, bdaStr));
 #endif
+            // I2S output is created at startup and outlives A2DP connections so local sounds can play without a phone
             switch (params->conn_stat.state) {
-                case ESP_A2D_CONNECTION_STATE_CONNECTING: {
-                    esp_err_t err = create_i2s_output();
+                case ESP_A2D_CONNECTION_STATE_CONNECTED: {
+                    esp_err_t err = set_i2s_output_source_connected(true);
                     if (err != ESP_OK) {
                         char errMsg[64];
-                        ESP_LOGE(BtA2dTag, "create_i2s_output() failed %s", esp_err_to_name_r(err, errMsg, sizeof(errMsg)));
+                        ESP_LOGE(BtA2dTag, "set_i2s_output_source_connected() failed %s", esp_err_to_name_r(err, errMsg, sizeof(errMsg)));
                     }
-                }
-                break;
 
-                case ESP_A2D_CONNECTION_STATE_CONNECTED: {
-                    esp_err_t err = esp_bt_gap_set_scan_mode(ESP_BT_NON_CONNECTABLE, ESP_BT_NON_DISCOVERABLE);
-                    if (err == ESP_OK) {
-                        err = start_i2s_output();
-                        if (err != ESP_OK) {
-                            char errMsg[64];
-                            ESP_LOGE(BtA2dTag, "start_i2s_output() failed %s", esp_err_to_name_r(err, errMsg, sizeof(errMsg)));
-                        }
-                    } else {
+                    err = esp_bt_gap_set_scan_mode(ESP_BT_NON_CONNECTABLE, ESP_BT_NON_DISCOVERABLE);
+                    if (err != ESP_OK) {
                         char errMsg[64];
                         ESP_LOGE(BtA2dTag, "esp_bt_gap_set_scan_mode() failed %s", esp_err_to_name_r(err, errMsg, sizeof(errMsg)));
                     }
@@ -137,11 +152,18 @@ static void a2d_event_handler(uint16_t event, void* rawParams) {
                 break;
 
                 case ESP_A2D_CONNECTION_STATE_DISCONNECTED: {
-                    // Shutdown I2S output
-                    esp_err_t err = delete_i2s_output();
+                    // Stop A2DP audio and drop any buffered audio
+                    esp_err_t err = set_i2s_output_audio_state(ESP_A2D_AUDIO_STATE_SUSPEND);
+                    if (err != ESP_OK) {
+                        char errMsg[64];
+                        ESP_LOGE(BtA2dTag, "set_i2s_output_audio_state() failed %s", esp_err_to_name_r(err, errMsg, sizeof(errMsg)));
+                    }
+
+                    // The I2S output and the amplifier are stopped once nothing plays
+                    err = set_i2s_output_source_connected(false);
                     if (err != ESP_OK) {
                         char errMsg[64];
-                        ESP_LOGE(BtA2dTag, "delete_i2s_output() failed %s", esp_err_to_name_r(err, errMsg, sizeof(errMsg)));
+                        ESP_LOGE(BtA2dTag, "set_i2s_output_source_connected() failed %s", esp_err_to_name_r(err, errMsg, sizeof(errMsg)));
                     }
 
                     // Make device discoverable again so a new connection can be established
@@ -0,0 +1,194 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_console.h>
+
+
+#include "bt/i2s_output.h"
+#include "bt/bt_a2d_trace.h"
+
+
+#if CONFIG_HOLIDAYTREE_A2DP_TRACE_CAPTURE
+
+// A2DP trace capture log tag
+static const char* BtA2dTraceTag = "bt_a2d_trace";
+
+
+// Capture buffer - Preallocated so the A2DP data callback never allocates
+static const uint32_t TraceRecordsCount = CONFIG_HOLIDAYTREE_A2DP_TRACE_CAPTURE_RECORDS;
+static a2d_trace_record_t s_trace_records[CONFIG_HOLIDAYTREE_A2DP_TRACE_CAPTURE_RECORDS];
+
+// Trace header constants
+static const char TraceMagic[4] = { 'H', 'T', 'A', '2' };
+static const uint8_t TraceFormatVersion = 1;
+
+// Number of bytes emitted per line when dumping to the console
+#define A2D_TRACE_DUMP_BYTES_PER_LINE 32
+
+
+// Capture state - Only written by the A2DP data callback while capturing
+static uint32_t s_trace_next_index = 0;
+static uint32_t s_trace_total_count = 0;
+static uint64_t s_trace_last_timestamp_us = 0;
+
+// Capture on / off and "callback is recording" flags - See stop_a2d_trace_capture()
+static volatile atomic_bool s_atomic_trace_capturing = false;
+static volatile atomic_bool s_atomic_trace_writer_active = false;
+
+
+static void start_a2d_trace_capture();
+static void stop_a2d_trace_capture();
+static void dump_a2d_trace();
+static void dump_bytes_as_hex(const uint8_t* data, size_t size, char* line, size_t* lineOffset);
+
+static int a2d_trace_console_command(int argc, char** argv);
+
+
+bool is_a2d_trace_capturing() {
+    return atomic_load(&s_atomic_trace_capturing);
+}
+
+void record_a2d_trace_packet(uint64_t arrivalUs, uint32_t length, uint32_t ringFill) {
+    // Announce the callback is active before looking at the capture flag - Pairs with stop_a2d_trace_capture()
+    atomic_store(&s_atomic_trace_writer_active, true);
+
+    if (atomic_load(&s_atomic_trace_capturing)) {
+        a2d_trace_record_t* record = &s_trace_records[s_trace_next_index];
+        record->deltaUs = s_trace_total_count == 0 ? 0 : (uint32_t) (arrivalUs - s_trace_last_timestamp_us);
+        record->length = length > UINT16_MAX ? UINT16_MAX : (uint16_t) length;
+        record->ringFill = ringFill > UINT16_MAX ? UINT16_MAX : (uint16_t) ringFill;
+
+        s_trace_last_timestamp_us = arrivalUs;
+        s_trace_total_count++;
+        s_trace_next_index = s_trace_next_index + 1 < TraceRecordsCount ? s_trace_next_index + 1 : 0;
+    }
+
+    atomic_store(&s_atomic_trace_writer_active, false);
+}
+
+esp_err_t register_a2d_trace_console_command() {
+    const esp_console_cmd_t traceCommand = {
+        .command = "a2dp_trace",
+        .help = "Capture A2DP packet arrivals - 'a2dp_trace start|stop|status|dump'",
+        .hint = NULL,
+        .func = &a2d_trace_console_command
+    };
+
+    ESP_RETURN_ON_ERROR(esp_console_cmd_register(&traceCommand), BtA2dTraceTag, "esp_console_cmd_register() failed");
+    return ESP_OK;
+}
+
+static void start_a2d_trace_capture() {
+    // The data callback does not touch capture state once capture is stopped - It is safe to reset it
+    stop_a2d_trace_capture();
+
+    s_trace_next_index = 0;
+    s_trace_total_count = 0;
+    s_trace_last_timestamp_us = 0;
+
+    atomic_store(&s_atomic_trace_capturing, true);
+}
+
+static void stop_a2d_trace_capture() {
+    atomic_store(&s_atomic_trace_capturing, false);
+
+    // A callback which observed "capturing" before it was cleared may still be writing its record - Let it finish
+    while (atomic_load(&s_atomic_trace_writer_active)) {
+        vTaskDelay(1);
+    }
+}
+
+static void dump_a2d_trace() {
+    // The capture buffer must be stable while it is dumped
+    stop_a2d_trace_capture();
+
+    const uint32_t recordCount = s_trace_total_count < TraceRecordsCount ? s_trace_total_count : TraceRecordsCount;
+    const uint32_t droppedCount = s_trace_total_count - recordCount;
+    const uint32_t oldestIndex = s_trace_total_count < TraceRecordsCount ? 0 : s_trace_next_index;
+
+    // Walk back from the most recent record to find the absolute time of the oldest one
+    uint64_t baseTimestampUs = s_trace_last_timestamp_us;
+    for (uint32_t count = 1; count < recordCount; count++) {
+        baseTimestampUs -= s_trace_records[(oldestIndex + count) % TraceRecordsCount].deltaUs;
+    }
+
+    const uint32_t ringbufferSize = get_i2s_output_ringbuffer_size();
+
+    uint8_t header[28] = { 0 };
+    memcpy(&header[0], TraceMagic, sizeof(TraceMagic));
+    header[4] = TraceFormatVersion;
+    header[5] = sizeof(a2d_trace_record_t);
+    memcpy(&header[8], &recordCount, sizeof(recordCount));
+    memcpy(&header[12], &droppedCount, sizeof(droppedCount));
+    memcpy(&header[16], &baseTimestampUs, sizeof(baseTimestampUs));
+    memcpy(&header[24], &ringbufferSize, sizeof(ringbufferSize));
+
+    // Printed like the other console commands so the log level cannot drop it - One printf() per line so log lines from
+    // other tasks cannot split a line of the dump
+    printf("----- BEGIN A2DP TRACE -----\n");
+
+    char line[2 * A2D_TRACE_DUMP_BYTES_PER_LINE + 1] = { 0 };
+    size_t lineOffset = 0;
+    dump_bytes_as_hex(header, sizeof(header), line, &lineOffset);
+
+    for (uint32_t count = 0; count < recordCount; count++) {
+        a2d_trace_record_t record = s_trace_records[(oldestIndex + count) % TraceRecordsCount];
+        if (count == 0) {
+            record.deltaUs = 0;
+        }
+        dump_bytes_as_hex((const uint8_t*) &record, sizeof(record), line, &lineOffset);
+    }
+
+    if (lineOffset != 0) {
+        line[2 * lineOffset] = '\0';
+        printf("%s\n", line);
+    }
+    printf("----- END A2DP TRACE -----\n");
+}
+
+static void dump_bytes_as_hex(const uint8_t* data, size_t size, char* line, size_t* lineOffset) {
+    static const char HexDigits[] = "0123456789abcdef";
+    for (size_t index = 0; index < size; index++) {
+        line[2 * (*lineOffset)] = HexDigits[data[index] >> 4];
+        line[2 * (*lineOffset) + 1] = HexDigits[data[index] & 0x0F];
+        if (++(*lineOffset) == A2D_TRACE_DUMP_BYTES_PER_LINE) {
+            line[2 * A2D_TRACE_DUMP_BYTES_PER_LINE] = '\0';
+            printf("%s\n", line);
+            *lineOffset = 0;
+        }
+    }
+}
+
+static int a2d_trace_console_command(int argc, char** argv) {
+    const char* const subCommand = argc > 1 ? argv[1] : "status";
+
+    if (strcmp(subCommand, "start") == 0) {
+        start_a2d_trace_capture();
+        printf("A2DP trace capture started (%"PRIu32" records)\n", TraceRecordsCount);
+    } else if (strcmp(subCommand, "stop") == 0) {
+        stop_a2d_trace_capture();
+        printf("A2DP trace capture stopped - %"PRIu32" packets seen\n", s_trace_total_count);
+    } else if (strcmp(subCommand, "status") == 0) {
+        printf("A2DP trace capture %s - %"PRIu32" packets seen - Buffer holds %"PRIu32" records\n", atomic_load(&s_atomic_trace_capturing) ? "running" : "stopped", s_trace_total_count, TraceRecordsCount);
+    } else if (strcmp(subCommand, "dump") == 0) {
+        dump_a2d_trace();
+    } else {
+        printf("Unknown sub command '%s' - Use start, stop, status or dump\n", subCommand);
+        return 1;
+    }
+
+    return 0;
+}
+
+#endif
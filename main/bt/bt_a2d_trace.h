@@ -0,0 +1,45 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <esp_err.h>
+
+
+// -----------------------------------------------------------------------------------
+// A2DP packet arrival trace - Binary format (all fields little endian)
+//
+//  Header (28 bytes):
+//      char[4]  magic              "HTA2"
+//      uint8_t  version            1
+//      uint8_t  recordSize         8
+//      uint16_t reserved           0
+//      uint32_t recordCount        Number of records following the header
+//      uint32_t droppedCount       Records overwritten because the capture buffer wrapped around
+//      uint64_t baseTimestampUs    esp_timer time of the first record
+//      uint32_t ringbufferSize     I2S ring buffer capacity in bytes
+//
+//  Record (8 bytes) - Oldest first:
+//      uint32_t deltaUs            Time since the previous record (0 for the first record)
+//      uint16_t length             Bytes delivered by a2d_data_sink_callback() - Clamped to UINT16_MAX
+//      uint16_t ringFill           I2S ring buffer fill after the packet was queued - Clamped to UINT16_MAX
+//
+// See tools/a2dp_trace_decode.py to turn a console dump into CSV or a raw binary file
+// -----------------------------------------------------------------------------------
+
+typedef struct __attribute__((packed)) {
+    uint32_t deltaUs;
+    uint16_t length;
+    uint16_t ringFill;
+} a2d_trace_record_t;
+
+
+// A2DP data callback - Records nothing unless a capture is running
+bool is_a2d_trace_capturing();
+void record_a2d_trace_packet(uint64_t arrivalUs, uint32_t length, uint32_t ringFill);
+
+esp_err_t register_a2d_trace_console_command();
@@ -11,13 +11,26 @@
 #include <freertos/task.h>
 #include <freertos/ringbuf.h>
 
+#include <esp_attr.h>
 #include <esp_check.h>
 #include <esp_log.h>
 
-#if CONFIG_HOLIDAYTREE_DETAILED_I2S_DATA_PROCESSING_LOG
+#if CONFIG_HOLIDAYTREE_DETAILED_I2S_DATA_PROCESSING_LOG || CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
 #include <esp_timer.h>
 #endif
 
+#include "audio/audio_mixer.h"
+#include "audio/audio_resampler.h"
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SILENCE_GATING
+#include "audio/audio_silence.h"
+#endif
+
+#if CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
+#include "audio/audio_analysis.h"
+#endif
+#include "audio/sound_bank.h"
+
 #include "bt/bt_avrc_volume.h"
 #include "bt/i2s_output.h"
 
@@ -32,6 +45,9 @@ static const gpio_num_t I2sDataPin = GPIO_NUM_25;
 static const gpio_num_t I2sBckPin = GPIO_NUM_26;
 static const gpio_num_t I2sLrckPin = GPIO_NUM_27;
 
+// Amplifier enable pin - Driven low while the output is gated - GPIO_NUM_NC when the amplifier has no enable pin
+static const gpio_num_t AmpEnablePin = (gpio_num_t) CONFIG_HOLIDAYTREE_AUDIO_AMP_ENABLE_GPIO;
+
 
 // Number of audio bytes received from the A2DP callback (per call)
 static const size_t A2DPBatchSizeInBytes = 4096; // 4K bytes
@@ -72,8 +88,68 @@ static size_t s_bytes_to_take_from_ringbuffer = 0;
 
 static uint8_t* s_i2s_audio_processing_buffer = NULL;
 
+// Mixes local sounds with A2DP audio - Voices are started from any task and mixed on the I2S task
+static audio_mixer_t s_audio_mixer = AUDIO_MIXER_INITIALIZER;
+
 static volatile atomic_uint_fast8_t s_atomic_current_audio_state = A2DPAudioStateNone;
 
+// Whether an A2DP source is connected - Written by the Bluetooth task, read by the I2S task before it waits
+static volatile atomic_bool s_atomic_source_connected = false;
+
+
+// I2S channel clock and slot configuration
+typedef struct {
+    uint32_t sampleRate;
+    i2s_data_bit_width_t dataWidth;
+    i2s_slot_mode_t slotMode;
+} i2s_output_format_t;
+
+#if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+// The I2S channel always runs at this format - A2DP audio is converted to it
+#define DEFAULT_I2S_OUTPUT_FORMAT { .sampleRate = CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_SAMPLE_RATE, .dataWidth = I2S_DATA_BIT_WIDTH_16BIT, .slotMode = I2S_SLOT_MODE_STEREO }
+#else
+// Format the I2S channel is created with - Assume 44.1kHz, 16 bits, stereo
+#define DEFAULT_I2S_OUTPUT_FORMAT { .sampleRate = 44100, .dataWidth = I2S_DATA_BIT_WIDTH_16BIT, .slotMode = I2S_SLOT_MODE_STEREO }
+#endif
+static const i2s_output_format_t DefaultI2sOutputFormat = DEFAULT_I2S_OUTPUT_FORMAT;
+
+// Format requested by A2DP - Written by the Bluetooth task, applied by the I2S task before writing A2DP audio
+static _lock_t s_a2dp_format_lock;
+static i2s_output_format_t s_a2dp_format = DEFAULT_I2S_OUTPUT_FORMAT;
+
+// Format the I2S channel is currently configured with - Only accessed by the I2S task once it is running
+static i2s_output_format_t s_i2s_current_format = DEFAULT_I2S_OUTPUT_FORMAT;
+
+// Output gating - The I2S channel is disabled and the amplifier turned off while nothing plays and no source is connected, and
+// after CONFIG_HOLIDAYTREE_AUDIO_SILENCE_HOLD_MS of digital silence with silence gating - Only accessed by the I2S task once it is running
+static bool s_i2s_output_gated = false;
+#if CONFIG_HOLIDAYTREE_AUDIO_SILENCE_GATING
+static uint32_t s_silent_frame_count = 0;
+#endif
+
+#if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+// A2DP audio converted to the I2S format - Only accessed by the I2S task
+static audio_resampler_t s_a2dp_resampler;
+static int16_t* s_i2s_resampled_buffer = NULL;
+static uint32_t s_i2s_resampled_buffer_frames = 0;
+#endif
+
+#if CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
+// Playout prediction - The DMA 'sent' interrupt records how many bytes have been played and when
+typedef struct {
+    uint32_t sentBytes;
+    int64_t sentTimeUs;
+} i2s_dma_progress_t;
+
+// Written by the I2S interrupt under a sequence lock - Odd while being updated
+static i2s_dma_progress_t s_i2s_dma_progress;
+static volatile atomic_uint_fast32_t s_atomic_dma_progress_sequence = 0;
+
+// Bytes handed to the I2S driver and DMA buffer size - Only accessed by the I2S task once it is running
+static uint32_t s_i2s_written_bytes = 0;
+static uint32_t s_i2s_dma_frame_count = 0;
+#endif
+
 
 static esp_err_t create_i2s_channel();
 static esp_err_t delete_i2s_channel();
@@ -89,8 +165,29 @@ static void log_ringbuffer_outgoing_stats(BaseType_t bytesWaitingToBeRetrieved,
 static void log_ringbuffer_operation_stats(uint64_t startEspTime, uint64_t endEspTime, const char* const operationName);
 #endif
 
+static void get_i2s_output_formats(i2s_output_format_t* a2dpFormat, i2s_output_format_t* outputFormat);
+static esp_err_t apply_i2s_output_format(const i2s_output_format_t* const format);
+
+#if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+static uint32_t prepare_a2dp_resampler(const i2s_output_format_t* const a2dpFormat);
+static uint32_t resample_a2dp_audio(const int16_t* samples, uint32_t frameCount);
+#endif
+
 static esp_err_t take_from_ringbuffer_and_write_to_i2s(size_t maxBytesToTakeFromBuffer);
-static void apply_volume(void* data, size_t len, uint8_t bytePerSample);
+
+static esp_err_t mix_local_sounds_and_write_to_i2s();
+static esp_err_t write_audio_block_to_i2s(const int16_t* samples, uint32_t frameCount);
+
+static esp_err_t gate_i2s_output();
+static esp_err_t ungate_i2s_output();
+
+#if CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
+static bool on_i2s_dma_buffer_sent(i2s_chan_handle_t handle, i2s_event_data_t* event, void* userContext);
+static void get_i2s_dma_progress(i2s_dma_progress_t* progress);
+static void reset_i2s_playout_prediction();
+static int64_t predict_i2s_playout_time();
+#endif
+static uint32_t get_master_gain();
 static void drain_ringbuffer();
 
 static esp_err_t notify_a2dp_audio_active();
@@ -135,22 +232,88 @@ esp_err_t delete_i2s_output() {
 }
 
 esp_err_t configure_i2s_output(uint32_t sampleRate, i2s_data_bit_width_t dataWidth, i2s_slot_mode_t slotMode) {
-    // Disable the transmission channel so it can be reconfigured
-    ESP_RETURN_ON_ERROR(i2s_channel_disable(s_i2s_tx_channel), BtI2sOutputTag, "i2s_channel_disable() failed");
+    ESP_RETURN_ON_FALSE(sampleRate > 0, ESP_ERR_INVALID_ARG, BtI2sOutputTag, "configure_i2s_output() - Invalid sample rate");
+    ESP_RETURN_ON_FALSE(dataWidth == I2S_DATA_BIT_WIDTH_16BIT, ESP_ERR_NOT_SUPPORTED, BtI2sOutputTag, "configure_i2s_output() - Only 16 bits samples are supported");
+    ESP_RETURN_ON_FALSE((slotMode == I2S_SLOT_MODE_MONO) || (slotMode == I2S_SLOT_MODE_STEREO), ESP_ERR_INVALID_ARG, BtI2sOutputTag, "configure_i2s_output() - Invalid slot mode");
+
+    // The I2S task owns the channel - It applies this format before writing A2DP audio since local sounds may use a different one
+    _lock_acquire(&s_a2dp_format_lock);
+        s_a2dp_format.sampleRate = sampleRate;
+        s_a2dp_format.dataWidth = dataWidth;
+        s_a2dp_format.slotMode = slotMode;
+    _lock_release(&s_a2dp_format_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t play_i2s_output_sound(uint32_t soundIndex) {
+    ESP_RETURN_ON_FALSE(soundIndex < get_sound_bank_sound_count(), ESP_ERR_NOT_FOUND, BtI2sOutputTag, "play_i2s_output_sound(%lu) - Unknown sound", soundIndex);
+    ESP_RETURN_ON_FALSE(s_i2s_task_handle != NULL, ESP_ERR_INVALID_STATE, BtI2sOutputTag, "play_i2s_output_sound() - I2S output is not started");
+
+    sound_bank_sound_t sound;
+    ESP_RETURN_ON_ERROR(get_sound_bank_sound(soundIndex, &sound), BtI2sOutputTag, "get_sound_bank_sound(%lu) failed", soundIndex);
+
+    // Sounds are mixed with A2DP audio - The request is dropped when all effect voices are busy
+    const audio_mixer_voice_id_t voiceId = start_audio_mixer_voice(&s_audio_mixer, &sound, AudioMixerUnityGain);
+    ESP_RETURN_ON_FALSE(voiceId != AudioMixerNoVoice, ESP_ERR_NO_MEM, BtI2sOutputTag, "play_i2s_output_sound(%lu) - No free mixer voice", soundIndex);
+
+    // Wake up the I2S task in case it is idle
+    const BaseType_t outcome = xTaskNotifyIndexed(s_i2s_task_handle, I2STaskNotificationIndex, I2STaskNotificationValue, eSetValueWithOverwrite);
+    return outcome == pdPASS ? ESP_OK : ESP_FAIL;
+}
+
+bool is_i2s_output_playing() {
+    return (atomic_load(&s_atomic_current_audio_state) == A2DPAudioStateActive) || are_audio_mixer_voices_active(&s_audio_mixer);
+}
+
+static void get_i2s_output_formats(i2s_output_format_t* a2dpFormat, i2s_output_format_t* outputFormat) {
+    _lock_acquire(&s_a2dp_format_lock);
+        *a2dpFormat = s_a2dp_format;
+    _lock_release(&s_a2dp_format_lock);
+
+#if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+    *outputFormat = DefaultI2sOutputFormat;
+#else
+    *outputFormat = *a2dpFormat;
+#endif
+}
+
+static esp_err_t apply_i2s_output_format(const i2s_output_format_t* const format) {
+    if ((format->sampleRate == s_i2s_current_format.sampleRate) && (format->dataWidth == s_i2s_current_format.dataWidth) && (format->slotMode == s_i2s_current_format.slotMode)) {
+        return ESP_OK;
+    }
+
+#if CONFIG_HOLIDAYTREE_I2S_OUTPUT_LOG
+    ESP_LOGI(BtI2sOutputTag, "apply_i2s_output_format() - %lu Hz - %d bits - %d channel(s)", format->sampleRate, format->dataWidth, format->slotMode);
+#endif
+
+    // Disable the transmission channel so it can be reconfigured - A gated channel is already disabled
+    const bool channelEnabled = !s_i2s_output_gated;
+    if (channelEnabled) {
+        ESP_RETURN_ON_ERROR(i2s_channel_disable(s_i2s_tx_channel), BtI2sOutputTag, "i2s_channel_disable() failed");
+    }
 
     // Re-configure clock 
-    i2s_std_clk_config_t clkCfg = I2S_STD_CLK_DEFAULT_CONFIG(sampleRate);
-    ESP_RETURN_ON_ERROR(i2s_channel_reconfig_std_clock(s_i2s_tx_channel, &clkCfg), BtI2sOutputTag, "i2s_channel_reconfig_std_clock(%lu) failed", sampleRate);
+    i2s_std_clk_config_t clkCfg = I2S_STD_CLK_DEFAULT_CONFIG(format->sampleRate);
+    ESP_RETURN_ON_ERROR(i2s_channel_reconfig_std_clock(s_i2s_tx_channel, &clkCfg), BtI2sOutputTag, "i2s_channel_reconfig_std_clock(%lu) failed", format->sampleRate);
 
     // Re-configure slot
-    i2s_std_slot_config_t slotCfg = I2S_STD_MSB_SLOT_DEFAULT_CONFIG(dataWidth, slotMode);
-    ESP_RETURN_ON_ERROR(i2s_channel_reconfig_std_slot(s_i2s_tx_channel, &slotCfg), BtI2sOutputTag, "i2s_channel_reconfig_std_slot(%d) failed", slotMode);
+    i2s_std_slot_config_t slotCfg = I2S_STD_MSB_SLOT_DEFAULT_CONFIG(format->dataWidth, format->slotMode);
+    ESP_RETURN_ON_ERROR(i2s_channel_reconfig_std_slot(s_i2s_tx_channel, &slotCfg), BtI2sOutputTag, "i2s_channel_reconfig_std_slot(%d) failed", format->slotMode);
 
     // Enable the channel
-    ESP_RETURN_ON_ERROR(i2s_channel_enable(s_i2s_tx_channel), BtI2sOutputTag, "i2s_channel_enable");
+    if (channelEnabled) {
+        ESP_RETURN_ON_ERROR(i2s_channel_enable(s_i2s_tx_channel), BtI2sOutputTag, "i2s_channel_enable");
+    }
 
     // Cache per channel data width in byte - We currently only support SBC which is 16 bits per sample per channel
-    s_bytes_per_sample_per_channel = dataWidth / 8;
+    s_bytes_per_sample_per_channel = format->dataWidth / 8;
+    s_i2s_current_format = *format;
+
+#if CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
+    // Disabling the channel dropped whatever was queued in DMA buffers
+    reset_i2s_playout_prediction();
+#endif
 
     return ESP_OK;
 }
@@ -171,10 +334,10 @@ static esp_err_t create_i2s_channel() {
         .intr_priority = 0              // Priority level - When 0, the driver allocates an interrupt with "low" priority (1,2,3)
     };
 
-    // Standard configuration for I2S - Assume 44.1kHz - Frequency, sample size and number of channels can be changed without deleting the channel
+    // Standard configuration for I2S - Frequency, sample size and number of channels can be changed without deleting the channel
     i2s_std_config_t stdCfg = {
-        .clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(44100),
-        .slot_cfg = I2S_STD_MSB_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_STEREO),
+        .clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(DefaultI2sOutputFormat.sampleRate),
+        .slot_cfg = I2S_STD_MSB_SLOT_DEFAULT_CONFIG(DefaultI2sOutputFormat.dataWidth, DefaultI2sOutputFormat.slotMode),
         .gpio_cfg = {
             .mclk = I2S_GPIO_UNUSED,
             .bclk = I2sBckPin,
@@ -190,10 +353,40 @@ static esp_err_t create_i2s_channel() {
     };
 
     esp_err_t ret = ESP_OK;
+
+    // Amplifier enable pin - The amplifier starts enabled
+    if (AmpEnablePin != GPIO_NUM_NC) {
+        const gpio_config_t ampEnableConfiguration = {
+            .pin_bit_mask = (1ULL << AmpEnablePin),
+            .mode = GPIO_MODE_OUTPUT,
+            .pull_up_en = GPIO_PULLUP_DISABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type = GPIO_INTR_DISABLE
+        };
+        ESP_RETURN_ON_ERROR(gpio_config(&ampEnableConfiguration), BtI2sOutputTag, "gpio_config(%d) failed", AmpEnablePin);
+        ESP_RETURN_ON_ERROR(gpio_set_level(AmpEnablePin, 1), BtI2sOutputTag, "gpio_set_level(%d) failed", AmpEnablePin);
+    }
+    s_i2s_output_gated = false;
+#if CONFIG_HOLIDAYTREE_AUDIO_SILENCE_GATING
+    s_silent_frame_count = 0;
+#endif
+
     ESP_GOTO_ON_ERROR(i2s_new_channel(&channelCfg, &s_i2s_tx_channel, NULL), cleanup, BtI2sOutputTag, "i2s_new_channel() failed");
     ESP_GOTO_ON_ERROR(i2s_channel_init_std_mode(s_i2s_tx_channel, &stdCfg), cleanup, BtI2sOutputTag, "i2s_channel_init_std_mode() failed");
+
+#if CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
+    // Callbacks must be registered while the channel is disabled
+    const i2s_event_callbacks_t eventCallbacks = {
+        .on_sent = on_i2s_dma_buffer_sent
+    };
+    ESP_GOTO_ON_ERROR(i2s_channel_register_event_callback(s_i2s_tx_channel, &eventCallbacks, NULL), cleanup, BtI2sOutputTag, "i2s_channel_register_event_callback() failed");
+    s_i2s_dma_frame_count = dmaFrameNum;
+    s_i2s_written_bytes = 0;
+#endif
+
     ESP_GOTO_ON_ERROR(i2s_channel_enable(s_i2s_tx_channel), cleanup, BtI2sOutputTag, "i2s_channel_enable() failed");
 
+    s_i2s_current_format = DefaultI2sOutputFormat;
     return ESP_OK;
 
 cleanup:
@@ -208,7 +401,9 @@ cleanup:
 static esp_err_t delete_i2s_channel() {
     esp_err_t err = ESP_OK;
     if (s_i2s_tx_channel != NULL) {
-        if ((err = i2s_channel_disable(s_i2s_tx_channel)) != ESP_OK) {
+        // A gated channel is already disabled
+        const bool channelEnabled = !s_i2s_output_gated;
+        if (channelEnabled && ((err = i2s_channel_disable(s_i2s_tx_channel)) != ESP_OK)) {
             ESP_LOGW(BtI2sOutputTag, "i2s_channel_disable() failed while shutting down I2S (%d)", err);
         }
 
@@ -229,8 +424,12 @@ static esp_err_t start_i2s_output_task() {
 
     esp_err_t err = ESP_OK;
 
-    // No known A2DP audio state
+    // No known A2DP audio state and no local sound
     atomic_store(&s_atomic_current_audio_state, A2DPAudioStateNone);
+    stop_all_audio_mixer_voices(&s_audio_mixer);
+
+    // The channel is created with 16 bits samples - See create_i2s_channel()
+    s_bytes_per_sample_per_channel = s_i2s_current_format.dataWidth / 8;
 
     // Allocate audio processing buffer
     s_i2s_audio_processing_buffer = (uint8_t*)heap_caps_calloc(1, s_bytes_to_take_from_ringbuffer, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
@@ -240,6 +439,18 @@ static esp_err_t start_i2s_output_task() {
         goto cleanup;
     }
 
+#if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+    // Converted A2DP audio - One I2S write worth of 16 bits stereo frames
+    s_i2s_resampled_buffer_frames = s_bytes_to_take_from_ringbuffer / (2 * sizeof(int16_t));
+    s_i2s_resampled_buffer = (int16_t*)heap_caps_calloc(s_i2s_resampled_buffer_frames, 2 * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (s_i2s_resampled_buffer == NULL) {
+        ESP_LOGE(BtI2sOutputTag, "start_i2s_output_task() - heap_caps_calloc() failed");
+        err = ESP_ERR_NO_MEM;
+        goto cleanup;
+    }
+    memset(&s_a2dp_resampler, 0, sizeof(s_a2dp_resampler));
+#endif
+
     // Create ring buffer
     s_i2s_ringbuffer = xRingbufferCreate(RingBufferMaximumSizeInBytes, RINGBUF_TYPE_BYTEBUF);
     if (s_i2s_ringbuffer == NULL) {
@@ -284,6 +495,12 @@ static esp_err_t stop_i2s_output_task() {
         heap_caps_free(s_i2s_audio_processing_buffer);
         s_i2s_audio_processing_buffer = NULL;
     }
+#if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+    if (s_i2s_resampled_buffer != NULL) {
+        heap_caps_free(s_i2s_resampled_buffer);
+        s_i2s_resampled_buffer = NULL;
+    }
+#endif
 
     return ESP_OK;
 }
@@ -302,6 +519,17 @@ esp_err_t set_i2s_output_audio_state(esp_a2d_audio_state_t audioState) {
     }
 }
 
+esp_err_t set_i2s_output_source_connected(bool connected) {
+    atomic_store(&s_atomic_source_connected, connected);
+    if (connected || (s_i2s_task_handle == NULL)) {
+        return ESP_OK;
+    }
+
+    // Wake up the I2S task so it gates the output once nothing plays
+    const BaseType_t outcome = xTaskNotifyIndexed(s_i2s_task_handle, I2STaskNotificationIndex, I2STaskNotificationValue, eSetValueWithOverwrite);
+    return outcome == pdPASS ? ESP_OK : ESP_FAIL;
+}
+
 uint32_t write_to_i2s_output(const uint8_t* data, uint32_t size) {
 #if CONFIG_HOLIDAYTREE_DETAILED_I2S_DATA_PROCESSING_LOG
     log_ringbuffer_incoming_stats(size);
@@ -338,6 +566,19 @@ uint32_t write_to_i2s_output(const uint8_t* data, uint32_t size) {
     }
 }
 
+uint32_t get_i2s_output_ringbuffer_fill() {
+    UBaseType_t bytesWaitingToBeRetrieved = 0;
+    if (s_i2s_ringbuffer != NULL) {
+        vRingbufferGetInfo(s_i2s_ringbuffer, NULL, NULL, NULL, NULL, &bytesWaitingToBeRetrieved);
+    }
+
+    return bytesWaitingToBeRetrieved;
+}
+
+uint32_t get_i2s_output_ringbuffer_size() {
+    return RingBufferMaximumSizeInBytes;
+}
+
 
 #if CONFIG_HOLIDAYTREE_DETAILED_I2S_DATA_PROCESSING_LOG
 
@@ -401,24 +642,50 @@ static void log_ringbuffer_operation_stats(uint64_t startEspTime, uint64_t endEs
 
 static void i2s_task_handler(void* arg) {
     for (;;) {
-        // Wait for an A2DP "Audio Start" notification - The task is notified only when A2DP audio state changes from 'Paused' to 'Active'
+        // Wait for an A2DP "Audio Start" or a local sound notification - The task is notified when A2DP audio state changes from 'Paused' to 'Active' or a local sound is requested
         uint32_t ulNotificationValue = 0UL;
 
-#if CONFIG_HOLIDAYTREE_DETAILED_I2S_DATA_PROCESSING_LOG
-        BaseType_t notificationWaitOutcome =
+        // Nothing plays and no source is connected - Gate the output until a sound or A2DP audio starts
+        if (!s_i2s_output_gated && !atomic_load(&s_atomic_source_connected)) {
+            esp_err_t err = gate_i2s_output();
+            if (err != ESP_OK) {
+                ESP_LOGW(BtI2sOutputTag, "i2s_task_handler() - gate_i2s_output() failed (%d)", err);
+            }
+        }
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SILENCE_GATING
+        // Nothing plays while the task waits - Gate the output if nothing happens for the hold time
+        const TickType_t notificationWaitTime = s_i2s_output_gated ? portMAX_DELAY : pdMS_TO_TICKS(CONFIG_HOLIDAYTREE_AUDIO_SILENCE_HOLD_MS);
+#else
+        const TickType_t notificationWaitTime = portMAX_DELAY;
 #endif
-        xTaskNotifyWaitIndexed(I2STaskNotificationIndex, 0x0, ULONG_MAX, &ulNotificationValue, portMAX_DELAY);
+        BaseType_t notificationWaitOutcome = xTaskNotifyWaitIndexed(I2STaskNotificationIndex, 0x0, ULONG_MAX, &ulNotificationValue, notificationWaitTime);
 
 #if CONFIG_HOLIDAYTREE_DETAILED_I2S_DATA_PROCESSING_LOG
         ESP_LOGI(BtI2sRingbufferTag, "i2s_task_handler() - xTaskNotifyWaitIndexed() [Returned: %d] [Value: %lu]", notificationWaitOutcome, ulNotificationValue);
 #endif
 
+        if (notificationWaitOutcome != pdTRUE) {
+#if CONFIG_HOLIDAYTREE_AUDIO_SILENCE_GATING
+            esp_err_t err = gate_i2s_output();
+            if (err != ESP_OK) {
+                ESP_LOGW(BtI2sOutputTag, "i2s_task_handler() - gate_i2s_output() failed (%d)", err);
+            }
+#endif
+            continue;
+        }
+
         // Unknown ring buffer mode when A2DP audio becomes active
         ringbuffer_mode_t ringbufferMode = RingbufferNone;
 
         // Unknown A2DP audio state
         a2dp_audio_state_t audioState = A2DPAudioStateNone;
 
+#if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+        // Do not carry resampler history over from a previous stream
+        memset(&s_a2dp_resampler, 0, sizeof(s_a2dp_resampler));
+#endif
+
         do {
             // Did we prefetch enough audio data to start writing to I2S?
             audioState = atomic_load(&s_atomic_current_audio_state);
@@ -449,6 +716,16 @@ static void i2s_task_handler(void* arg) {
                 drain_ringbuffer();
             }
 
+            // Local sounds are mixed into A2DP audio while it streams - Otherwise they are played on their own
+            audioState = atomic_load(&s_atomic_current_audio_state);
+            if ((audioState != A2DPAudioStateActive) && are_audio_mixer_voices_active(&s_audio_mixer)) {
+                esp_err_t err = mix_local_sounds_and_write_to_i2s();
+                if (err != ESP_OK) {
+                    ESP_LOGW(BtI2sOutputTag, "i2s_task_handler() - mix_local_sounds_and_write_to_i2s() failed (%d) - Stopping local sounds", err);
+                    stop_all_audio_mixer_voices(&s_audio_mixer);
+                }
+            }
+
             // When prefetching is necessary, wait for a little for the ring buffer to fill up
             audioState = atomic_load(&s_atomic_current_audio_state);
             if (audioState == A2DPAudioStateActive) {
@@ -457,20 +734,34 @@ static void i2s_task_handler(void* arg) {
                     vTaskDelay(PrefetchDelayTimeInTicks);
                 }
             }
-        } while (audioState == A2DPAudioStateActive);
+        } while ((audioState == A2DPAudioStateActive) || are_audio_mixer_voices_active(&s_audio_mixer));
     }
 }
 
 static esp_err_t take_from_ringbuffer_and_write_to_i2s(size_t maxBytesToTakeFromBuffer) {
     esp_err_t err = ESP_ERR_INVALID_SIZE;
 
-    // Retrieve the number of available bytes - We would like to read a multiple of samples so we can apply software volume in a meaningful way
+    // The I2S channel is reconfigured when the A2DP format changes, unless it runs at a fixed rate
+    i2s_output_format_t a2dpFormat;
+    i2s_output_format_t outputFormat;
+    get_i2s_output_formats(&a2dpFormat, &outputFormat);
+    ESP_RETURN_ON_ERROR(apply_i2s_output_format(&outputFormat), BtI2sOutputTag, "apply_i2s_output_format() failed");
+
+    const size_t bytesPerFrame = (a2dpFormat.dataWidth / 8) * (uint8_t) a2dpFormat.slotMode;
+
+#if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+    // Take no more A2DP frames than what fits in the resampled buffer once converted
+    const size_t maxBytesToResample = prepare_a2dp_resampler(&a2dpFormat) * bytesPerFrame;
+    maxBytesToTakeFromBuffer = maxBytesToTakeFromBuffer > maxBytesToResample ? maxBytesToResample : maxBytesToTakeFromBuffer;
+#endif
+
+    // Retrieve the number of available bytes - We would like to read a multiple of frames so the mixer processes whole frames
     UBaseType_t bytesWaitingToBeRetrieved = 0;
     vRingbufferGetInfo(s_i2s_ringbuffer, NULL, NULL, NULL, NULL, &bytesWaitingToBeRetrieved);
     size_t maxToRetrieveUnaligned = bytesWaitingToBeRetrieved > maxBytesToTakeFromBuffer ? maxBytesToTakeFromBuffer : bytesWaitingToBeRetrieved;
 
-    // Align to boundaries of the number of bytes per channel - In practice, this is 2 bytes
-    size_t bytesToTake = (maxToRetrieveUnaligned >> (s_bytes_per_sample_per_channel - 1)) << (s_bytes_per_sample_per_channel - 1);
+    // Align to frame boundaries - In practice, this is 4 bytes (16 bits stereo)
+    size_t bytesToTake = maxToRetrieveUnaligned - (maxToRetrieveUnaligned % bytesPerFrame);
     if (bytesToTake > 0) {
         size_t sizeRetrievedFromRingBufferInBytes = 0;
 
@@ -536,15 +827,18 @@ static esp_err_t take_from_ringbuffer_and_write_to_i2s(size_t maxBytesToTakeFrom
                 }
             }
 
-            // Data has been acquired and is a multiple of audio samples - Apply processing and write to I2S
+            // Data has been acquired and is a multiple of audio frames - Convert to the I2S rate, mix local sounds, apply volume and write to I2S
             if (err == ESP_OK) {
-                apply_volume(s_i2s_audio_processing_buffer, sizeRetrievedFromRingBufferInBytes, s_bytes_per_sample_per_channel);
+                int16_t* outputSamples = (int16_t*) s_i2s_audio_processing_buffer;
+                uint32_t frameCount = sizeRetrievedFromRingBufferInBytes / bytesPerFrame;
+#if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+                frameCount = resample_a2dp_audio(outputSamples, frameCount);
+                outputSamples = s_i2s_resampled_buffer;
+#endif
+                const uint8_t outputChannelCount = (uint8_t) s_i2s_current_format.slotMode;
+                mix_audio_block(&s_audio_mixer, outputSamples, frameCount, outputChannelCount, s_i2s_current_format.sampleRate, true, get_master_gain());
 
-                size_t bytesWritten = 0;
-                err = i2s_channel_write(s_i2s_tx_channel, (void*) s_i2s_audio_processing_buffer, sizeRetrievedFromRingBufferInBytes, &bytesWritten, portMAX_DELAY);
-                if (err != ESP_OK) {
-                    ESP_LOGE(BtI2sOutputTag, "i2s_channel_write() failed with %d - Attempted to write %u bytes", err, sizeRetrievedFromRingBufferInBytes);
-                }
+                err = write_audio_block_to_i2s(outputSamples, frameCount);
             }
         } else {
             ESP_LOGW(BtI2sOutputTag, "xRingbufferReceiveUpTo() Ring buffer data read timeout - Attempted to read %u bytes", bytesToTake);
@@ -555,30 +849,224 @@ static esp_err_t take_from_ringbuffer_and_write_to_i2s(size_t maxBytesToTakeFrom
     return err;
 }
 
-static void apply_volume(void* data, size_t len, uint8_t bytePerSample) {
-    const uint8_t volume_avrc = get_volume_avrc();
-    const float volume_factor = get_volume_factor();
+static esp_err_t mix_local_sounds_and_write_to_i2s() {
+    // A2DP is not streaming - Keep the I2S channel in the A2DP (or fixed) format so local sounds never reconfigure it
+    i2s_output_format_t a2dpFormat;
+    i2s_output_format_t outputFormat;
+    get_i2s_output_formats(&a2dpFormat, &outputFormat);
+    ESP_RETURN_ON_ERROR(apply_i2s_output_format(&outputFormat), BtI2sOutputTag, "apply_i2s_output_format() failed");
+
+    // Mix effect voices into one I2S write worth of silence
+    const uint8_t channelCount = (uint8_t) s_i2s_current_format.slotMode;
+    const size_t bytesPerFrame = s_bytes_per_sample_per_channel * channelCount;
+    const uint32_t frameCount = s_bytes_to_take_from_ringbuffer / bytesPerFrame;
+    mix_audio_block(&s_audio_mixer, (int16_t*) s_i2s_audio_processing_buffer, frameCount, channelCount, s_i2s_current_format.sampleRate, false, get_master_gain());
+
+    esp_err_t err = write_audio_block_to_i2s((const int16_t*) s_i2s_audio_processing_buffer, frameCount);
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SILENCE_GATING
+    // Silent sounds are not written while the output is gated - Pace the mixer as I2S would
+    if ((err == ESP_OK) && s_i2s_output_gated) {
+        vTaskDelay(pdMS_TO_TICKS((frameCount * 1000) / s_i2s_current_format.sampleRate) + 1);
+    }
+#endif
+
+    return err;
+}
 
-    // TODO: We currently only support I2S_DATA_BIT_WIDTH_16BIT or 2 bytes per channel
-    uint16_t* incomingData = (uint16_t*) data;
+static esp_err_t write_audio_block_to_i2s(const int16_t* samples, uint32_t frameCount) {
+    const uint8_t channelCount = (uint8_t) s_i2s_current_format.slotMode;
+    const size_t bytesToWrite = frameCount * channelCount * s_bytes_per_sample_per_channel;
 
-    // Optimization: When volume is 0, we can just zero the buffer otherwise apply the desired factor to each sample
-    if (volume_avrc == 0) {
-        memset(data, 0, len);
-    } else {
-        for (size_t dataIndex = 0; dataIndex < len / bytePerSample; dataIndex++) {
-            int32_t pcmDataWithVolume = (int32_t) lroundf((int16_t) incomingData[dataIndex] * volume_factor);
-            
-            // Clamp the result to [INT16_MIN, INT16_MAX] so we do not exceed the valid PCM range
-            if (pcmDataWithVolume > INT16_MAX) {
-                pcmDataWithVolume = INT16_MAX;
-            } else if (pcmDataWithVolume < INT16_MIN) {
-                pcmDataWithVolume = INT16_MIN;
+#if CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
+    // Analyze what is about to be heard - Tagged with the time it reaches the DAC so readers can line up with what is heard
+    analyze_audio_block(samples, frameCount, channelCount, s_i2s_current_format.sampleRate, predict_i2s_playout_time());
+#endif
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SILENCE_GATING
+    // Gate the output once silence lasted for the hold time - Resume as soon as a block carries signal
+    if (is_audio_block_silent(samples, frameCount * channelCount)) {
+        if (!s_i2s_output_gated) {
+            s_silent_frame_count += frameCount;
+            const uint32_t holdFrameCount = (CONFIG_HOLIDAYTREE_AUDIO_SILENCE_HOLD_MS * s_i2s_current_format.sampleRate) / 1000;
+            if (s_silent_frame_count >= holdFrameCount) {
+                ESP_RETURN_ON_ERROR(gate_i2s_output(), BtI2sOutputTag, "gate_i2s_output() failed");
             }
+        }
+
+        if (s_i2s_output_gated) {
+            return ESP_OK;
+        }
+    } else {
+        s_silent_frame_count = 0;
+        if (s_i2s_output_gated) {
+            ESP_RETURN_ON_ERROR(ungate_i2s_output(), BtI2sOutputTag, "ungate_i2s_output() failed");
+        }
+    }
+#endif
+
+    // The output was gated while no source was connected - Restart it for the first block that plays
+    if (s_i2s_output_gated) {
+        ESP_RETURN_ON_ERROR(ungate_i2s_output(), BtI2sOutputTag, "ungate_i2s_output() failed");
+    }
+
+    size_t bytesWritten = 0;
+    esp_err_t err = i2s_channel_write(s_i2s_tx_channel, (void*) samples, bytesToWrite, &bytesWritten, portMAX_DELAY);
+    if (err != ESP_OK) {
+        ESP_LOGE(BtI2sOutputTag, "i2s_channel_write() failed with %d - Attempted to write %u bytes", err, bytesToWrite);
+    }
+
+#if CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
+    s_i2s_written_bytes += bytesWritten;
+#endif
+
+    return err;
+}
+
+#if CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
+
+static IRAM_ATTR bool on_i2s_dma_buffer_sent(i2s_chan_handle_t handle, i2s_event_data_t* event, void* userContext) {
+    // A DMA buffer has been shifted out - Readers retry while the sequence is odd or changed under them
+    const uint32_t sequence = atomic_load_explicit(&s_atomic_dma_progress_sequence, memory_order_relaxed);
+    atomic_store_explicit(&s_atomic_dma_progress_sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    s_i2s_dma_progress.sentBytes += event->size;
+    s_i2s_dma_progress.sentTimeUs = esp_timer_get_time();
+
+    atomic_store_explicit(&s_atomic_dma_progress_sequence, sequence + 2, memory_order_release);
+    return false;
+}
+
+static void get_i2s_dma_progress(i2s_dma_progress_t* progress) {
+    // The interrupt updates two words - Retrying is bounded by how often a DMA buffer completes
+    uint32_t sequence = 0;
+    do {
+        sequence = atomic_load_explicit(&s_atomic_dma_progress_sequence, memory_order_acquire);
+        *progress = s_i2s_dma_progress;
+        atomic_thread_fence(memory_order_acquire);
+    } while (((sequence & 1) != 0) || (atomic_load_explicit(&s_atomic_dma_progress_sequence, memory_order_relaxed) != sequence));
+}
+
+static void reset_i2s_playout_prediction() {
+    i2s_dma_progress_t progress;
+    get_i2s_dma_progress(&progress);
+    s_i2s_written_bytes = progress.sentBytes;
+}
+
+static int64_t predict_i2s_playout_time() {
+    i2s_dma_progress_t progress;
+    get_i2s_dma_progress(&progress);
 
-            incomingData[dataIndex] = (uint16_t) pcmDataWithVolume;
+    const int64_t nowUs = esp_timer_get_time();
+    const uint32_t bytesPerSecond = s_i2s_current_format.sampleRate * (uint32_t) s_i2s_current_format.slotMode * s_bytes_per_sample_per_channel;
+    if (bytesPerSecond == 0) {
+        return nowUs;
+    }
+
+    // The next byte written plays once every byte queued ahead of it has been shifted out
+    const int32_t queuedBytes = (int32_t) (s_i2s_written_bytes - progress.sentBytes);
+    const int64_t staleAfterUs = (2 * (int64_t) s_i2s_dma_frame_count * 1000000) / s_i2s_current_format.sampleRate;
+    if ((queuedBytes < 0) || (nowUs - progress.sentTimeUs > staleAfterUs)) {
+        // DMA ran out of audio and sent cleared buffers, or the channel is stopped - The next block plays about now
+        s_i2s_written_bytes = progress.sentBytes;
+        return nowUs;
+    }
+
+    return progress.sentTimeUs + ((int64_t) queuedBytes * 1000000) / bytesPerSecond;
+}
+
+#endif
+
+static esp_err_t gate_i2s_output() {
+    if (s_i2s_output_gated) {
+        return ESP_OK;
+    }
+
+#if CONFIG_HOLIDAYTREE_I2S_OUTPUT_LOG
+    ESP_LOGI(BtI2sOutputTag, "gate_i2s_output() - Amplifier off and I2S DMA stopped");
+#endif
+
+    // Amplifier first so it does not amplify the channel stopping
+    if (AmpEnablePin != GPIO_NUM_NC) {
+        ESP_RETURN_ON_ERROR(gpio_set_level(AmpEnablePin, 0), BtI2sOutputTag, "gpio_set_level(%d) failed", AmpEnablePin);
+    }
+    ESP_RETURN_ON_ERROR(i2s_channel_disable(s_i2s_tx_channel), BtI2sOutputTag, "i2s_channel_disable() failed");
+
+#if CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
+    // Levels drop to zero while nothing plays
+    reset_audio_analysis();
+#endif
+
+    s_i2s_output_gated = true;
+    return ESP_OK;
+}
+
+static esp_err_t ungate_i2s_output() {
+#if CONFIG_HOLIDAYTREE_I2S_OUTPUT_LOG
+    ESP_LOGI(BtI2sOutputTag, "ungate_i2s_output() - I2S DMA started and amplifier on");
+#endif
+
+    ESP_RETURN_ON_ERROR(i2s_channel_enable(s_i2s_tx_channel), BtI2sOutputTag, "i2s_channel_enable() failed");
+    if (AmpEnablePin != GPIO_NUM_NC) {
+        ESP_RETURN_ON_ERROR(gpio_set_level(AmpEnablePin, 1), BtI2sOutputTag, "gpio_set_level(%d) failed", AmpEnablePin);
+    }
+
+    s_i2s_output_gated = false;
+#if CONFIG_HOLIDAYTREE_AUDIO_SILENCE_GATING
+    s_silent_frame_count = 0;
+#endif
+    return ESP_OK;
+}
+
+#if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+
+static uint32_t prepare_a2dp_resampler(const i2s_output_format_t* const a2dpFormat) {
+    const uint8_t a2dpChannelCount = (uint8_t) a2dpFormat->slotMode;
+    if ((s_a2dp_resampler.inputRate != a2dpFormat->sampleRate) || (s_a2dp_resampler.outputRate != s_i2s_current_format.sampleRate) || (s_a2dp_resampler.channelCount != a2dpChannelCount)) {
+#if CONFIG_HOLIDAYTREE_I2S_OUTPUT_LOG
+        ESP_LOGI(BtI2sOutputTag, "prepare_a2dp_resampler() - %lu Hz -> %lu Hz - %d channel(s)", a2dpFormat->sampleRate, s_i2s_current_format.sampleRate, a2dpChannelCount);
+#endif
+        audio_resampler_init(&s_a2dp_resampler, a2dpFormat->sampleRate, s_i2s_current_format.sampleRate, a2dpChannelCount);
+    }
+
+    // Maximum number of A2DP frames whose conversion fits in the resampled buffer - Leaves room for rounding
+    return (uint32_t) (((uint64_t) (s_i2s_resampled_buffer_frames - 2) * a2dpFormat->sampleRate) / s_i2s_current_format.sampleRate);
+}
+
+static uint32_t resample_a2dp_audio(const int16_t* samples, uint32_t frameCount) {
+    const uint8_t a2dpChannelCount = s_a2dp_resampler.channelCount;
+
+    // Same rate - Copy (the resampler filter would only add latency and roll off the top octave)
+    uint32_t framesProduced = 0;
+    if (s_a2dp_resampler.inputRate == s_a2dp_resampler.outputRate) {
+        framesProduced = frameCount > s_i2s_resampled_buffer_frames ? s_i2s_resampled_buffer_frames : frameCount;
+        memcpy(s_i2s_resampled_buffer, samples, framesProduced * a2dpChannelCount * sizeof(int16_t));
+    } else {
+        framesProduced = resample_audio(&s_a2dp_resampler, samples, frameCount, NULL, s_i2s_resampled_buffer, s_i2s_resampled_buffer_frames);
+    }
+
+    // Mono A2DP audio - Expand to stereo back to front so each sample is read before its slot is overwritten
+    if (a2dpChannelCount == 1) {
+        for (uint32_t frameIndex = framesProduced; frameIndex > 0; frameIndex--) {
+            const int16_t sample = s_i2s_resampled_buffer[frameIndex - 1];
+            s_i2s_resampled_buffer[2 * (frameIndex - 1)] = sample;
+            s_i2s_resampled_buffer[2 * (frameIndex - 1) + 1] = sample;
         }
     }
+
+    return framesProduced;
+}
+
+#endif
+
+static uint32_t get_master_gain() {
+    // AVRC volume as a Q15 mixer gain - Volume 0 mutes the output
+    if (get_volume_avrc() == 0) {
+        return 0;
+    }
+
+    return (uint32_t) lroundf(get_volume_factor() * AudioMixerUnityGain);
 }
 
 static void drain_ringbuffer() {
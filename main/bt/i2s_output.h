@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <stdbool.h>
+
 #include <esp_err.h>
 #include <esp_a2dp_api.h>
 #include <driver/i2s_std.h>
@@ -16,4 +18,11 @@ esp_err_t delete_i2s_output();
 esp_err_t configure_i2s_output(uint32_t sampleRate, i2s_data_bit_width_t dataWidth, i2s_slot_mode_t slotMode);
 uint32_t write_to_i2s_output(const uint8_t* data, uint32_t size);
 
-esp_err_t set_i2s_output_audio_state(esp_a2d_audio_state_t audioState);
\ No newline at end of file
+esp_err_t play_i2s_output_sound(uint32_t soundIndex);
+bool is_i2s_output_playing();
+
+uint32_t get_i2s_output_ringbuffer_fill();
+uint32_t get_i2s_output_ringbuffer_size();
+
+esp_err_t set_i2s_output_audio_state(esp_a2d_audio_state_t audioState);
+esp_err_t set_i2s_output_source_connected(bool connected);
\ No newline at end of file
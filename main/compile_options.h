@@ -14,6 +14,60 @@ const char* CompileTimeOptions =
     #if CONFIG_HOLIDAYTREE_DETAILED_I2S_DATA_PROCESSING_LOG
         "|I2S LOGS"
     #endif
+    #if CONFIG_HOLIDAYTREE_I2S_FIXED_OUTPUT_RATE
+        "|I2S FIXED RATE"
+    #endif
+    #if CONFIG_HOLIDAYTREE_AUDIO_SILENCE_GATING
+        "|SILENCE GATING"
+    #endif
+    #if CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS
+        "|AUDIO ANALYSIS"
+    #endif
+    #if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+        "|AUDIO SPECTRUM"
+    #endif
+    #if CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION
+        "|BEAT DETECTION"
+    #endif
+    #if CONFIG_HOLIDAYTREE_LEDS_BACKEND_RMT
+        "|LEDS RMT"
+    #endif
+    #if CONFIG_HOLIDAYTREE_LEDS_ASYNC_TRANSMISSION
+        "|LEDS ASYNC"
+    #endif
+    #if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+        "|LEDS COLOR CORRECTION"
+    #endif
+    #if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+        "|LEDS DITHERING"
+    #endif
+    #if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+        "|LEDS POWER LIMIT"
+    #endif
+    #if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+        "|LEDS TRANSITIONS"
+    #endif
+    #if CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR
+        "|LEDS COMPOSITOR"
+    #endif
+    #if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+        "|LEDS SHOWS"
+    #endif
+    #if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+        "|LEDS PROGRAMS"
+    #endif
+    #if CONFIG_HOLIDAYTREE_CONSOLE
+        "|CONSOLE"
+    #endif
+    #if CONFIG_HOLIDAYTREE_A2DP_TRACE_CAPTURE
+        "|A2DP TRACE"
+    #endif
+    #if CONFIG_HOLIDAYTREE_AUDIO_BENCHMARK
+        "|AUDIO BENCHMARK"
+    #endif
+    #if CONFIG_HOLIDAYTREE_LEDS_BENCHMARK
+        "|LEDS BENCHMARK"
+    #endif
     "|BR_EDR_DEVICE_NAME_STR:" CONFIG_HOLIDAYTREE_BR_EDR_DEVICE_NAME_STR ""
 
     #if CONFIG_HOLIDAYTREE_BR_EDR_LEGACY_PAIRING_REQUIRE_STATIC_PIN
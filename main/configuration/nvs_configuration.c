@@ -40,3 +40,16 @@ esp_err_t nvs_set_configuration(const char namespace[NVS_NS_NAME_MAX_SIZE], cons
     
     return err;
 }
+
+esp_err_t nvs_erase_configuration(const char namespace[NVS_NS_NAME_MAX_SIZE], const char key[NVS_KEY_NAME_MAX_SIZE]) {
+    nvs_handle_t nvsHandle = 0;
+
+    ESP_RETURN_ON_ERROR(nvs_open(namespace, NVS_READWRITE, &nvsHandle), NvsLogTag, "nvs_erase_configuration() failed");
+    esp_err_t err = nvs_erase_key(nvsHandle, key);
+    if (err == ESP_OK) {
+        err = nvs_commit(nvsHandle);
+    }
+    nvs_close(nvsHandle);
+
+    return err;
+}
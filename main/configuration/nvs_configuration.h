@@ -12,3 +12,4 @@
 
 esp_err_t nvs_get_configuration(const char namespace[NVS_NS_NAME_MAX_SIZE], const char key[NVS_KEY_NAME_MAX_SIZE], void* data, size_t* dataSize);
 esp_err_t nvs_set_configuration(const char namespace[NVS_NS_NAME_MAX_SIZE], const char key[NVS_KEY_NAME_MAX_SIZE], const void* const data, const size_t dataSize);
+esp_err_t nvs_erase_configuration(const char namespace[NVS_NS_NAME_MAX_SIZE], const char key[NVS_KEY_NAME_MAX_SIZE]);
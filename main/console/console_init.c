@@ -0,0 +1,36 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_console.h>
+
+
+#include "console/console_init.h"
+
+
+// Console log tag
+static const char* ConsoleTag = "console";
+
+
+// Console REPL - Commands can be registered between configure_console() and start_console()
+static esp_console_repl_t* s_console_repl = NULL;
+
+
+esp_err_t configure_console() {
+    esp_console_repl_config_t replConfig = ESP_CONSOLE_REPL_CONFIG_DEFAULT();
+    replConfig.prompt = "tree>";
+    replConfig.max_cmdline_length = 128;
+
+    esp_console_dev_uart_config_t uartConfig = ESP_CONSOLE_DEV_UART_CONFIG_DEFAULT();
+    ESP_RETURN_ON_ERROR(esp_console_new_repl_uart(&uartConfig, &replConfig, &s_console_repl), ConsoleTag, "esp_console_new_repl_uart() failed");
+    ESP_RETURN_ON_ERROR(esp_console_register_help_command(), ConsoleTag, "esp_console_register_help_command() failed");
+    return ESP_OK;
+}
+
+esp_err_t start_console() {
+    ESP_RETURN_ON_FALSE(s_console_repl != NULL, ESP_ERR_INVALID_STATE, ConsoleTag, "start_console() - configure_console() must be called first");
+    ESP_RETURN_ON_ERROR(esp_console_start_repl(s_console_repl), ConsoleTag, "esp_console_start_repl() failed");
+    return ESP_OK;
+}
@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <esp_err.h>
+
+
+esp_err_t configure_console();
+esp_err_t start_console();
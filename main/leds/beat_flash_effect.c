@@ -0,0 +1,89 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdbool.h>
+
+#include "leds/led_effect.h"
+#include "leds/beat_flash_effect.h"
+
+#include "audio/audio_beat.h"
+
+
+#if CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION
+
+typedef struct {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+} beat_flash_color_t;
+
+// Each beat flashes the next color
+static const beat_flash_color_t BeatFlashColors[] = {
+    { .red = 255, .green = 255, .blue = 255 },
+    { .red = 255, .green = 0, .blue = 0 },
+    { .red = 0, .green = 255, .blue = 0 },
+    { .red = 255, .green = 160, .blue = 0 }
+};
+
+
+// The flash fades by a quarter every FadeStepUs - Out in about 300ms
+static const int64_t FadeStepUs = 20000;
+
+
+typedef struct {
+    uint32_t lastBeatCount;
+    uint32_t lastOnsetCount;
+    uint32_t colorIndex;
+    int64_t flashTimeUs;
+    bool flashed;
+} beat_flash_state_t;
+
+_Static_assert(sizeof(beat_flash_state_t) <= LED_EFFECT_STATE_MAX_SIZE, "Beat flash state does not fit LED_EFFECT_STATE_MAX_SIZE");
+
+
+static void step_beat_flash_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+
+
+const led_effect_t BeatFlashLedEffect = {
+    .name = "beat_flash",
+    .stateSize = sizeof(beat_flash_state_t),
+    .step = &step_beat_flash_effect
+};
+
+
+static void step_beat_flash_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    beat_flash_state_t* flashState = (beat_flash_state_t*) state;
+
+    // Beats are published ahead of time - Pick the state of the audio heard when the frame is shown
+    audio_beat_snapshot_t beat;
+    const bool beatValid = get_audio_beat_snapshot_at(now->presentationTimeUs, &beat);
+    if (now->frameIndex == 0) {
+        flashState->lastBeatCount = beat.beatCount;
+        flashState->lastOnsetCount = beat.onsetCount;
+    } else if (beatValid) {
+        // Follow the tempo tracker once it is locked and raw onsets until then
+        const bool flash = beat.bpm != 0 ? beat.beatCount != flashState->lastBeatCount : beat.onsetCount != flashState->lastOnsetCount;
+        if (flash) {
+            flashState->flashed = true;
+            flashState->flashTimeUs = now->timeUs;
+            flashState->colorIndex = (flashState->colorIndex + 1) % (sizeof(BeatFlashColors) / sizeof(BeatFlashColors[0]));
+        }
+        flashState->lastBeatCount = beat.beatCount;
+        flashState->lastOnsetCount = beat.onsetCount;
+    }
+
+    // Brightness only depends on the time since the flash, not on the frame rate
+    uint32_t brightness = 0;
+    if (flashState->flashed) {
+        brightness = 255;
+        for (int64_t elapsedUs = now->timeUs - flashState->flashTimeUs; (elapsedUs >= FadeStepUs) && (brightness > 0); elapsedUs -= FadeStepUs) {
+            brightness = (brightness * 3) / 4;
+        }
+    }
+
+    const beat_flash_color_t* color = &BeatFlashColors[flashState->colorIndex];
+    fill_led_framebuffer(framebuffer, (color->red * brightness) / 255, (color->green * brightness) / 255, (color->blue * brightness) / 255);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "leds/led_effect.h"
+
+
+// The whole string flashes on every beat, or every onset until the tempo is locked, then fades out
+extern const led_effect_t BeatFlashLedEffect;
\ No newline at end of file
@@ -0,0 +1,79 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include "leds/led_effect.h"
+#include "leds/led_math.h"
+#include "leds/candle_effect.h"
+
+
+// Flames burn at BaseLevel and wander by up to FlickerDepth, FlickerCellsPerSecond noise cells a second
+static const int32_t BaseLevel = 190;
+static const int32_t FlickerDepth = 64;
+static const int64_t FlickerCellsPerSecond = 3;
+
+// Noise distance between two flames, in noise coordinates - Not a multiple of a cell so neighbours look unrelated
+static const int32_t FlameSpacing = 1237;
+
+// Gusts dim every flame with a faster flicker for GustDurationUs, fading out - One every 3 to 11 seconds
+static const int64_t GustDurationUs = 600000;
+static const int32_t GustDepth = 120;
+static const int64_t GustFlickerCellsPerSecond = 12;
+static const uint32_t MinimumGustIntervalMs = 3000;
+static const uint32_t GustIntervalRangeMs = 8000;
+
+static const int32_t MinimumLevel = 16;
+
+
+typedef struct {
+    uint32_t random;
+    int64_t gustStartUs;
+    int64_t nextGustUs;
+} candle_state_t;
+
+_Static_assert(sizeof(candle_state_t) <= LED_EFFECT_STATE_MAX_SIZE, "Candle state does not fit LED_EFFECT_STATE_MAX_SIZE");
+
+
+static void step_candle_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+
+
+const led_effect_t CandleLedEffect = {
+    .name = "candle",
+    .stateSize = sizeof(candle_state_t),
+    .step = &step_candle_effect
+};
+
+
+static void step_candle_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    candle_state_t* candle = (candle_state_t*) state;
+    if (now->frameIndex == 0) {
+        seed_led_random(&candle->random, (uint32_t) now->presentationTimeUs);
+        candle->gustStartUs = -GustDurationUs;
+        candle->nextGustUs = now->timeUs + (int64_t) (MinimumGustIntervalMs + next_led_random_below(&candle->random, GustIntervalRangeMs)) * 1000;
+    }
+    if (now->timeUs >= candle->nextGustUs) {
+        candle->gustStartUs = now->timeUs;
+        candle->nextGustUs = now->timeUs + (int64_t) (MinimumGustIntervalMs + next_led_random_below(&candle->random, GustIntervalRangeMs)) * 1000;
+    }
+
+    // Noise time coordinates - Slow for the flicker, fast for gusts. 3D noise wrapped at its period so time never jumps
+    const int32_t flickerTime = (int32_t) (((now->timeUs * FlickerCellsPerSecond * LED_NOISE_CELL) / 1000000) % LED_NOISE_3D_PERIOD);
+    const int32_t gustTime = (int32_t) (((now->timeUs * GustFlickerCellsPerSecond * LED_NOISE_CELL) / 1000000) % LED_NOISE_3D_PERIOD);
+    const int64_t sinceGustUs = now->timeUs - candle->gustStartUs;
+    const int32_t gustStrength = sinceGustUs < GustDurationUs ? (int32_t) (((GustDurationUs - sinceGustUs) * GustDepth) / GustDurationUs) : 0;
+
+    uint8_t* pixel = framebuffer->pixels;
+    for (uint32_t index = 0; index < framebuffer->pixelCount; index++, pixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        const int32_t flame = (int32_t) index * FlameSpacing;
+        int32_t level = BaseLevel + ((led_noise_3d(flame, 0, flickerTime) * FlickerDepth) >> 15);
+        if (gustStrength > 0) {
+            level -= (gustStrength * (32768 + led_noise_3d(flame, 0, gustTime))) >> 16;
+        }
+        level = level < MinimumLevel ? MinimumLevel : (level > 255 ? 255 : level);
+
+        // Dimmer flames are redder
+        pixel[0] = (uint8_t) level;
+        pixel[1] = (uint8_t) ((level * level * 150) >> 16);
+        pixel[2] = (uint8_t) ((level * level * 30) >> 16);
+    }
+}
\ No newline at end of file
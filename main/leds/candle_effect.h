@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "leds/led_effect.h"
+
+
+// Every LED flickers like a candle flame, with gusts of draft now and then
+extern const led_effect_t CandleLedEffect;
\ No newline at end of file
@@ -0,0 +1,40 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include "leds/led_effect.h"
+#include "leds/led_geometry.h"
+#include "leds/led_math.h"
+#include "leds/color_wheel_effect.h"
+
+
+// One turn of the wheel - The hue also shifts by HueRisePerHeight 256th of a turn from the bottom to the top of the tree
+static const int64_t TurnPeriodUs = 8000000;
+static const uint32_t HueRisePerHeight = 128;
+
+
+static void step_color_wheel_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+
+
+// Stateless - Every frame only depends on the time
+const led_effect_t ColorWheelLedEffect = {
+    .name = "color_wheel",
+    .stateSize = 0,
+    .step = &step_color_wheel_effect
+};
+
+
+static void step_color_wheel_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    const led_position_t* positions = get_led_positions(framebuffer->pixelCount);
+    const uint32_t ledCount = framebuffer->pixelCount;
+    const uint32_t turn = (uint32_t) (((now->timeUs % TurnPeriodUs) * 256) / TurnPeriodUs);
+
+    uint8_t* pixel = framebuffer->pixels;
+    for (uint32_t index = 0; index < ledCount; index++, pixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        // Without geometry the wheel runs along the string
+        const led_position_t position = get_led_position(positions, index, ledCount);
+        const uint32_t angle = positions != NULL ? position.angle : (index * 256) / ledCount;
+        const uint8_t hue = (uint8_t) (turn + angle + ((position.height * HueRisePerHeight) >> 8));
+        get_led_hue_color(hue, 255, &pixel[0], &pixel[1], &pixel[2]);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "leds/led_effect.h"
+
+
+// A rainbow turns around the tree and climbs it, one turn every eight seconds
+extern const led_effect_t ColorWheelLedEffect;
\ No newline at end of file
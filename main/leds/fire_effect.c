@@ -0,0 +1,114 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include "leds/led_effect.h"
+#include "leds/led_geometry.h"
+#include "leds/led_math.h"
+#include "leds/fire_effect.h"
+
+
+// Heat cells up each side of the tree - Sides are quarters of a turn around the trunk
+#define FIRE_COLUMN_COUNT 4
+#define FIRE_CELL_COUNT 16
+
+// The simulation runs at a fixed rate whatever the frame rate - Steps are dropped beyond MaximumTicksPerStep
+static const int64_t TickPeriodUs = 16667;
+static const uint32_t MaximumTicksPerStep = 4;
+
+// Heat lost per tick, up to, and odds in 256 of a new spark at the bottom per tick
+static const uint32_t MaximumCooling = 55 * 10 / FIRE_CELL_COUNT + 2;
+static const uint32_t SparkingOdds = 120;
+
+
+typedef struct {
+    uint32_t random;
+    int64_t tickTimeUs;         // Effect time simulated so far
+    uint8_t heat[FIRE_COLUMN_COUNT][FIRE_CELL_COUNT];
+} fire_state_t;
+
+_Static_assert(sizeof(fire_state_t) <= LED_EFFECT_STATE_MAX_SIZE, "Fire state does not fit LED_EFFECT_STATE_MAX_SIZE");
+
+
+static void step_fire_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+static void tick_fire_column(uint8_t* heat, uint32_t* random);
+static void set_heat_color(uint32_t heat, uint8_t* pixel);
+
+
+const led_effect_t FireLedEffect = {
+    .name = "fire",
+    .stateSize = sizeof(fire_state_t),
+    .step = &step_fire_effect
+};
+
+
+static void step_fire_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    fire_state_t* fire = (fire_state_t*) state;
+    if (now->frameIndex == 0) {
+        seed_led_random(&fire->random, (uint32_t) now->presentationTimeUs);
+        fire->tickTimeUs = now->timeUs;
+    }
+
+    uint32_t ticks = 0;
+    for (; (fire->tickTimeUs + TickPeriodUs <= now->timeUs) && (ticks < MaximumTicksPerStep); fire->tickTimeUs += TickPeriodUs, ticks++) {
+        for (uint32_t column = 0; column < FIRE_COLUMN_COUNT; column++) {
+            tick_fire_column(fire->heat[column], &fire->random);
+        }
+    }
+    if (fire->tickTimeUs + TickPeriodUs <= now->timeUs) {
+        fire->tickTimeUs = now->timeUs;
+    }
+
+    // Heat at the height of each LED, interpolated between cells, on its side of the tree
+    const led_position_t* positions = get_led_positions(framebuffer->pixelCount);
+    const uint32_t ledCount = framebuffer->pixelCount;
+    uint8_t* pixel = framebuffer->pixels;
+    for (uint32_t index = 0; index < ledCount; index++, pixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        const led_position_t position = get_led_position(positions, index, ledCount);
+        const uint8_t* heat = fire->heat[(position.angle * FIRE_COLUMN_COUNT) >> 8];
+        const uint32_t cellPosition = position.height * (FIRE_CELL_COUNT - 1);
+        const uint32_t cell = cellPosition >> 8;
+        const uint32_t fraction = cellPosition & 0xFF;
+        const uint32_t level = cell + 1 < FIRE_CELL_COUNT ? (heat[cell] * (256 - fraction) + heat[cell + 1] * fraction) >> 8 : heat[cell];
+        set_heat_color(level, pixel);
+    }
+}
+
+static void tick_fire_column(uint8_t* heat, uint32_t* random) {
+    // Every cell cools a little
+    for (uint32_t cell = 0; cell < FIRE_CELL_COUNT; cell++) {
+        const uint32_t cooling = next_led_random_below(random, MaximumCooling);
+        heat[cell] = heat[cell] > cooling ? (uint8_t) (heat[cell] - cooling) : 0;
+    }
+
+    // Heat drifts up and diffuses
+    for (uint32_t cell = FIRE_CELL_COUNT - 1; cell >= 2; cell--) {
+        heat[cell] = (uint8_t) ((heat[cell - 1] + 2 * heat[cell - 2]) / 3);
+    }
+
+    // New sparks near the bottom
+    if (next_led_random_below(random, 256) < SparkingOdds) {
+        const uint32_t cell = next_led_random_below(random, 3);
+        const uint32_t spark = heat[cell] + 160 + next_led_random_below(random, 96);
+        heat[cell] = (uint8_t) (spark > 255 ? 255 : spark);
+    }
+}
+
+static void set_heat_color(uint32_t heat, uint8_t* pixel) {
+    // Black to red, red to yellow, yellow to white - Three ramps of 64 levels
+    const uint32_t scaled = (heat * 191) / 255;
+    const uint8_t ramp = (uint8_t) ((scaled & 0x3F) << 2);
+    if (scaled & 0x80) {
+        pixel[0] = 255;
+        pixel[1] = 255;
+        pixel[2] = ramp;
+    } else if (scaled & 0x40) {
+        pixel[0] = 255;
+        pixel[1] = ramp;
+        pixel[2] = 0;
+    } else {
+        pixel[0] = ramp;
+        pixel[1] = 0;
+        pixel[2] = 0;
+    }
+}
\ No newline at end of file
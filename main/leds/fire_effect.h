@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "leds/led_effect.h"
+
+
+// Flames rise up the tree - A heat simulation per side of the tree, mapped through a black body palette
+extern const led_effect_t FireLedEffect;
\ No newline at end of file
@@ -0,0 +1,39 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include "sdkconfig.h"
+
+#include "leds/led_compositor.h"
+#include "leds/progressive_reveal_effect.h"
+#include "leds/beat_flash_effect.h"
+#include "leds/layered_beat_flash_effect.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR && CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION
+
+// Flashes light the reveal up rather than cover it
+static const led_composition_t LayeredBeatFlashComposition = {
+    .layerCount = 2,
+    .layers = {
+        { .effect = &ProgressiveRevealLedEffect, .blend = LedLayerBlendNormal, .opacity = LED_LAYER_OPACITY_FULL, .updatePeriodUs = 100000 },
+        { .effect = &BeatFlashLedEffect, .blend = LedLayerBlendAdd, .opacity = 192, .updatePeriodUs = 0 }
+    }
+};
+
+
+static void step_layered_beat_flash_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+
+
+const led_effect_t LayeredBeatFlashLedEffect = {
+    .name = "layered_beat_flash",
+    .stateSize = sizeof(led_composition_state_t),
+    .step = &step_layered_beat_flash_effect
+};
+
+
+static void step_layered_beat_flash_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    step_led_composition(&LayeredBeatFlashComposition, (led_composition_state_t*) state, now, framebuffer);
+}
+
+#endif
\ No newline at end of file
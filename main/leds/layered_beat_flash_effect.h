@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "leds/led_effect.h"
+
+
+// Beat flashes added over the progressive reveal, which is only updated ten times a second
+extern const led_effect_t LayeredBeatFlashLedEffect;
\ No newline at end of file
@@ -7,10 +7,23 @@
 
 #include <esp_log.h>
 
+#include "leds/led_internals.h"
 #include "leds/led_effect.h"
+#include "leds/led_renderer.h"
 #include "leds/led_known_effects.h"
+#include "leds/led_animator.h"
 
 #include "leds/progressive_reveal_effect.h"
+#include "leds/beat_flash_effect.h"
+#include "leds/layered_beat_flash_effect.h"
+#include "leds/twinkle_effect.h"
+#include "leds/fire_effect.h"
+#include "leds/candle_effect.h"
+#include "leds/color_wheel_effect.h"
+#include "leds/snowfall_effect.h"
+#include "leds/shimmer_effect.h"
+#include "leds/show_player_effect.h"
+#include "leds/program_effect.h"
 
 
 static void animate_led_task(void* arg);
@@ -20,6 +33,9 @@ static esp_err_t turn_led_string_on_off(led_string_state_t on);
 // FreeRTOS task notification index for LED animation task notifications
 const UBaseType_t LedAnimationTaskNotificationIndex = 0;
 
+// FreeRTOS task notification index for LED frame deadlines - Needs CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES >= 2
+const UBaseType_t LedFrameClockNotificationIndex = 1;
+
 // LEDs animation task
 static TaskHandle_t s_animate_led_task_handle = NULL;
 
@@ -40,12 +56,20 @@ esp_err_t start_led_string_effect(led_known_effects_t ledEffect) {
     }
 
     BaseType_t outcome = xTaskNotifyIndexed(s_animate_led_task_handle, LedAnimationTaskNotificationIndex, ledEffect, eSetValueWithOverwrite);
+    if (outcome == pdPASS) {
+        // Wake a running effect waiting for its next frame
+        xTaskNotifyGiveIndexed(s_animate_led_task_handle, LedFrameClockNotificationIndex);
+    }
     return outcome == pdPASS ? ESP_OK : ESP_FAIL;
 }
 
 esp_err_t stop_led_string_effect() {
     if (s_animate_led_task_handle != NULL) {
         BaseType_t outcome = xTaskNotifyIndexed(s_animate_led_task_handle, LedAnimationTaskNotificationIndex, LedAnimationTaskNotificationPause, eSetValueWithOverwrite);
+        if (outcome == pdPASS) {
+            // Wake a running effect waiting for its next frame
+            xTaskNotifyGiveIndexed(s_animate_led_task_handle, LedFrameClockNotificationIndex);
+        }
         return outcome == pdPASS ? ESP_OK : ESP_FAIL;
     }
 
@@ -58,14 +82,14 @@ static esp_err_t turn_led_string_on_off(led_string_state_t on) {
             // Turn LEDs string on and clear all LEDs
             esp_err_t err = set_led_string_on_off(LedStringOn);
             if (err == ESP_OK) {
-                // This calls refresh_led_string()
+                // Powering the string makes its content unknown - This always sends a frame
                 return clear_led_string();
             }
         }
         break;
 
         case LedStringOff: {
-            // Clear all LEDs - This calls refresh_led_string()
+            // Clear all LEDs - Nothing is sent if the last frame was already black
             esp_err_t err = clear_led_string();
             if (err == ESP_OK) {
                 // Turn LEDs string off
@@ -104,6 +128,7 @@ led_animation_task_notification_t accept_task_notification_with_delay(uint32_t d
 
 static void animate_led_task(void* arg) {
     led_animation_task_notification_t notification = LedAnimationTaskNotificationPause;
+    bool ledStringOn = false;
     for (;;) {
         switch (notification) {
             case LedAnimationTaskNotificationPause:
@@ -124,31 +149,82 @@ static void animate_led_task(void* arg) {
 #endif
 
                     if (ledEffect < LedEffectMax) {
-                        turn_led_string_on_off(LedStringOn);
-                        switch (ledEffect) {
-                            case LedProgressiveRevealEffect:
-                                notification = progressive_reveal_led_effect();
-                            break;
-
-                            default:
-                                ESP_LOGW(LedStringTag, "animate_led_task() unable to start effect (%d) - Effect not implemented", ledEffect);
-                            break;
-                        }
+                        const led_effect_t* effect = get_known_led_effect(ledEffect);
+                        if (effect != NULL) {
+                            // An effect replacing one still on the string takes over through a transition
+                            const bool transition = ledStringOn;
+                            if (!ledStringOn) {
+                                turn_led_string_on_off(LedStringOn);
+                                ledStringOn = true;
+                            }
+                            notification = run_led_effect(effect, transition);
 
 #if CONFIG_HOLIDAYTREE_LEDS_LOG
-                        ESP_LOGI(LedStringTag, "animate_led_task() effect exited with notification (%u)", notification);
+                            ESP_LOGI(LedStringTag, "animate_led_task() effect exited with notification (%u)", notification);
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+                            // Straight into the next effect - The string stays on for the transition
+                            if (notification >= LedAnimationTaskNotificationEffectMin) {
+                                break;
+                            }
 #endif
-                        turn_led_string_on_off(LedStringOff);
+                        } else {
+                            ESP_LOGW(LedStringTag, "animate_led_task() unable to start effect (%d) - Effect not implemented", ledEffect);
+                            notification = LedAnimationTaskNotificationPause;
+                        }
                     } else {
                         ESP_LOGE(LedStringTag, "animate_led_task() unable to start effect (%d) - Unknown effect", ledEffect);
+                        notification = LedAnimationTaskNotificationPause;
                     }
                 }
+
+                if (ledStringOn) {
+                    turn_led_string_on_off(LedStringOff);
+                    ledStringOn = false;
+                }
             }
             break;
         }
     }
 }
 
+const led_effect_t* get_known_led_effect(led_known_effects_t ledEffect) {
+    switch (ledEffect) {
+        case LedProgressiveRevealEffect:
+            return &ProgressiveRevealLedEffect;
+#if CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION
+        case LedBeatFlashEffect:
+            return &BeatFlashLedEffect;
+#endif
+#if CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION && CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR
+        case LedLayeredBeatFlashEffect:
+            return &LayeredBeatFlashLedEffect;
+#endif
+        case LedTwinkleEffect:
+            return &TwinkleLedEffect;
+        case LedFireEffect:
+            return &FireLedEffect;
+        case LedCandleEffect:
+            return &CandleLedEffect;
+        case LedColorWheelEffect:
+            return &ColorWheelLedEffect;
+        case LedSnowfallEffect:
+            return &SnowfallLedEffect;
+        case LedShimmerEffect:
+            return &ShimmerLedEffect;
+#if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+        case LedShowPlayerEffect:
+            return &ShowPlayerLedEffect;
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+        case LedProgramEffect:
+            return &ProgramLedEffect;
+#endif
+        default:
+            return NULL;
+    }
+}
+
 #if CONFIG_HOLIDAYTREE_LEDS_LOG
 
 static const char* get_led_task_notification_name(led_animation_task_notification_t notification) {
@@ -166,6 +242,26 @@ static const char* get_led_effect_name(led_known_effects_t ledEffect) {
     switch (ledEffect) {
         case LedProgressiveRevealEffect:
             return "LedProgressiveRevealEffect";
+        case LedBeatFlashEffect:
+            return "LedBeatFlashEffect";
+        case LedLayeredBeatFlashEffect:
+            return "LedLayeredBeatFlashEffect";
+        case LedTwinkleEffect:
+            return "LedTwinkleEffect";
+        case LedFireEffect:
+            return "LedFireEffect";
+        case LedCandleEffect:
+            return "LedCandleEffect";
+        case LedColorWheelEffect:
+            return "LedColorWheelEffect";
+        case LedSnowfallEffect:
+            return "LedSnowfallEffect";
+        case LedShimmerEffect:
+            return "LedShimmerEffect";
+        case LedShowPlayerEffect:
+            return "LedShowPlayerEffect";
+        case LedProgramEffect:
+            return "LedProgramEffect";
         default:
             return "N/A";
     }
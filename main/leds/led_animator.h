@@ -6,7 +6,11 @@
 
 #include <esp_err.h>
 
+#include "leds/led_effect.h"
 #include "leds/led_known_effects.h"
 
 esp_err_t start_led_string_effect(led_known_effects_t ledEffect);
-esp_err_t stop_led_string_effect();
\ No newline at end of file
+esp_err_t stop_led_string_effect();
+
+// Descriptor of a known effect - NULL when it is not built in
+const led_effect_t* get_known_led_effect(led_known_effects_t ledEffect);
\ No newline at end of file
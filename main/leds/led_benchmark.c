@@ -0,0 +1,816 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <esp_check.h>
+#include <esp_cpu.h>
+#include <esp_console.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+#include "leds/led_internals.h"
+#include "leds/led_color_correction.h"
+#include "leds/led_transition.h"
+#include "leds/led_compositor.h"
+#include "leds/led_math.h"
+#include "leds/led_show.h"
+#include "leds/led_program.h"
+#include "leds/led_animator.h"
+#include "leds/led_renderer.h"
+#include "leds/led_benchmark.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_BENCHMARK
+
+// Channels benchmark - Frames sent per mode
+static const uint32_t ChannelsBenchmarkIterations = 32;
+
+// String lengths the frame rate ceilings are estimated for, and the backends compared at by default
+static const uint32_t CeilingLedCounts[] = { 5, 50, 150, 300, 500 };
+
+// Backend benchmark - Refreshes per backend and string length, lengths given on the command line
+#define BACKEND_BENCHMARK_MAX_LED_COUNTS 8
+static const uint32_t BackendBenchmarkIterations = 32;
+static const uint32_t BackendBenchmarkMaximumLedCount = 1024;
+static const uint32_t BackendBenchmarkCalibrationUs = 20000;
+
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+// Transition benchmark - String lengths blended and frames per length
+static const uint32_t TransitionBenchmarkLedCounts[] = { 5, 50, 500 };
+static const uint32_t TransitionBenchmarkIterations = 256;
+#endif
+
+// Effects benchmark - Frames rendered per effect on a framebuffer of a long string whatever the string, calls per math primitive
+static const uint32_t EffectsBenchmarkLedCount = 300;
+static const uint32_t EffectsBenchmarkFrames = 64;
+static const uint32_t PrimitivesBenchmarkCalls = 1024;
+
+#if CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR
+// Layers benchmark - String lengths blended, frames per length and opacities of the layer (opaque then half transparent)
+static const uint32_t LayersBenchmarkLedCounts[] = { 5, 50, 500 };
+static const uint32_t LayersBenchmarkIterations = 256;
+static const uint32_t LayersBenchmarkOpacities[] = { LED_LAYER_OPACITY_FULL, LED_LAYER_OPACITY_FULL / 2 };
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+// Light shows benchmark - LEDs per synthetic keyframe and decodes per keyframe kind
+static const uint32_t ShowsBenchmarkLedCount = 500;
+static const uint32_t ShowsBenchmarkIterations = 256;
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+// Program benchmark - String lengths programs run for and frames per length
+static const uint32_t ProgramBenchmarkLedCounts[] = { 50, 150, 300, 500 };
+static const uint32_t ProgramBenchmarkFrames = 32;
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+// Color correction benchmark - String lengths measured and frames per length
+static const uint32_t ColorBenchmarkLedCounts[] = { 5, 50, 500 };
+static const uint32_t ColorBenchmarkIterations = 256;
+#endif
+
+
+static int run_frames_benchmark(bool reset);
+static int run_channels_benchmark();
+static int run_backend_benchmark(int argc, char** argv);
+static int run_backend_refreshes(led_string_backend_t backend, spi_host_device_t spiHost, uint32_t ledCount, uint32_t idleSpins);
+static uint32_t spin_until(int64_t endUs, esp_cpu_cycle_count_t* cycles);
+static uint32_t get_segment_wire_time_us(uint32_t ledCount);
+static int run_effects_benchmark();
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+static int run_transition_benchmark();
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR
+static int run_layers_benchmark();
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+static int run_shows_benchmark();
+static uint32_t build_show_benchmark_payload(uint32_t operation, uint32_t ledCount, uint8_t* payload);
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+static int run_program_benchmark();
+static void run_program_frames(const char* name, const led_program_t* program, led_framebuffer_t* framebuffer);
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+static int run_color_benchmark();
+#endif
+static int led_benchmark_console_command(int argc, char** argv);
+
+
+esp_err_t register_led_benchmark_console_command() {
+    const esp_console_cmd_t benchmarkCommand = {
+        .command = "led_bench",
+        .help = "Benchmark LED rendering - 'led_bench frames [reset]|channels|backend [ledCount...]|effects|transition|layers|shows|program|color'",
+        .hint = NULL,
+        .func = &led_benchmark_console_command
+    };
+
+    ESP_RETURN_ON_ERROR(esp_console_cmd_register(&benchmarkCommand), LedStringTag, "esp_console_cmd_register() failed");
+    return ESP_OK;
+}
+
+static int led_benchmark_console_command(int argc, char** argv) {
+    const char* const benchmarkName = argc > 1 ? argv[1] : "frames";
+
+    if (strcmp(benchmarkName, "frames") == 0) {
+        return run_frames_benchmark((argc > 2) && (strcmp(argv[2], "reset") == 0));
+    }
+
+    if (strcmp(benchmarkName, "channels") == 0) {
+        return run_channels_benchmark();
+    }
+
+    if (strcmp(benchmarkName, "backend") == 0) {
+        return run_backend_benchmark(argc - 2, &argv[2]);
+    }
+    if (strcmp(benchmarkName, "effects") == 0) {
+        return run_effects_benchmark();
+    }
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+    if (strcmp(benchmarkName, "transition") == 0) {
+        return run_transition_benchmark();
+    }
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR
+    if (strcmp(benchmarkName, "layers") == 0) {
+        return run_layers_benchmark();
+    }
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+    if (strcmp(benchmarkName, "shows") == 0) {
+        return run_shows_benchmark();
+    }
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+    if (strcmp(benchmarkName, "program") == 0) {
+        return run_program_benchmark();
+    }
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+    if (strcmp(benchmarkName, "color") == 0) {
+        return run_color_benchmark();
+    }
+#endif
+
+    printf("Unknown benchmark '%s'\n", benchmarkName);
+    return 1;
+}
+
+static int run_frames_benchmark(bool reset) {
+    // Measured by the renderer on live frames - Let an effect run for a few seconds after a reset
+    led_renderer_stats_t stats;
+    get_led_renderer_stats(&stats);
+    if (reset) {
+        reset_led_renderer_stats();
+    }
+
+    printf("%lu LEDs - Frame period %lu us (%lu frames/s)\n", stats.ledCount, stats.framePeriodUs, stats.framePeriodUs > 0 ? 1000000 / stats.framePeriodUs : 0);
+    if (stats.framesRendered == 0) {
+        printf("No frame rendered yet\n");
+        return 0;
+    }
+
+    // Transmission time is averaged over transmitted frames
+    const uint32_t averageRenderUs = (uint32_t) (stats.renderTimeUs / stats.framesRendered);
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+    // Every frame is dithered, sent or not
+    const uint32_t averageCorrectionUs = (uint32_t) (stats.correctionTimeUs / stats.framesRendered);
+    const uint32_t averagePowerUs = (uint32_t) (stats.powerTimeUs / stats.framesRendered);
+#else
+    const uint32_t averageCorrectionUs = stats.framesTransmitted > 0 ? (uint32_t) (stats.correctionTimeUs / stats.framesTransmitted) : 0;
+    const uint32_t averagePowerUs = stats.framesTransmitted > 0 ? (uint32_t) (stats.powerTimeUs / stats.framesTransmitted) : 0;
+#endif
+    const uint32_t averageWaitUs = stats.framesTransmitted > 0 ? (uint32_t) (stats.waitTimeUs / stats.framesTransmitted) : 0;
+    const uint32_t averageTransmitUs = stats.framesTransmitted > 0 ? (uint32_t) (stats.transmitTimeUs / stats.framesTransmitted) : 0;
+    const uint32_t averagePixelsUpdated = stats.framesTransmitted > 0 ? (uint32_t) (stats.pixelsUpdated / stats.framesTransmitted) : 0;
+    printf("Frames rendered %lu - Transmitted %lu (%lu%%) - Missed deadlines %lu\n", stats.framesRendered, stats.framesTransmitted, (uint32_t) ((stats.framesTransmitted * 100ULL) / stats.framesRendered), stats.framesMissed);
+    printf("Jitter   %6lu us average - %6lu us maximum\n", (uint32_t) (stats.jitterUs / stats.framesRendered), stats.maximumJitterUs);
+    printf("Render   %6lu us average - %6lu us maximum\n", averageRenderUs, stats.maximumRenderTimeUs);
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+    // Transition frames render both effects then blend them - Compared with frames rendering one effect
+    if (stats.transitionFrames > 0) {
+        const uint32_t singleEffectFrames = stats.framesRendered - stats.transitionFrames;
+        const uint32_t singleEffectRenderUs = singleEffectFrames > 0 ? (uint32_t) ((stats.renderTimeUs - stats.transitionRenderTimeUs) / singleEffectFrames) : 0;
+        printf("Transit. %6lu us average - %6lu us maximum - Blend %lu us - One effect %lu us - %lu frames, %lu holding the outgoing effect\n",
+            (uint32_t) (stats.transitionRenderTimeUs / stats.transitionFrames), stats.maximumTransitionRenderTimeUs, (uint32_t) (stats.blendTimeUs / stats.transitionFrames),
+            singleEffectRenderUs, stats.transitionFrames, stats.transitionFramesFrozen);
+    }
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+    printf("Color    %6lu us average - %6lu us maximum - Gamma %d.%02d, white balance %d/%d/%d\n", averageCorrectionUs, stats.maximumCorrectionTimeUs,
+        CONFIG_HOLIDAYTREE_LEDS_GAMMA / 100, CONFIG_HOLIDAYTREE_LEDS_GAMMA % 100, CONFIG_HOLIDAYTREE_LEDS_WHITE_BALANCE_RED, CONFIG_HOLIDAYTREE_LEDS_WHITE_BALANCE_GREEN, CONFIG_HOLIDAYTREE_LEDS_WHITE_BALANCE_BLUE);
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+    // The estimate reads the whole frame once - Next to the wire time it should stay in the noise
+    printf("Power    %6lu us average - %6lu us maximum - %lu%% of the wire time - Peak %lu mA of %d mA budget - %lu frames dimmed\n", averagePowerUs, stats.maximumPowerTimeUs,
+        (averagePowerUs * 100) / get_segment_wire_time_us(stats.ledCount), stats.maximumCurrentMa, CONFIG_HOLIDAYTREE_LEDS_POWER_BUDGET_MA, stats.framesLimited);
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_ASYNC_TRANSMISSION
+    printf("Wait     %6lu us average - Previous frame still on the wire\n", averageWaitUs);
+#endif
+    printf("Transmit %6lu us average - %6lu us maximum - %lu changed pixels average\n", averageTransmitUs, stats.maximumTransmitTimeUs, averagePixelsUpdated);
+
+    // Processor time of a frame which changes - A blocking send also holds the task for the wire time
+    const uint32_t wireTimeUs = get_segment_wire_time_us(stats.ledCount);
+#if CONFIG_HOLIDAYTREE_LEDS_ASYNC_TRANSMISSION
+    const uint32_t cpuCostUs = averageRenderUs + averageCorrectionUs + averagePowerUs + averageTransmitUs;
+#else
+    const uint32_t cpuCostUs = averageRenderUs + averageCorrectionUs + averagePowerUs + (averageTransmitUs > wireTimeUs ? averageTransmitUs - wireTimeUs : 0);
+#endif
+
+    // Every frame changing, rendered and sent back to back - Blocking sends add the wire time to the processor time,
+    // asynchronous sends overlap it with the next frame. Estimated for other lengths by scaling the processor time per LED
+#if CONFIG_HOLIDAYTREE_LEDS_ASYNC_TRANSMISSION
+    const char* const transmission = "overlapped";
+#else
+    const char* const transmission = "blocking";
+#endif
+    printf("Ceiling  frames/s with blocking / overlapped transmission (%s here) - Processor time scaled per LED from this string\n", transmission);
+    for (uint32_t countIndex = 0; countIndex < sizeof(CeilingLedCounts) / sizeof(CeilingLedCounts[0]); countIndex++) {
+        const uint32_t ledCount = CeilingLedCounts[countIndex];
+        const uint32_t ledCpuCostUs = (uint32_t) (((uint64_t) cpuCostUs * ledCount) / stats.ledCount);
+        const uint32_t ledWireTimeUs = get_segment_wire_time_us(ledCount);
+        printf("%8lu LEDs %6lu / %6lu - Wire limit %6lu\n", ledCount, 1000000 / (ledCpuCostUs + ledWireTimeUs),
+            1000000 / (ledCpuCostUs > ledWireTimeUs ? ledCpuCostUs : ledWireTimeUs), 1000000 / ledWireTimeUs);
+    }
+    printf("This string   %6lu / %6lu - Wire limit %6lu\n", 1000000 / (cpuCostUs + wireTimeUs), 1000000 / (cpuCostUs > wireTimeUs ? cpuCostUs : wireTimeUs), 1000000 / wireTimeUs);
+
+    // Worst frames against the frame period - A frame over budget makes the next deadline a missed one
+    const uint32_t frameCostUs = averageRenderUs + averageCorrectionUs + averagePowerUs + averageWaitUs + averageTransmitUs;
+    const uint32_t worstFrameCostUs = stats.maximumRenderTimeUs + stats.maximumCorrectionTimeUs + stats.maximumPowerTimeUs + stats.maximumTransmitTimeUs;
+    printf("Budget   %6lu us average, %6lu us worst of %6lu us (%lu%% worst) - %s\n", frameCostUs, worstFrameCostUs, stats.framePeriodUs,
+        (worstFrameCostUs * 100) / stats.framePeriodUs, worstFrameCostUs <= stats.framePeriodUs ? "within budget" : "OVER BUDGET");
+
+    return 0;
+}
+
+static int run_channels_benchmark() {
+    const uint32_t channelCount = get_led_string_channel_count();
+    led_renderer_stats_t stats;
+    get_led_renderer_stats(&stats);
+    printf("%lu LEDs on %lu channels - Sending the current frame %lu times\n", stats.ledCount, channelCount, ChannelsBenchmarkIterations);
+
+    // The running effect waits while the string is busy - Sending the content it shows does not change what is seen
+    uint32_t frameUs[2] = { 0 };
+    for (uint32_t mode = 0; mode < 2; mode++) {
+        const int64_t startUs = esp_timer_get_time();
+        for (uint32_t iteration = 0; iteration < ChannelsBenchmarkIterations; iteration++) {
+            esp_err_t err = resend_led_string(mode == 1);
+            if (err != ESP_OK) {
+                printf("resend_led_string() failed (%d)\n", err);
+                return 1;
+            }
+        }
+        frameUs[mode] = (uint32_t) ((esp_timer_get_time() - startUs) / ChannelsBenchmarkIterations);
+    }
+
+    // One channel after the other costs what a single channel driving the whole string does, plus one transfer set up per channel
+    printf("%lu channels at once   %6lu us/frame - %5lu frames/s - Wire time %6lu us\n", channelCount, frameUs[0], frameUs[0] > 0 ? 1000000 / frameUs[0] : 0, get_segment_wire_time_us(stats.ledCount));
+    printf("1 channel at a time    %6lu us/frame - %5lu frames/s - Wire time %6lu us\n", frameUs[1], frameUs[1] > 0 ? 1000000 / frameUs[1] : 0, get_led_string_wire_time_us(stats.ledCount));
+    printf("Speed up %lu.%02lu\n", frameUs[0] > 0 ? frameUs[1] / frameUs[0] : 0, frameUs[0] > 0 ? ((frameUs[1] % frameUs[0]) * 100) / frameUs[0] : 0);
+
+    return 0;
+}
+
+static int run_backend_benchmark(int argc, char** argv) {
+    uint32_t ledCounts[BACKEND_BENCHMARK_MAX_LED_COUNTS];
+    uint32_t countCount = 0;
+    for (int argIndex = 0; (argIndex < argc) && (countCount < BACKEND_BENCHMARK_MAX_LED_COUNTS); argIndex++) {
+        const unsigned long ledCount = strtoul(argv[argIndex], NULL, 10);
+        if ((ledCount == 0) || (ledCount > BackendBenchmarkMaximumLedCount)) {
+            printf("LED counts range from 1 to %lu\n", BackendBenchmarkMaximumLedCount);
+            return 1;
+        }
+        ledCounts[countCount++] = (uint32_t) ledCount;
+    }
+    if (countCount == 0) {
+        countCount = sizeof(CeilingLedCounts) / sizeof(CeilingLedCounts[0]);
+        memcpy(ledCounts, CeilingLedCounts, sizeof(CeilingLedCounts));
+    }
+
+    // The benchmark devices use an SPI host the LED string leaves free - None when the string takes both
+#if CONFIG_HOLIDAYTREE_LEDS_BACKEND_RMT
+    const spi_host_device_t spiHost = SPI2_HOST;
+    const bool spiAvailable = true;
+#else
+    const spi_host_device_t spiHost = SPI3_HOST;
+    const bool spiAvailable = get_led_string_channel_count() < 2;
+#endif
+
+    // Passes of the spin loop with nothing transmitting - Interrupts serving a transmission lower it
+    esp_cpu_cycle_count_t idleCycles = 0;
+    const uint32_t idleSpins = spin_until(esp_timer_get_time() + BackendBenchmarkCalibrationUs, &idleCycles);
+
+    printf("Test frames on GPIO %d - %lu refreshes per string length - Cycles are processor time per refresh\n", CONFIG_HOLIDAYTREE_LEDS_BENCHMARK_GPIO, BackendBenchmarkIterations);
+    printf("DMA is the DMA capable heap taken by the device, interrupts the processor time lost while the frame is on the wire\n");
+    for (uint32_t countIndex = 0; countIndex < countCount; countIndex++) {
+        if (spiAvailable) {
+            if (run_backend_refreshes(LedStringBackendSpi, spiHost, ledCounts[countIndex], idleSpins) != 0) {
+                return 1;
+            }
+        } else {
+            printf("SPI  %4lu LEDs - Skipped, both SPI hosts drive the LED string\n", ledCounts[countIndex]);
+        }
+        if (run_backend_refreshes(LedStringBackendRmt, spiHost, ledCounts[countIndex], idleSpins) != 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int run_backend_refreshes(led_string_backend_t backend, spi_host_device_t spiHost, uint32_t ledCount, uint32_t idleSpins) {
+    const char* const backendName = backend == LedStringBackendSpi ? "SPI " : "RMT ";
+
+    const size_t freeDmaBytes = heap_caps_get_free_size(MALLOC_CAP_DMA);
+    led_strip_handle_t handle = NULL;
+    esp_err_t err = create_led_strip_device(backend, spiHost, (gpio_num_t) CONFIG_HOLIDAYTREE_LEDS_BENCHMARK_GPIO, ledCount, &handle);
+    if (err != ESP_OK) {
+        printf("%s %4lu LEDs - create_led_strip_device() failed (%d)\n", backendName, ledCount, err);
+        return 1;
+    }
+    const size_t dmaBytes = freeDmaBytes - heap_caps_get_free_size(MALLOC_CAP_DMA);
+
+    // A frame which changes on every refresh
+    const uint32_t wireTimeUs = get_led_string_wire_time_us(ledCount);
+    uint64_t encodeCycles = 0;
+    uint64_t startCycles = 0;
+    uint64_t interruptCycles = 0;
+    uint64_t wallUs = 0;
+    for (uint32_t iteration = 0; (iteration < BackendBenchmarkIterations) && (err == ESP_OK); iteration++) {
+        const esp_cpu_cycle_count_t encodeStartCycles = esp_cpu_get_cycle_count();
+        for (uint32_t index = 0; (index < ledCount) && (err == ESP_OK); index++) {
+            const uint32_t level = (index + iteration) & 0x0F;
+            err = led_strip_set_pixel(handle, index, level, level >> 1, level >> 2);
+        }
+        encodeCycles += esp_cpu_get_cycle_count() - encodeStartCycles;
+        if (err != ESP_OK) {
+            break;
+        }
+
+        const int64_t refreshStartUs = esp_timer_get_time();
+        const esp_cpu_cycle_count_t refreshStartCycles = esp_cpu_get_cycle_count();
+        err = led_strip_refresh_async(handle);
+        startCycles += esp_cpu_get_cycle_count() - refreshStartCycles;
+        if (err != ESP_OK) {
+            break;
+        }
+
+        // Spin while the frame is on the wire - Passes missing against an idle processor went to the transmission interrupts
+        esp_cpu_cycle_count_t spinCycles = 0;
+        const uint32_t expectedSpins = (uint32_t) (((uint64_t) idleSpins * wireTimeUs) / BackendBenchmarkCalibrationUs);
+        const uint32_t spins = spin_until(esp_timer_get_time() + wireTimeUs, &spinCycles);
+        if ((expectedSpins > 0) && (spins < expectedSpins)) {
+            interruptCycles += ((uint64_t) spinCycles * (expectedSpins - spins)) / expectedSpins;
+        }
+
+        err = led_strip_refresh_wait_done(handle);
+        wallUs += esp_timer_get_time() - refreshStartUs;
+    }
+    led_strip_del(handle);
+
+    if (err != ESP_OK) {
+        printf("%s %4lu LEDs - Refresh failed (%d)\n", backendName, ledCount, err);
+        return 1;
+    }
+
+    const uint32_t cpuCycles = (uint32_t) ((encodeCycles + startCycles + interruptCycles) / BackendBenchmarkIterations);
+    printf("%s %4lu LEDs - DMA %6u bytes - %8lu cycles (%6lu set pixels, %6lu start, %8lu interrupts) - Wall %6lu us/refresh, wire time %6lu us\n",
+        backendName, ledCount, dmaBytes, cpuCycles, (uint32_t) (encodeCycles / BackendBenchmarkIterations), (uint32_t) (startCycles / BackendBenchmarkIterations),
+        (uint32_t) (interruptCycles / BackendBenchmarkIterations), (uint32_t) (wallUs / BackendBenchmarkIterations), wireTimeUs);
+
+    return 0;
+}
+
+static uint32_t spin_until(int64_t endUs, esp_cpu_cycle_count_t* cycles) {
+    uint32_t spins = 0;
+    const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+    while (esp_timer_get_time() < endUs) {
+        spins++;
+    }
+    *cycles = esp_cpu_get_cycle_count() - startCycles;
+
+    return spins;
+}
+
+static uint32_t get_segment_wire_time_us(uint32_t ledCount) {
+    // Channels send their segments at the same time - The longest one sets the wire time
+    const uint32_t channelCount = get_led_string_channel_count() > 0 ? get_led_string_channel_count() : 1;
+    return get_led_string_wire_time_us((ledCount + channelCount - 1) / channelCount);
+}
+
+static int run_effects_benchmark() {
+    // Effects render the whole framebuffer - One state buffer for the largest effect
+    const uint32_t ledCount = EffectsBenchmarkLedCount;
+    size_t stateSize = sizeof(uint32_t);
+    for (uint32_t known = LedAnimationTaskNotificationEffectMin; known < LedEffectMax; known++) {
+        const led_effect_t* effect = get_known_led_effect((led_known_effects_t) known);
+        if ((effect != NULL) && (effect->stateSize > stateSize)) {
+            stateSize = effect->stateSize;
+        }
+    }
+    uint8_t* pixels = heap_caps_calloc(ledCount, LED_FRAMEBUFFER_BYTES_PER_PIXEL, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    void* state = heap_caps_calloc(1, stateSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if ((pixels == NULL) || (state == NULL)) {
+        printf("Not enough memory for the effects benchmark\n");
+        heap_caps_free(pixels);
+        heap_caps_free(state);
+        return 1;
+    }
+
+    // Shared primitives - Results are summed so the calls are not optimized out
+    volatile int32_t sink = 0;
+    int32_t sum = 0;
+    uint32_t random = 1;
+    esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+    for (uint32_t call = 0; call < PrimitivesBenchmarkCalls; call++) {
+        sum += (int32_t) next_led_random(&random);
+    }
+    const uint32_t randomCycles = (esp_cpu_get_cycle_count() - startCycles) / PrimitivesBenchmarkCalls;
+    startCycles = esp_cpu_get_cycle_count();
+    for (uint32_t call = 0; call < PrimitivesBenchmarkCalls; call++) {
+        sum += led_sin16((uint16_t) (call * 397));
+    }
+    const uint32_t sineCycles = (esp_cpu_get_cycle_count() - startCycles) / PrimitivesBenchmarkCalls;
+    startCycles = esp_cpu_get_cycle_count();
+    for (uint32_t call = 0; call < PrimitivesBenchmarkCalls; call++) {
+        sum += led_noise_2d((int32_t) (call * 37), (int32_t) (call * 11));
+    }
+    const uint32_t noise2Cycles = (esp_cpu_get_cycle_count() - startCycles) / PrimitivesBenchmarkCalls;
+    startCycles = esp_cpu_get_cycle_count();
+    for (uint32_t call = 0; call < PrimitivesBenchmarkCalls; call++) {
+        sum += led_noise_3d((int32_t) (call * 37), (int32_t) (call * 11), (int32_t) (call * 23));
+    }
+    const uint32_t noise3Cycles = (esp_cpu_get_cycle_count() - startCycles) / PrimitivesBenchmarkCalls;
+    sink = sum;
+    (void) sink;
+    printf("Primitives - Random %lu cycles - Sine %lu cycles - 2D noise %lu cycles - 3D noise %lu cycles\n", randomCycles, sineCycles, noise2Cycles, noise3Cycles);
+
+    // Frames are stepped back to back on a simulated frame clock - The cost of the effect alone, without sending. The
+    // framebuffer is longer than the geometry map, so effects use fallback positions, and effects keeping per LED state
+    // (twinkle, progressive_reveal, show_player) only render the CONFIG_HOLIDAYTREE_LEDS_COUNT LEDs their state covers
+    printf("Render cost per frame - %lu LEDs, %lu frames per effect - Per LED state effects render %d LEDs\n", ledCount, EffectsBenchmarkFrames, CONFIG_HOLIDAYTREE_LEDS_COUNT);
+    led_framebuffer_t framebuffer = { .pixels = pixels, .pixelCount = ledCount };
+    for (uint32_t known = LedAnimationTaskNotificationEffectMin; known < LedEffectMax; known++) {
+        const led_effect_t* effect = get_known_led_effect((led_known_effects_t) known);
+        if (effect == NULL) {
+            continue;
+        }
+
+        led_effect_instance_t instance;
+        start_led_effect_instance(&instance, effect, state);
+        clear_led_framebuffer(&framebuffer);
+        const uint32_t framePeriodUs = 1000000 / CONFIG_HOLIDAYTREE_LEDS_FRAME_RATE;
+        const int64_t clockUs = esp_timer_get_time();
+
+        uint64_t cycles = 0;
+        uint32_t maximumCycles = 0;
+        const int64_t startUs = esp_timer_get_time();
+        for (uint32_t frame = 0; frame < EffectsBenchmarkFrames; frame++) {
+            startCycles = esp_cpu_get_cycle_count();
+            step_led_effect_instance(&instance, clockUs + (int64_t) frame * framePeriodUs, framePeriodUs, &framebuffer);
+            const uint32_t frameCycles = esp_cpu_get_cycle_count() - startCycles;
+            cycles += frameCycles;
+            maximumCycles = frameCycles > maximumCycles ? frameCycles : maximumCycles;
+        }
+
+        const uint32_t frameNs = (uint32_t) (((esp_timer_get_time() - startUs) * 1000) / EffectsBenchmarkFrames);
+        printf("%-20s %8lu ns/frame (%5lu cycles/LED) - %lu cycles maximum - %lu%% of the frame period\n", effect->name, frameNs,
+            (uint32_t) (cycles / ((uint64_t) EffectsBenchmarkFrames * ledCount)), maximumCycles, frameNs / (10 * framePeriodUs));
+    }
+
+    heap_caps_free(pixels);
+    heap_caps_free(state);
+    return 0;
+}
+
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+
+static int run_transition_benchmark() {
+    const uint32_t maximumLedCount = TransitionBenchmarkLedCounts[sizeof(TransitionBenchmarkLedCounts) / sizeof(TransitionBenchmarkLedCounts[0]) - 1];
+    const size_t bufferSize = maximumLedCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+    uint8_t* buffers = heap_caps_calloc(3, bufferSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (buffers == NULL) {
+        printf("Not enough memory for the transition benchmark\n");
+        return 1;
+    }
+
+    // Any content blends at the same cost
+    for (uint32_t index = 0; index < 2 * bufferSize; index++) {
+        buffers[index] = (uint8_t) index;
+    }
+
+    printf("Blend cost per frame - Progress swept over %lu frames, on top of rendering both effects\n", TransitionBenchmarkIterations);
+    for (uint32_t kind = 0; kind < LedTransitionMax; kind++) {
+        for (uint32_t countIndex = 0; countIndex < sizeof(TransitionBenchmarkLedCounts) / sizeof(TransitionBenchmarkLedCounts[0]); countIndex++) {
+            const uint32_t ledCount = TransitionBenchmarkLedCounts[countIndex];
+            const led_framebuffer_t from = { .pixels = buffers, .pixelCount = ledCount };
+            const led_framebuffer_t to = { .pixels = &buffers[bufferSize], .pixelCount = ledCount };
+            led_framebuffer_t output = { .pixels = &buffers[2 * bufferSize], .pixelCount = ledCount };
+
+            const int64_t startUs = esp_timer_get_time();
+            const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+            for (uint32_t iteration = 0; iteration < TransitionBenchmarkIterations; iteration++) {
+                blend_led_transition((led_transition_kind_t) kind, &from, &to, (iteration * LED_TRANSITION_PROGRESS_FULL) / TransitionBenchmarkIterations, &output);
+            }
+            const uint64_t cycles = esp_cpu_get_cycle_count() - startCycles;
+            const uint32_t frameNs = (uint32_t) (((esp_timer_get_time() - startUs) * 1000) / TransitionBenchmarkIterations);
+
+            printf("%-8s %4lu LEDs - %8lu ns/frame (%4lu cycles/LED) - %lu%% of the frame period\n", get_led_transition_name((led_transition_kind_t) kind), ledCount, frameNs,
+                (uint32_t) (cycles / ((uint64_t) TransitionBenchmarkIterations * ledCount)), frameNs / (10 * (1000000 / CONFIG_HOLIDAYTREE_LEDS_FRAME_RATE)));
+        }
+    }
+
+    heap_caps_free(buffers);
+    return 0;
+}
+
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR
+
+static int run_layers_benchmark() {
+    const uint32_t maximumLedCount = LayersBenchmarkLedCounts[sizeof(LayersBenchmarkLedCounts) / sizeof(LayersBenchmarkLedCounts[0]) - 1];
+    const size_t bufferSize = maximumLedCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+    uint8_t* buffers = heap_caps_calloc(2, bufferSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (buffers == NULL) {
+        printf("Not enough memory for the layers benchmark\n");
+        return 1;
+    }
+
+    // Levels on both sides of the output, so the max blend takes both branches
+    for (uint32_t index = 0; index < 2 * bufferSize; index++) {
+        buffers[index] = (uint8_t) (index * 7);
+    }
+
+    // One layer blended over the composite per frame - The cost of a composition is the sum of the costs of its layers
+    printf("Composition cost per layer and per frame - %lu frames per line\n", LayersBenchmarkIterations);
+    for (uint32_t blend = 0; blend < LedLayerBlendMax; blend++) {
+        for (uint32_t opacityIndex = 0; opacityIndex < sizeof(LayersBenchmarkOpacities) / sizeof(LayersBenchmarkOpacities[0]); opacityIndex++) {
+            const uint32_t opacity = LayersBenchmarkOpacities[opacityIndex];
+            for (uint32_t countIndex = 0; countIndex < sizeof(LayersBenchmarkLedCounts) / sizeof(LayersBenchmarkLedCounts[0]); countIndex++) {
+                const uint32_t ledCount = LayersBenchmarkLedCounts[countIndex];
+                const led_framebuffer_t layer = { .pixels = buffers, .pixelCount = ledCount };
+                led_framebuffer_t output = { .pixels = &buffers[bufferSize], .pixelCount = ledCount };
+
+                const int64_t startUs = esp_timer_get_time();
+                const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+                for (uint32_t iteration = 0; iteration < LayersBenchmarkIterations; iteration++) {
+                    blend_led_layer((led_layer_blend_t) blend, opacity, &layer, &output);
+                }
+                const uint64_t cycles = esp_cpu_get_cycle_count() - startCycles;
+                const uint32_t frameNs = (uint32_t) (((esp_timer_get_time() - startUs) * 1000) / LayersBenchmarkIterations);
+
+                printf("%-8s %3lu%% %4lu LEDs - %8lu ns/layer (%4lu cycles/LED/layer) - %lu%% of the frame period\n", get_led_layer_blend_name((led_layer_blend_t) blend),
+                    (opacity * 100) / LED_LAYER_OPACITY_FULL, ledCount, frameNs, (uint32_t) (cycles / ((uint64_t) LayersBenchmarkIterations * ledCount)),
+                    frameNs / (10 * (1000000 / CONFIG_HOLIDAYTREE_LEDS_FRAME_RATE)));
+            }
+        }
+    }
+
+    heap_caps_free(buffers);
+    return 0;
+}
+
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+
+static int run_shows_benchmark() {
+    // Worst case payload - Every pixel literal, one code byte per run
+    const size_t pixelsSize = ShowsBenchmarkLedCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+    const size_t payloadSize = pixelsSize + (ShowsBenchmarkLedCount + LED_SHOW_RUN_MAX_LENGTH - 1) / LED_SHOW_RUN_MAX_LENGTH;
+    uint8_t* buffers = heap_caps_calloc(1, 2 * pixelsSize + payloadSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (buffers == NULL) {
+        printf("Not enough memory for the light shows benchmark\n");
+        return 1;
+    }
+    uint8_t* const pixels = buffers;
+    led_framebuffer_t output = { .pixels = &buffers[pixelsSize], .pixelCount = ShowsBenchmarkLedCount };
+    uint8_t* const payload = &buffers[2 * pixelsSize];
+
+    // Synthetic keyframes decoded from RAM - Keyframes in the bank are read through the flash cache, see below
+    static const uint32_t Operations[] = { LED_SHOW_RUN_LITERAL, LED_SHOW_RUN_FILL, LED_SHOW_RUN_KEEP };
+    static const char* const OperationNames[] = { "literal", "fill", "keep" };
+    printf("Keyframe decode cost - %lu LEDs, %lu decodes per line\n", ShowsBenchmarkLedCount, ShowsBenchmarkIterations);
+    for (uint32_t operationIndex = 0; operationIndex < sizeof(Operations) / sizeof(Operations[0]); operationIndex++) {
+        const led_show_keyframe_t keyframe = {
+            .timeMs = 0,
+            .curve = LedShowCurveLinear,
+            .payload = payload,
+            .payloadSize = build_show_benchmark_payload(Operations[operationIndex], ShowsBenchmarkLedCount, payload),
+            .nextOffset = 0
+        };
+
+        int64_t startUs = esp_timer_get_time();
+        esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+        for (uint32_t iteration = 0; iteration < ShowsBenchmarkIterations; iteration++) {
+            apply_led_show_keyframe(&keyframe, pixels, ShowsBenchmarkLedCount);
+        }
+        const uint64_t applyCycles = esp_cpu_get_cycle_count() - startCycles;
+        const uint32_t applyNs = (uint32_t) (((esp_timer_get_time() - startUs) * 1000) / ShowsBenchmarkIterations);
+
+        startUs = esp_timer_get_time();
+        startCycles = esp_cpu_get_cycle_count();
+        for (uint32_t iteration = 0; iteration < ShowsBenchmarkIterations; iteration++) {
+            interpolate_led_show_keyframe(pixels, &keyframe, iteration & 0xFF, &output);
+        }
+        const uint64_t interpolateCycles = esp_cpu_get_cycle_count() - startCycles;
+        const uint32_t interpolateNs = (uint32_t) (((esp_timer_get_time() - startUs) * 1000) / ShowsBenchmarkIterations);
+
+        // Decoded pixel bytes per second - ns per frame for pixelsSize bytes
+        printf("%-8s %5lu bytes - apply %7lu ns (%3lu cycles/LED, %4lu MB/s) - interpolate %7lu ns (%3lu cycles/LED, %4lu MB/s) - %lu%% of the frame period\n",
+            OperationNames[operationIndex], keyframe.payloadSize,
+            applyNs, (uint32_t) (applyCycles / ((uint64_t) ShowsBenchmarkIterations * ShowsBenchmarkLedCount)), applyNs > 0 ? (uint32_t) ((pixelsSize * 1000) / applyNs) : 0,
+            interpolateNs, (uint32_t) (interpolateCycles / ((uint64_t) ShowsBenchmarkIterations * ShowsBenchmarkLedCount)), interpolateNs > 0 ? (uint32_t) ((pixelsSize * 1000) / interpolateNs) : 0,
+            interpolateNs / (10 * (1000000 / CONFIG_HOLIDAYTREE_LEDS_FRAME_RATE)));
+    }
+
+    // Every keyframe of every mounted show, straight from the mapped partition
+    const uint32_t showCount = get_led_show_count();
+    printf("Mounted shows - %lu\n", showCount);
+    for (uint32_t showIndex = 0; showIndex < showCount; showIndex++) {
+        led_show_t show;
+        if ((get_led_show(showIndex, &show) != ESP_OK) || (show.ledCount > ShowsBenchmarkLedCount)) {
+            printf("Show %lu - Skipped, more than %lu LEDs\n", showIndex, ShowsBenchmarkLedCount);
+            continue;
+        }
+
+        memset(pixels, 0, pixelsSize);
+        led_show_keyframe_t keyframe;
+        uint32_t offset = 0;
+        const int64_t startUs = esp_timer_get_time();
+        const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+        while (get_led_show_keyframe(&show, offset, &keyframe) == ESP_OK) {
+            apply_led_show_keyframe(&keyframe, pixels, show.ledCount);
+            offset = keyframe.nextOffset;
+        }
+        const uint64_t cycles = esp_cpu_get_cycle_count() - startCycles;
+        const uint32_t elapsedUs = (uint32_t) (esp_timer_get_time() - startUs);
+
+        printf("Show %lu - %4lu LEDs, %4lu keyframes, %6lu bytes (%lu%% of raw frames) - %6lu us, %4lu cycles/LED/keyframe, %lu keyframes/s, %lu KB/s\n",
+            showIndex, show.ledCount, show.keyframeCount, show.dataSize, (show.dataSize * 100) / (show.keyframeCount * show.ledCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL),
+            elapsedUs, (uint32_t) (cycles / ((uint64_t) show.keyframeCount * show.ledCount)),
+            elapsedUs > 0 ? (uint32_t) (((uint64_t) show.keyframeCount * 1000000) / elapsedUs) : 0,
+            elapsedUs > 0 ? (uint32_t) (((uint64_t) show.dataSize * 1000000) / (1024 * (uint64_t) elapsedUs)) : 0);
+    }
+
+    heap_caps_free(buffers);
+    return 0;
+}
+
+// One keyframe of 'ledCount' pixels made of the longest runs of 'operation'
+static uint32_t build_show_benchmark_payload(uint32_t operation, uint32_t ledCount, uint8_t* payload) {
+    uint32_t size = 0;
+    for (uint32_t index = 0; index < ledCount; index += LED_SHOW_RUN_MAX_LENGTH) {
+        const uint32_t length = ledCount - index < LED_SHOW_RUN_MAX_LENGTH ? ledCount - index : LED_SHOW_RUN_MAX_LENGTH;
+        payload[size++] = (uint8_t) (operation | (length - 1));
+        const uint32_t levelCount = operation == LED_SHOW_RUN_LITERAL ? length * LED_FRAMEBUFFER_BYTES_PER_PIXEL : (operation == LED_SHOW_RUN_FILL ? LED_FRAMEBUFFER_BYTES_PER_PIXEL : 0);
+        for (uint32_t level = 0; level < levelCount; level++) {
+            payload[size++] = (uint8_t) ((index + level) * 13);
+        }
+    }
+    return size;
+}
+
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+
+static int run_program_benchmark() {
+    const uint32_t maximumLedCount = ProgramBenchmarkLedCounts[sizeof(ProgramBenchmarkLedCounts) / sizeof(ProgramBenchmarkLedCounts[0]) - 1];
+    uint8_t* pixels = heap_caps_calloc(maximumLedCount, LED_FRAMEBUFFER_BYTES_PER_PIXEL, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (pixels == NULL) {
+        printf("Not enough memory for the program benchmark\n");
+        return 1;
+    }
+
+    // Built in programs, then the current one - Interpreter cost only, the frames are not sent
+    printf("Program cost per frame - %lu frames per line\n", ProgramBenchmarkFrames);
+    led_framebuffer_t framebuffer = { .pixels = pixels, .pixelCount = maximumLedCount };
+    for (uint32_t index = 0; index < get_led_builtin_program_count(); index++) {
+        const led_builtin_program_t* builtin = get_led_builtin_program(index);
+        led_program_t program;
+        if (load_led_program_code(builtin->instructions, builtin->instructionCount, &program) == ESP_OK) {
+            run_program_frames(builtin->name, &program, &framebuffer);
+        }
+    }
+    const led_program_t* current = get_led_program();
+    if (current != NULL) {
+        run_program_frames("current", current, &framebuffer);
+    }
+
+    heap_caps_free(pixels);
+    return 0;
+}
+
+static void run_program_frames(const char* name, const led_program_t* program, led_framebuffer_t* framebuffer) {
+    const uint32_t framePeriodUs = 1000000 / CONFIG_HOLIDAYTREE_LEDS_FRAME_RATE;
+    uint32_t random = 1;
+    for (uint32_t countIndex = 0; countIndex < sizeof(ProgramBenchmarkLedCounts) / sizeof(ProgramBenchmarkLedCounts[0]); countIndex++) {
+        const uint32_t ledCount = ProgramBenchmarkLedCounts[countIndex];
+        framebuffer->pixelCount = ledCount;
+
+        // Audio levels swept so programs take their loud and quiet branches
+        const int64_t startUs = esp_timer_get_time();
+        const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+        for (uint32_t frameIndex = 0; frameIndex < ProgramBenchmarkFrames; frameIndex++) {
+            const led_program_frame_t frame = {
+                .timeMs = (int32_t) ((frameIndex * framePeriodUs) / 1000),
+                .bassLevel = (int32_t) ((frameIndex * 8) & 0xFF),
+                .level = (int32_t) ((frameIndex * 16) & 0xFF),
+                .beatPhase = (int32_t) ((frameIndex * 32) & 0xFF),
+                .beatCount = (int32_t) (frameIndex / 8)
+            };
+            run_led_program(program, &frame, &random, framebuffer);
+        }
+        const uint64_t cycles = esp_cpu_get_cycle_count() - startCycles;
+        const uint32_t frameNs = (uint32_t) (((esp_timer_get_time() - startUs) * 1000) / ProgramBenchmarkFrames);
+
+        // LEDs one frame period of interpretation would cover - The wire time of the string is not counted
+        const uint32_t pixelNs = frameNs / ledCount;
+        printf("%-8s %3lu instructions %4lu LEDs - %8lu ns/frame (%5lu cycles/LED) - %lu%% of the frame period - %lu LEDs per frame period\n", name, program->instructionCount, ledCount,
+            frameNs, (uint32_t) (cycles / ((uint64_t) ProgramBenchmarkFrames * ledCount)), frameNs / (10 * framePeriodUs), pixelNs > 0 ? (framePeriodUs * 1000) / pixelNs : 0);
+    }
+}
+
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+
+static int run_color_benchmark() {
+    const uint32_t maximumLedCount = ColorBenchmarkLedCounts[sizeof(ColorBenchmarkLedCounts) / sizeof(ColorBenchmarkLedCounts[0]) - 1];
+    const size_t bufferSize = maximumLedCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+    uint8_t* buffers = heap_caps_calloc(3, bufferSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (buffers == NULL) {
+        printf("Not enough memory for the color correction benchmark\n");
+        return 1;
+    }
+
+    // A dim gradient - The levels gamma crushes, where dithering has fractions to carry on every channel
+    uint8_t* const source = buffers;
+    uint8_t* const destination = &buffers[bufferSize];
+    for (uint32_t index = 0; index < bufferSize; index++) {
+        source[index] = (uint8_t) (index & 0x3F);
+    }
+
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+    printf("Gamma and white balance correction with temporal dithering - 16 bits levels\n");
+#else
+    printf("Gamma and white balance correction - 8 bits levels\n");
+#endif
+
+    for (uint32_t countIndex = 0; countIndex < sizeof(ColorBenchmarkLedCounts) / sizeof(ColorBenchmarkLedCounts[0]); countIndex++) {
+        const uint32_t ledCount = ColorBenchmarkLedCounts[countIndex];
+
+        uint32_t changedFrames = 0;
+        const int64_t startUs = esp_timer_get_time();
+        const esp_cpu_cycle_count_t startCycles = esp_cpu_get_cycle_count();
+        for (uint32_t iteration = 0; iteration < ColorBenchmarkIterations; iteration++) {
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+            uint32_t firstIndex = 0;
+            uint32_t changedCount = 0;
+            uint8_t* const residuals = &buffers[2 * bufferSize];
+            changedFrames += dither_led_pixel_colors(source, destination, residuals, ledCount, LED_COLOR_SCALE_FULL, &firstIndex, &changedCount) ? 1 : 0;
+#else
+            correct_led_pixel_colors(source, destination, ledCount, LED_COLOR_SCALE_FULL);
+            changedFrames++;
+#endif
+        }
+        const uint64_t cycles = esp_cpu_get_cycle_count() - startCycles;
+        const uint64_t elapsedUs = esp_timer_get_time() - startUs;
+
+        // Frames are corrected then sent before the next one is rendered - The wire time adds to the correction time
+        const uint32_t frameNs = (uint32_t) ((elapsedUs * 1000) / ColorBenchmarkIterations);
+        const uint32_t wireTimeNs = get_segment_wire_time_us(ledCount) * 1000;
+        printf("%4lu LEDs - %8lu ns/frame (%5lu cycles/LED) - %7lu frames/s - %5lu frames/s with the wire time - %lu%% frames changed\n",
+            ledCount, frameNs, (uint32_t) (cycles / ((uint64_t) ColorBenchmarkIterations * ledCount)), frameNs > 0 ? 1000000000 / frameNs : 0,
+            1000000000 / (frameNs + wireTimeNs), (changedFrames * 100) / ColorBenchmarkIterations);
+
+#if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+        // One more pass over the frame, reading the same tables
+        uint32_t currentMa = 0;
+        const int64_t powerStartUs = esp_timer_get_time();
+        const esp_cpu_cycle_count_t powerStartCycles = esp_cpu_get_cycle_count();
+        for (uint32_t iteration = 0; iteration < ColorBenchmarkIterations; iteration++) {
+            get_led_power_scale(source, ledCount, &currentMa);
+        }
+        const uint64_t powerCycles = esp_cpu_get_cycle_count() - powerStartCycles;
+        const uint32_t powerNs = (uint32_t) (((esp_timer_get_time() - powerStartUs) * 1000) / ColorBenchmarkIterations);
+        printf("     Power  %8lu ns/frame (%5lu cycles/LED) - %lu.%02lu%% of the wire time - %lu mA estimated\n", powerNs,
+            (uint32_t) (powerCycles / ((uint64_t) ColorBenchmarkIterations * ledCount)), (powerNs * 100) / wireTimeNs, ((powerNs * 10000) / wireTimeNs) % 100, currentMa);
+#endif
+    }
+
+    heap_caps_free(buffers);
+    return 0;
+}
+
+#endif
+
+#endif
\ No newline at end of file
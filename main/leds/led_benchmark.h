@@ -0,0 +1,10 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <esp_err.h>
+
+
+esp_err_t register_led_benchmark_console_command();
\ No newline at end of file
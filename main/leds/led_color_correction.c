@@ -0,0 +1,131 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include "sdkconfig.h"
+
+#include "leds/led_color_correction.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+    // 8.8 fixed point levels
+    #define LED_COLOR_LEVEL_FRACTION_BITS 8
+#else
+    #define LED_COLOR_LEVEL_FRACTION_BITS 0
+#endif
+
+// Level a channel is driven at - The framebuffer level itself without color correction
+#if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+    #define LED_DRIVEN_LEVEL(channel, level) LedColorCorrectionTables[channel][level]
+#else
+    #define LED_DRIVEN_LEVEL(channel, level) (level)
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+// Current drawn by one LED whatever its color, and by each channel at the full corrected level, in uA
+static const uint32_t LedIdleCurrentUa = CONFIG_HOLIDAYTREE_LEDS_IDLE_CURRENT_UA;
+static const uint32_t LedChannelCurrentUa[LED_FRAMEBUFFER_BYTES_PER_PIXEL] = {
+    CONFIG_HOLIDAYTREE_LEDS_RED_CURRENT_MA * 1000,
+    CONFIG_HOLIDAYTREE_LEDS_GREEN_CURRENT_MA * 1000,
+    CONFIG_HOLIDAYTREE_LEDS_BLUE_CURRENT_MA * 1000
+};
+static const uint32_t PowerBudgetUa = CONFIG_HOLIDAYTREE_LEDS_POWER_BUDGET_MA * 1000;
+#endif
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+
+// Scaled levels are at most 255 * 256 so adding a fraction below 256 never carries past 255
+static inline uint8_t dither_level(uint32_t level, uint32_t scale, uint8_t* residual) {
+    const uint32_t value = ((level * scale) >> 8) + *residual;
+    *residual = (uint8_t) value;
+    return (uint8_t) (value >> 8);
+}
+
+bool dither_led_pixel_colors(const uint8_t* source, uint8_t* destination, uint8_t* residuals, uint32_t pixelCount, uint32_t scale, uint32_t* firstIndex, uint32_t* changedCount) {
+    const uint16_t* const red = LedColorCorrectionTables[0];
+    const uint16_t* const green = LedColorCorrectionTables[1];
+    const uint16_t* const blue = LedColorCorrectionTables[2];
+
+    uint32_t first = pixelCount;
+    uint32_t last = 0;
+    for (uint32_t index = 0; index < pixelCount; index++, source += LED_FRAMEBUFFER_BYTES_PER_PIXEL, destination += LED_FRAMEBUFFER_BYTES_PER_PIXEL, residuals += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        const uint8_t redLevel = dither_level(red[source[0]], scale, &residuals[0]);
+        const uint8_t greenLevel = dither_level(green[source[1]], scale, &residuals[1]);
+        const uint8_t blueLevel = dither_level(blue[source[2]], scale, &residuals[2]);
+
+        if ((redLevel != destination[0]) || (greenLevel != destination[1]) || (blueLevel != destination[2])) {
+            destination[0] = redLevel;
+            destination[1] = greenLevel;
+            destination[2] = blueLevel;
+
+            if (first == pixelCount) {
+                first = index;
+            }
+            last = index;
+        }
+    }
+
+    if (first == pixelCount) {
+        return false;
+    }
+
+    *firstIndex = first;
+    *changedCount = last - first + 1;
+    return true;
+}
+
+#elif CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+
+void correct_led_pixel_colors(const uint8_t* source, uint8_t* destination, uint32_t pixelCount, uint32_t scale) {
+    const uint8_t* const red = LedColorCorrectionTables[0];
+    const uint8_t* const green = LedColorCorrectionTables[1];
+    const uint8_t* const blue = LedColorCorrectionTables[2];
+
+    for (const uint8_t* const end = source + pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL; source < end; source += LED_FRAMEBUFFER_BYTES_PER_PIXEL, destination += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        destination[0] = (uint8_t) ((red[source[0]] * scale) >> 8);
+        destination[1] = (uint8_t) ((green[source[1]] * scale) >> 8);
+        destination[2] = (uint8_t) ((blue[source[2]] * scale) >> 8);
+    }
+}
+
+#elif CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+
+void scale_led_pixel_colors(const uint8_t* source, uint8_t* destination, uint32_t pixelCount, uint32_t scale) {
+    for (const uint8_t* const end = source + pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL; source < end; source++, destination++) {
+        *destination = (uint8_t) ((*source * scale) >> 8);
+    }
+}
+
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+
+uint32_t get_led_power_scale(const uint8_t* pixels, uint32_t pixelCount, uint32_t* currentMa) {
+    uint32_t levelSums[LED_FRAMEBUFFER_BYTES_PER_PIXEL] = { 0 };
+    for (const uint8_t* const end = pixels + pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL; pixels < end; pixels += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        levelSums[0] += LED_DRIVEN_LEVEL(0, pixels[0]);
+        levelSums[1] += LED_DRIVEN_LEVEL(1, pixels[1]);
+        levelSums[2] += LED_DRIVEN_LEVEL(2, pixels[2]);
+    }
+
+    // Sums are at most 1024 LEDs * 255 * 256 - The currents they stand for are combined once per frame in 64 bits
+    const uint64_t fullLevel = (uint64_t) (LED_COLOR_CORRECTION_LEVELS - 1) << LED_COLOR_LEVEL_FRACTION_BITS;
+    uint64_t colorCurrentUa = 0;
+    for (uint32_t channel = 0; channel < LED_FRAMEBUFFER_BYTES_PER_PIXEL; channel++) {
+        colorCurrentUa += ((uint64_t) levelSums[channel] * LedChannelCurrentUa[channel]) / fullLevel;
+    }
+    const uint64_t idleCurrentUa = (uint64_t) pixelCount * LedIdleCurrentUa;
+    *currentMa = (uint32_t) ((idleCurrentUa + colorCurrentUa) / 1000);
+
+    // Only the color current scales with brightness - Rounded down so the scaled frame stays within budget
+    if (idleCurrentUa + colorCurrentUa <= PowerBudgetUa) {
+        return LED_COLOR_SCALE_FULL;
+    }
+    if (idleCurrentUa >= PowerBudgetUa) {
+        return 0;
+    }
+    return (uint32_t) (((PowerBudgetUa - idleCurrentUa) * LED_COLOR_SCALE_FULL) / colorCurrentUa);
+}
+
+#endif
\ No newline at end of file
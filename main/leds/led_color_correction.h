@@ -0,0 +1,75 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sdkconfig.h"
+
+#include "leds/led_framebuffer.h"
+
+
+// -----------------------------------------------------------------------------------
+// Gamma and white balance correction - Applied by the LED renderer to the pixels it sends, effects work in linear RGB
+//
+//  * One 256 entries table per color channel, combining CONFIG_HOLIDAYTREE_LEDS_GAMMA and the
+//    CONFIG_HOLIDAYTREE_LEDS_WHITE_BALANCE_* scales
+//  * Tables are generated at build time by tools/generate_led_color_tables.py (see main/CMakeLists.txt) and live in
+//    flash - Nothing is computed at run time
+//  * With CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING tables hold 8.8 fixed point levels - Each channel of each pixel
+//    keeps the fraction it could not show and adds it to the next frame, so the average over a few frames carries
+//    the full precision. Low levels, which gamma crushes to a handful of 8 bits steps, fade smoothly
+//  * Corrected levels are proportional to the PWM duty cycle, hence to the LED current - With
+//    CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT they give the current a frame draws, and a brightness scale applied while
+//    correcting keeps it within CONFIG_HOLIDAYTREE_LEDS_POWER_BUDGET_MA
+//  * The power limit does not need correction - Without it, framebuffer levels are the levels sent and frames over
+//    budget are scaled while they are copied for sending
+// -----------------------------------------------------------------------------------
+
+#define LED_COLOR_CORRECTION_LEVELS 256
+
+// Brightness scales are 8 bits fractions - Full scale leaves corrected levels untouched
+#define LED_COLOR_SCALE_FULL 256
+
+// Red, green then blue - Defined in the generated led_color_tables.c
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+    extern const uint16_t LedColorCorrectionTables[LED_FRAMEBUFFER_BYTES_PER_PIXEL][LED_COLOR_CORRECTION_LEVELS];
+#else
+    extern const uint8_t LedColorCorrectionTables[LED_FRAMEBUFFER_BYTES_PER_PIXEL][LED_COLOR_CORRECTION_LEVELS];
+#endif
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+
+// Correct, scale by 'scale' (LED_COLOR_SCALE_FULL for none) and dither 'pixelCount' packed RGB pixels from 'source' into
+// 'destination', which holds the previous output
+//  * 'residuals' holds the fraction left over by the previous frame for every channel (3 bytes per pixel) and is updated
+//  * Returns false if no output pixel changed, otherwise the range of pixels which changed
+bool dither_led_pixel_colors(const uint8_t* source, uint8_t* destination, uint8_t* residuals, uint32_t pixelCount, uint32_t scale, uint32_t* firstIndex, uint32_t* changedCount);
+
+#elif CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+
+// Correct 'pixelCount' packed RGB pixels from 'source' into 'destination' and scale them by 'scale' (LED_COLOR_SCALE_FULL
+// for none) - One table lookup and one multiplication per byte
+void correct_led_pixel_colors(const uint8_t* source, uint8_t* destination, uint32_t pixelCount, uint32_t scale);
+
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT && !CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+
+// Scale 'pixelCount' packed RGB pixels from 'source' into 'destination' by 'scale' - One multiplication per byte
+void scale_led_pixel_colors(const uint8_t* source, uint8_t* destination, uint32_t pixelCount, uint32_t scale);
+
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+
+// Estimate the current 'pixelCount' packed RGB pixels draw once corrected, in mA, in one pass summing corrected levels
+// per channel, or the levels themselves without color correction - Returns the brightness scale which brings the frame within CONFIG_HOLIDAYTREE_LEDS_POWER_BUDGET_MA,
+// LED_COLOR_SCALE_FULL when it already is
+uint32_t get_led_power_scale(const uint8_t* pixels, uint32_t pixelCount, uint32_t* currentMa);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "sdkconfig.h"
+
+#include "leds/led_compositor.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR
+
+static inline uint8_t mix_level(uint32_t under, uint32_t over, uint32_t opacity) {
+    return (uint8_t) ((under * (LED_LAYER_OPACITY_FULL - opacity) + over * opacity) >> 8);
+}
+
+// x * y / 255, rounded - Exact for 8 bits levels
+static inline uint32_t multiply_levels(uint32_t x, uint32_t y) {
+    const uint32_t product = x * y + 128;
+    return (product + (product >> 8)) >> 8;
+}
+
+
+void blend_led_layer(led_layer_blend_t blend, uint32_t opacity, const led_framebuffer_t* layer, led_framebuffer_t* output) {
+    if (opacity == 0) {
+        return;
+    }
+    if (opacity > LED_LAYER_OPACITY_FULL) {
+        opacity = LED_LAYER_OPACITY_FULL;
+    }
+
+    // Channels blend independently - One loop over every byte of the frame
+    const uint8_t* layerLevel = layer->pixels;
+    uint8_t* outputLevel = output->pixels;
+    const uint8_t* const end = layerLevel + output->pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+    switch (blend) {
+        case LedLayerBlendAdd:
+            for (; layerLevel < end; layerLevel++, outputLevel++) {
+                const uint32_t sum = *outputLevel + ((*layerLevel * opacity) >> 8);
+                *outputLevel = (uint8_t) (sum > 255 ? 255 : sum);
+            }
+            break;
+
+        case LedLayerBlendMaximum:
+            for (; layerLevel < end; layerLevel++, outputLevel++) {
+                if (*layerLevel > *outputLevel) {
+                    *outputLevel = mix_level(*outputLevel, *layerLevel, opacity);
+                }
+            }
+            break;
+
+        case LedLayerBlendMultiply:
+            for (; layerLevel < end; layerLevel++, outputLevel++) {
+                *outputLevel = mix_level(*outputLevel, multiply_levels(*outputLevel, *layerLevel), opacity);
+            }
+            break;
+
+        case LedLayerBlendNormal:
+        default:
+            if (opacity == LED_LAYER_OPACITY_FULL) {
+                memcpy(output->pixels, layer->pixels, output->pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL);
+            } else {
+                for (; layerLevel < end; layerLevel++, outputLevel++) {
+                    *outputLevel = mix_level(*outputLevel, *layerLevel, opacity);
+                }
+            }
+            break;
+    }
+}
+
+void step_led_composition(const led_composition_t* composition, led_composition_state_t* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    const uint32_t layerCount = composition->layerCount < CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR_LAYERS ? composition->layerCount : CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR_LAYERS;
+
+    // Layers are stepped on their own grid of effect time - Every layer is stepped on the first frame
+    bool stepped = false;
+    for (uint32_t index = 0; index < layerCount; index++) {
+        const led_layer_t* layer = &composition->layers[index];
+        if ((layer->effect == NULL) || (layer->effect->stateSize > LED_EFFECT_STATE_MAX_SIZE)) {
+            continue;
+        }
+
+        led_frame_time_t* layerTime = &state->frameTimes[index];
+        if (now->frameIndex > 0) {
+            if ((layer->updatePeriodUs > 0) && (now->timeUs / layer->updatePeriodUs == layerTime->timeUs / layer->updatePeriodUs)) {
+                continue;
+            }
+            layerTime->frameIndex++;
+        }
+        layerTime->timeUs = now->timeUs;
+        layerTime->presentationTimeUs = now->presentationTimeUs;
+        layerTime->framePeriodUs = layer->updatePeriodUs > now->framePeriodUs ? layer->updatePeriodUs : now->framePeriodUs;
+
+        led_framebuffer_t layerFramebuffer = { .pixels = state->layerPixels[index], .pixelCount = framebuffer->pixelCount };
+        layer->effect->step(state->layerStates[index], layerTime, &layerFramebuffer);
+        stepped = true;
+    }
+
+    // 'framebuffer' still holds the composite when no layer changed
+    if (!stepped) {
+        return;
+    }
+
+    bool bottom = true;
+    for (uint32_t index = 0; index < layerCount; index++) {
+        const led_layer_t* layer = &composition->layers[index];
+        if ((layer->effect == NULL) || (layer->effect->stateSize > LED_EFFECT_STATE_MAX_SIZE)) {
+            continue;
+        }
+
+        // The bottom layer is blended over black - An opaque normal one simply replaces the previous composite
+        if (bottom && ((layer->blend != LedLayerBlendNormal) || (layer->opacity < LED_LAYER_OPACITY_FULL))) {
+            clear_led_framebuffer(framebuffer);
+        }
+        bottom = false;
+        const led_framebuffer_t layerFramebuffer = { .pixels = state->layerPixels[index], .pixelCount = framebuffer->pixelCount };
+        blend_led_layer(layer->blend, layer->opacity, &layerFramebuffer, framebuffer);
+    }
+}
+
+const char* get_led_layer_blend_name(led_layer_blend_t blend) {
+    switch (blend) {
+        case LedLayerBlendNormal:
+            return "normal";
+        case LedLayerBlendAdd:
+            return "add";
+        case LedLayerBlendMaximum:
+            return "max";
+        case LedLayerBlendMultiply:
+            return "multiply";
+        default:
+            return "N/A";
+    }
+}
+
+#endif
\ No newline at end of file
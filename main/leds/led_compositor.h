@@ -0,0 +1,71 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sdkconfig.h"
+
+#include "leds/led_effect.h"
+#include "leds/led_framebuffer.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR
+
+// -----------------------------------------------------------------------------------
+// Layered LED effects - A composition stacks effects, bottom layer first, and runs as a single effect
+//
+//  * Every layer steps its effect into its own framebuffer, at its own update period - A slow ambient layer can run
+//    at a few frames per second under a music reactive one running at the frame rate
+//  * Layers are blended over the layers under them with a blend mode and an opacity - Integer loops over packed RGB
+//  * Layer framebuffers and effect states live in the state of the composition, in the renderer effect slot - No
+//    allocation, and two compositions can take part in a transition
+//  * The composite is only redrawn on frames where a layer was stepped
+//
+// 'led_bench layers' measures the blend cost per pixel and per layer (CONFIG_HOLIDAYTREE_LEDS_BENCHMARK)
+// -----------------------------------------------------------------------------------
+
+// Layer opacity - Transparent at 0, opaque at LED_LAYER_OPACITY_FULL
+#define LED_LAYER_OPACITY_FULL 256
+
+typedef enum {
+    LedLayerBlendNormal = 0,        // Layer over the layers under it
+    LedLayerBlendAdd = 1,           // Sum, clamped to full brightness - Lights up
+    LedLayerBlendMaximum = 2,       // Brightest of both per channel
+    LedLayerBlendMultiply = 3,      // Product - Masks and tints
+
+    LedLayerBlendMax
+} led_layer_blend_t;
+
+typedef struct {
+    const led_effect_t* effect;     // Its state is at most LED_EFFECT_STATE_MAX_SIZE
+    led_layer_blend_t blend;
+    uint32_t opacity;
+    uint32_t updatePeriodUs;        // Effect time between two steps of the layer - 0 steps it on every frame
+} led_layer_t;
+
+typedef struct {
+    uint32_t layerCount;            // At most CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR_LAYERS
+    led_layer_t layers[CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR_LAYERS];
+} led_composition_t;
+
+// State of a running composition - Layered effects declare it as their state
+typedef struct {
+    led_frame_time_t frameTimes[CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR_LAYERS];     // Of the last step of each layer
+    uint32_t layerStates[CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR_LAYERS][LED_EFFECT_STATE_MAX_SIZE / sizeof(uint32_t)];
+    uint8_t layerPixels[CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR_LAYERS][CONFIG_HOLIDAYTREE_LEDS_COUNT * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+} led_composition_state_t;
+
+
+// Blend 'layer' over 'output' at 'opacity' - Both framebuffers have the same pixel count
+void blend_led_layer(led_layer_blend_t blend, uint32_t opacity, const led_framebuffer_t* layer, led_framebuffer_t* output);
+
+// Step function of layered effects - Steps the layers due at 'now' and composes them into 'framebuffer'
+void step_led_composition(const led_composition_t* composition, led_composition_state_t* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+
+const char* get_led_layer_blend_name(led_layer_blend_t blend);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "leds/led_effect.h"
+
+
+void start_led_effect_instance(led_effect_instance_t* instance, const led_effect_t* effect, void* state) {
+    memset(state, 0, effect->stateSize);
+    memset(instance, 0, sizeof(*instance));
+    instance->effect = effect;
+    instance->state = state;
+    instance->speed = LED_EFFECT_SPEED_NORMAL;
+}
+
+void step_led_effect_instance(led_effect_instance_t* instance, int64_t presentationTimeUs, uint32_t framePeriodUs, led_framebuffer_t* framebuffer) {
+    led_frame_time_t* frameTime = &instance->frameTime;
+    if (instance->started) {
+        // Effect time advances by the scaled time between frames - Frames skipped by the renderer show as a larger step
+        if (instance->speed == 0) {
+            frameTime->presentationTimeUs = presentationTimeUs;
+            return;
+        }
+        frameTime->timeUs += ((presentationTimeUs - frameTime->presentationTimeUs) * instance->speed) / LED_EFFECT_SPEED_NORMAL;
+        frameTime->frameIndex++;
+    }
+    frameTime->presentationTimeUs = presentationTimeUs;
+    frameTime->framePeriodUs = framePeriodUs;
+    instance->started = true;
+
+    instance->effect->step(instance->state, frameTime, framebuffer);
+}
\ No newline at end of file
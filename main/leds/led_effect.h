@@ -4,7 +4,15 @@
 
 #pragma once
 
-#include "leds/led_internals.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <freertos/FreeRTOS.h>
+
+#include "sdkconfig.h"
+
+#include "leds/led_framebuffer.h"
 
 
 typedef enum {
@@ -14,11 +22,62 @@ typedef enum {
 } led_animation_task_notification_t;
 
 
-extern const UBaseType_t LedAnimationTaskNotificationIndex;
+// Time of the frame being rendered
+typedef struct {
+    int64_t timeUs;                 // Time since the effect started - Frames are evenly spaced, missed frames are skipped
+    int64_t presentationTimeUs;     // esp_timer time the frame is scheduled to be shown
+    uint32_t frameIndex;            // 0 on the first frame of the effect
+    uint32_t framePeriodUs;
+} led_frame_time_t;
+
+// -----------------------------------------------------------------------------------
+// Effects are step functions over a state struct - Driven by the LED renderer, one step per frame
+//
+//  * An effect is a constant descriptor: a name, the size of its state and its step function
+//  * State lives in a block the caller provides, zeroed when the effect starts - Effects keep no static state and
+//    allocate nothing, so the same effect can run several times at once (transitions, layers)
+//  * step() draws one frame into 'framebuffer' and returns - It never waits. 'framebuffer' holds the frame the effect
+//    drew last, all black on the first step
+//  * Instances carry the time line of an effect: it advances by the frame time scaled by 'speed', so effects can be
+//    paused, slowed down or sped up without knowing it
+// -----------------------------------------------------------------------------------
+
+// Largest effect state - Effects check theirs fits at build time. Layered effects (leds/led_compositor.h) are larger:
+// the renderer reserves slots for them too
+#define LED_EFFECT_STATE_MAX_SIZE (128 + 4 * CONFIG_HOLIDAYTREE_LEDS_COUNT)
+
+// Effect speed is an 8 bits fraction - Real time at LED_EFFECT_SPEED_NORMAL, paused at 0
+#define LED_EFFECT_SPEED_NORMAL 256
 
-led_animation_task_notification_t accept_task_notification_with_delay(uint32_t delayMs);
 
-#define WAIT_OR_END_EFFECT(delayMs) do { \
-        led_animation_task_notification_t _notification = accept_task_notification_with_delay( ( delayMs ) ); \
-        if (_notification != LedAnimationTaskNotificationNone) return _notification; \
-    } while(0)
+typedef void (*led_effect_step_t)(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+
+typedef struct {
+    const char* name;
+    size_t stateSize;           // At most LED_EFFECT_STATE_MAX_SIZE, except layered effects
+    led_effect_step_t step;
+} led_effect_t;
+
+// Running effect
+typedef struct {
+    const led_effect_t* effect;
+    void* state;
+    led_frame_time_t frameTime;     // Of the last step - Effect time, not esp_timer time
+    uint32_t speed;
+    bool started;
+} led_effect_instance_t;
+
+
+// Zero 'state' (the 'stateSize' of 'effect') and start 'effect' on it at normal speed - The first step is frame 0 at time 0
+void start_led_effect_instance(led_effect_instance_t* instance, const led_effect_t* effect, void* state);
+
+// Step 'instance' for the frame shown at 'presentationTimeUs' (esp_timer time) - Nothing is drawn while paused
+void step_led_effect_instance(led_effect_instance_t* instance, int64_t presentationTimeUs, uint32_t framePeriodUs, led_framebuffer_t* framebuffer);
+
+
+// Effect changes are sent on LedAnimationTaskNotificationIndex - LedFrameClockNotificationIndex is given on every
+// frame deadline and on every effect change so a task waiting for the next frame sees effect changes right away
+extern const UBaseType_t LedAnimationTaskNotificationIndex;
+extern const UBaseType_t LedFrameClockNotificationIndex;
+
+led_animation_task_notification_t accept_task_notification_with_delay(uint32_t delayMs);
\ No newline at end of file
@@ -0,0 +1,41 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+
+// Packed RGB - 3 bytes per pixel, in LED string order
+#define LED_FRAMEBUFFER_BYTES_PER_PIXEL 3
+
+
+typedef struct {
+    uint8_t* pixels;
+    uint32_t pixelCount;
+} led_framebuffer_t;
+
+
+static inline void set_led_framebuffer_pixel(led_framebuffer_t* framebuffer, uint32_t index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index < framebuffer->pixelCount) {
+        uint8_t* pixel = &framebuffer->pixels[index * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+        pixel[0] = red;
+        pixel[1] = green;
+        pixel[2] = blue;
+    }
+}
+
+static inline void fill_led_framebuffer(led_framebuffer_t* framebuffer, uint8_t red, uint8_t green, uint8_t blue) {
+    uint8_t* pixel = framebuffer->pixels;
+    for (uint32_t index = 0; index < framebuffer->pixelCount; index++, pixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        pixel[0] = red;
+        pixel[1] = green;
+        pixel[2] = blue;
+    }
+}
+
+static inline void clear_led_framebuffer(led_framebuffer_t* framebuffer) {
+    memset(framebuffer->pixels, 0, framebuffer->pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL);
+}
\ No newline at end of file
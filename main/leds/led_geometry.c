@@ -0,0 +1,224 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <esp_check.h>
+#include <esp_console.h>
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+
+#include "configuration/nvs_configuration.h"
+
+#include "leds/led_internals.h"
+#include "leds/led_geometry.h"
+
+
+// Stored map - Version and LED count then x, y and height of every LED. Angles are recomputed on load
+typedef struct led_geometry_blob_header {
+    uint16_t version;
+    uint16_t ledCount;
+} __attribute__ ((__packed__)) led_geometry_blob_header_t;
+
+#define LED_GEOMETRY_BLOB_BYTES_PER_LED 3
+
+
+// NVS namespace and key of the LED geometry
+static const char LedGeometryNamespace[NVS_NS_NAME_MAX_SIZE] = "led_geometry";
+static const char LedGeometryKey[NVS_KEY_NAME_MAX_SIZE] = "map";
+
+// Current map version
+static const uint16_t CurrentGeometryVersion = 1;
+
+// Approximate positions of the LEDs on the Holiday Tree board - Center, right 1 and 2, left 1 and 2 from the top down
+static const led_position_t HolidayTreeBoardPositions[] = {
+    { .x = 128, .y = 128, .height = 224 },
+    { .x = 176, .y = 128, .height = 144 },
+    { .x = 208, .y = 128, .height = 48 },
+    { .x = 80, .y = 128, .height = 144 },
+    { .x = 48, .y = 128, .height = 48 }
+};
+
+// Strings wound around a cone from the bottom up - Turns between the bottom and the top
+static const float GeneratedSpiralTurns = CONFIG_HOLIDAYTREE_LEDS_GEOMETRY_SPIRAL_TURNS;
+
+
+// Map in memory - Written once at start up, then only by the console task
+static led_position_t* s_led_positions = NULL;
+static uint32_t s_led_count = 0;
+
+
+static esp_err_t read_led_geometry();
+static void generate_led_geometry();
+static uint8_t compute_led_angle(uint8_t x, uint8_t y);
+
+
+esp_err_t load_led_geometry(uint32_t ledCount) {
+    ESP_RETURN_ON_FALSE((ledCount > 0) && (ledCount <= UINT16_MAX), ESP_ERR_INVALID_ARG, LedStringTag, "load_led_geometry() - Invalid LED count %"PRIu32, ledCount);
+    ESP_RETURN_ON_FALSE(s_led_positions == NULL, ESP_ERR_INVALID_STATE, LedStringTag, "load_led_geometry() - Already loaded");
+
+    s_led_positions = heap_caps_calloc(ledCount, sizeof(led_position_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(s_led_positions != NULL, ESP_ERR_NO_MEM, LedStringTag, "load_led_geometry() - Not enough memory for %"PRIu32" LEDs", ledCount);
+    s_led_count = ledCount;
+
+    // A missing or stale map is not an error - The generated map keeps every effect working
+    esp_err_t err = read_led_geometry();
+    if (err != ESP_OK) {
+        ESP_LOGI(LedStringTag, "No LED geometry for %"PRIu32" LEDs in NVS (%d) - Using the generated map", ledCount, err);
+        generate_led_geometry();
+    }
+
+    return ESP_OK;
+}
+
+const led_position_t* get_led_positions(uint32_t pixelCount) {
+    return pixelCount <= s_led_count ? s_led_positions : NULL;
+}
+
+esp_err_t set_led_position(uint32_t index, uint8_t x, uint8_t y, uint8_t height) {
+    ESP_RETURN_ON_FALSE(index < s_led_count, ESP_ERR_INVALID_ARG, LedStringTag, "set_led_position() - Invalid LED index %"PRIu32, index);
+
+    led_position_t* position = &s_led_positions[index];
+    position->x = x;
+    position->y = y;
+    position->height = height;
+    position->angle = compute_led_angle(x, y);
+    return ESP_OK;
+}
+
+esp_err_t save_led_geometry() {
+    ESP_RETURN_ON_FALSE(s_led_positions != NULL, ESP_ERR_INVALID_STATE, LedStringTag, "save_led_geometry() - load_led_geometry() must be called first");
+
+    const size_t blobSize = sizeof(led_geometry_blob_header_t) + s_led_count * LED_GEOMETRY_BLOB_BYTES_PER_LED;
+    uint8_t* blob = heap_caps_malloc(blobSize, MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(blob != NULL, ESP_ERR_NO_MEM, LedStringTag, "save_led_geometry() - Not enough memory");
+
+    const led_geometry_blob_header_t header = { .version = CurrentGeometryVersion, .ledCount = (uint16_t) s_led_count };
+    memcpy(blob, &header, sizeof(header));
+    uint8_t* entry = &blob[sizeof(header)];
+    for (uint32_t index = 0; index < s_led_count; index++, entry += LED_GEOMETRY_BLOB_BYTES_PER_LED) {
+        entry[0] = s_led_positions[index].x;
+        entry[1] = s_led_positions[index].y;
+        entry[2] = s_led_positions[index].height;
+    }
+
+    esp_err_t err = nvs_set_configuration(LedGeometryNamespace, LedGeometryKey, blob, blobSize);
+    heap_caps_free(blob);
+    return err;
+}
+
+esp_err_t reset_led_geometry() {
+    ESP_RETURN_ON_FALSE(s_led_positions != NULL, ESP_ERR_INVALID_STATE, LedStringTag, "reset_led_geometry() - load_led_geometry() must be called first");
+
+    generate_led_geometry();
+    esp_err_t err = nvs_erase_configuration(LedGeometryNamespace, LedGeometryKey);
+    return err == ESP_ERR_NVS_NOT_FOUND ? ESP_OK : err;
+}
+
+static esp_err_t read_led_geometry() {
+    const size_t expectedSize = sizeof(led_geometry_blob_header_t) + s_led_count * LED_GEOMETRY_BLOB_BYTES_PER_LED;
+    uint8_t* blob = heap_caps_malloc(expectedSize, MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(blob != NULL, ESP_ERR_NO_MEM, LedStringTag, "read_led_geometry() - Not enough memory");
+
+    // A map saved for a different LED count does not fit the buffer or fails the header check
+    size_t blobSize = expectedSize;
+    esp_err_t err = nvs_get_configuration(LedGeometryNamespace, LedGeometryKey, blob, &blobSize);
+    if (err == ESP_OK) {
+        led_geometry_blob_header_t header;
+        memcpy(&header, blob, sizeof(header));
+        if ((blobSize != expectedSize) || (header.version != CurrentGeometryVersion) || (header.ledCount != s_led_count)) {
+            err = ESP_ERR_INVALID_VERSION;
+        }
+    }
+
+    if (err == ESP_OK) {
+        const uint8_t* entry = &blob[sizeof(led_geometry_blob_header_t)];
+        for (uint32_t index = 0; index < s_led_count; index++, entry += LED_GEOMETRY_BLOB_BYTES_PER_LED) {
+            set_led_position(index, entry[0], entry[1], entry[2]);
+        }
+    }
+
+    heap_caps_free(blob);
+    return err;
+}
+
+static void generate_led_geometry() {
+    if (s_led_count == sizeof(HolidayTreeBoardPositions) / sizeof(HolidayTreeBoardPositions[0])) {
+        for (uint32_t index = 0; index < s_led_count; index++) {
+            set_led_position(index, HolidayTreeBoardPositions[index].x, HolidayTreeBoardPositions[index].y, HolidayTreeBoardPositions[index].height);
+        }
+        return;
+    }
+
+    // The first LED is at the bottom facing the front - The cone narrows to the trunk at the top
+    for (uint32_t index = 0; index < s_led_count; index++) {
+        const float progress = s_led_count > 1 ? (float) index / (float) (s_led_count - 1) : 0.0f;
+        const float angle = 2.0f * (float) M_PI * GeneratedSpiralTurns * progress;
+        const float radius = 127.0f * (1.0f - progress);
+        set_led_position(index, (uint8_t) lroundf(128.0f + radius * sinf(angle)), (uint8_t) lroundf(128.0f + radius * cosf(angle)), (uint8_t) lroundf(255.0f * progress));
+    }
+}
+
+static uint8_t compute_led_angle(uint8_t x, uint8_t y) {
+    const float angle = atan2f((float) x - 128.0f, (float) y - 128.0f);
+    return (uint8_t) (lroundf(angle * 128.0f / (float) M_PI) & 0xFF);
+}
+
+
+#if CONFIG_HOLIDAYTREE_CONSOLE
+
+static int led_geometry_console_command(int argc, char** argv);
+
+
+esp_err_t register_led_geometry_console_command() {
+    const esp_console_cmd_t geometryCommand = {
+        .command = "led_geometry",
+        .help = "LED positions on the tree - 'led_geometry show|set <index> <x> <y> <height>|save|reset'",
+        .hint = NULL,
+        .func = &led_geometry_console_command
+    };
+
+    ESP_RETURN_ON_ERROR(esp_console_cmd_register(&geometryCommand), LedStringTag, "esp_console_cmd_register() failed");
+    return ESP_OK;
+}
+
+static int led_geometry_console_command(int argc, char** argv) {
+    if (s_led_positions == NULL) {
+        printf("LED geometry not loaded\n");
+        return 1;
+    }
+
+    const char* const subCommand = argc > 1 ? argv[1] : "show";
+
+    esp_err_t err = ESP_OK;
+    if (strcmp(subCommand, "show") == 0) {
+        printf("%lu LEDs - index: x y height (angle)\n", s_led_count);
+        for (uint32_t index = 0; index < s_led_count; index++) {
+            const led_position_t* position = &s_led_positions[index];
+            printf("%4lu: %3u %3u %3u (%3u)\n", index, position->x, position->y, position->height, position->angle);
+        }
+    } else if ((strcmp(subCommand, "set") == 0) && (argc == 6)) {
+        err = set_led_position(strtoul(argv[2], NULL, 10), (uint8_t) strtoul(argv[3], NULL, 10), (uint8_t) strtoul(argv[4], NULL, 10), (uint8_t) strtoul(argv[5], NULL, 10));
+    } else if (strcmp(subCommand, "save") == 0) {
+        err = save_led_geometry();
+    } else if (strcmp(subCommand, "reset") == 0) {
+        err = reset_led_geometry();
+    } else {
+        printf("Unknown sub command '%s' - Use show, set <index> <x> <y> <height>, save or reset\n", subCommand);
+        return 1;
+    }
+
+    if (err != ESP_OK) {
+        printf("led_geometry %s failed (%d)\n", subCommand, err);
+        return 1;
+    }
+
+    return 0;
+}
+
+#endif
\ No newline at end of file
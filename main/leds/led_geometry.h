@@ -0,0 +1,54 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+#include <esp_err.h>
+
+#include "sdkconfig.h"
+
+
+// -----------------------------------------------------------------------------------
+// LED geometry - Where each LED of the string sits on the tree, so effects can address pixels spatially
+//
+//  * Loaded once by configure_led_string() from the 'led_geometry' NVS namespace, or generated when NVS has no map for
+//    CONFIG_HOLIDAYTREE_LEDS_COUNT LEDs: the Holiday Tree board layout for 5 LEDs, a string wound around a cone otherwise
+//  * Positions are 8 bits per axis and the angle around the trunk is precomputed - Effects do no trigonometry
+//  * 'led_geometry' console command (CONFIG_HOLIDAYTREE_CONSOLE) shows, edits and saves the map in place - Effects read
+//    positions every frame and show edits on their next frame, progressive_reveal sorts its order once when it starts
+// -----------------------------------------------------------------------------------
+
+typedef struct {
+    uint8_t x;          // Left to right seen from the front - 128 is the trunk
+    uint8_t y;          // Back to front - 128 is the trunk
+    uint8_t height;     // 0 at the bottom of the tree, 255 at the top
+    uint8_t angle;      // Around the trunk in 256th of a turn - 0 faces the front, 64 the right
+} led_position_t;
+
+
+esp_err_t load_led_geometry(uint32_t ledCount);
+
+// Any task - Indexed like a framebuffer of 'pixelCount' pixels. NULL until load_led_geometry() succeeded, or when the map
+// covers fewer LEDs than 'pixelCount' (benchmark framebuffers): effects then use the fallback of get_led_position()
+const led_position_t* get_led_positions(uint32_t pixelCount);
+
+// Position of LED 'index' of 'ledCount' - Up a vertical line at the trunk, in string order, when 'positions' is NULL
+static inline led_position_t get_led_position(const led_position_t* positions, uint32_t index, uint32_t ledCount) {
+    if (positions != NULL) {
+        return positions[index];
+    }
+    const led_position_t position = { .x = 128, .y = 128, .height = (uint8_t) (ledCount > 1 ? (index * 255) / (ledCount - 1) : 0), .angle = 0 };
+    return position;
+}
+
+// Console task - Edits apply to the map in memory, save_led_geometry() stores them and reset_led_geometry() goes back to the generated map
+esp_err_t set_led_position(uint32_t index, uint8_t x, uint8_t y, uint8_t height);
+esp_err_t save_led_geometry();
+esp_err_t reset_led_geometry();
+
+#if CONFIG_HOLIDAYTREE_CONSOLE
+esp_err_t register_led_geometry_console_command();
+#endif
\ No newline at end of file
@@ -6,11 +6,13 @@
 
 
 #include "leds/led_internals.h"
+#include "leds/led_renderer.h"
+#include "leds/led_geometry.h"
 #include "leds/led_init.h"
 
 
-// The Holiday Tree has 5 LEDs
-const int HolidayTreeLedsCount = 5;
+// The Holiday Tree board has 5 LEDs - Larger trees set CONFIG_HOLIDAYTREE_LEDS_COUNT
+const int HolidayTreeLedsCount = CONFIG_HOLIDAYTREE_LEDS_COUNT;
 
 
 esp_err_t configure_led_string(gpio_num_t ledDataPin, gpio_num_t ledOnOffSwitchPin) {
@@ -27,6 +29,12 @@ esp_err_t configure_led_string(gpio_num_t ledDataPin, gpio_num_t ledOnOffSwitchP
     }
 
     esp_err_t err = create_led_string(ledDataPin, ledOnOffSwitchPin, HolidayTreeLedsCount);
+    if (err == ESP_OK) {
+        err = load_led_geometry(HolidayTreeLedsCount);
+    }
+    if (err == ESP_OK) {
+        err = create_led_renderer(HolidayTreeLedsCount);
+    }
     if (err == ESP_OK) {
         // Turn string power on ...
         err = set_led_string_on_off(LedStringOn);
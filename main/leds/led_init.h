@@ -8,4 +8,8 @@
 #include <soc/gpio_num.h>
 
 
+// Number of LEDs on the tree
+extern const int HolidayTreeLedsCount;
+
+
 esp_err_t configure_led_string(gpio_num_t ledDataPin, gpio_num_t ledOnOffSwitchPin);
\ No newline at end of file
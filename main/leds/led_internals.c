@@ -2,6 +2,10 @@
 // Copyright 2024, Gilles Zunino
 // -----------------------------------------------------------------------------------
 
+#include <sys/lock.h>
+
+#include <esp_check.h>
+
 #include "led_strip.h"
 
 #include "leds/led_internals.h"
@@ -11,11 +15,60 @@
 const char* LedStringTag = "led_string";
 
 
+// Output channels - Each drives one segment of the logical string, all channels transmit at the same time
+#define LED_STRING_MAX_CHANNELS 3
+
+typedef struct {
+    led_string_backend_t backend;
+    spi_host_device_t spiHost;      // SPI backend only
+} led_string_channel_config_t;
+
+typedef struct {
+    led_strip_handle_t handle;
+    uint32_t firstIndex;            // First LED of the logical string driven by the channel
+    uint32_t ledCount;
+    bool transmitting;              // A frame may still be on the wire - led_strip pixels must not change until it is done
+} led_string_channel_t;
+
+
+// Channel 1 drives the data pin of the board, channels 2 and 3 the CONFIG_HOLIDAYTREE_LEDS_CHANNEL*_GPIO pins
+static const led_string_channel_config_t LedStringChannelConfigs[LED_STRING_MAX_CHANNELS] = {
+#if CONFIG_HOLIDAYTREE_LEDS_BACKEND_RMT
+    // SPI stays free for other peripherals
+    { .backend = LedStringBackendRmt },
+    { .backend = LedStringBackendRmt },
+    { .backend = LedStringBackendRmt }
+#else
+    { .backend = LedStringBackendSpi, .spiHost = SPI2_HOST },
+    { .backend = LedStringBackendSpi, .spiHost = SPI3_HOST },
+    { .backend = LedStringBackendRmt }
+#endif
+};
+
+// RMT resolution - 10MHz gives 100ns steps, plenty for WS2812 timings
+static const uint32_t RmtResolutionHz = 10000000;
+
+// WS2812 wire time - 24 bits of 1.25us per LED then a reset (low) of at least 280us
+static const uint32_t Ws2812LedWireTimeNs = 30000;
+static const uint32_t Ws2812ResetTimeUs = 280;
+
+
 // LEDs string on / off switch pin
 static gpio_num_t s_leds_string_on_off_gpio = GPIO_NUM_NC;
 
-// String of individually addressable LEDs
-static led_strip_handle_t s_led_string_handle = NULL;
+// Segments of the string of individually addressable LEDs
+static led_string_channel_t s_led_string_channels[LED_STRING_MAX_CHANNELS];
+static uint32_t s_led_string_channel_count = 0;
+
+// The string is powered and every LED is known to be off - Powering the string on or off makes its content unknown
+static bool s_led_string_blank = false;
+
+// Serializes the LED animation task and the benchmarks
+static _lock_t s_led_string_lock;
+
+
+static esp_err_t start_led_string_channels_refresh();
+static esp_err_t wait_led_string_channels();
 
 
 esp_err_t create_led_string(gpio_num_t dataPin, gpio_num_t onOffPin, uint32_t ledCount) {
@@ -30,50 +83,247 @@ esp_err_t create_led_string(gpio_num_t dataPin, gpio_num_t onOffPin, uint32_t le
         .intr_type = GPIO_INTR_DISABLE
     };
     esp_err_t err = gpio_config(&onOffSwitchConfiguration);
-    if (err == ESP_OK) {
-        // Configure LED string for the board
-        const led_strip_config_t ledStringConfig = {
-            .strip_gpio_num = dataPin,
-            .max_leds = ledCount,
-            .led_model = LED_MODEL_WS2812,
-            .color_component_format= {
-                .format = {
-                    .r_pos = 1, // R is in second position
-                    .g_pos = 0, // G is in first position
-                    .b_pos = 2, // B is in third position
-                    .num_components = 3
-                }
-            },
-            .flags = {
-                .invert_out = false
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    // Split the string in equal segments - The first channels take the remainder
+    const gpio_num_t dataPins[LED_STRING_MAX_CHANNELS] = {
+        dataPin,
+#if CONFIG_HOLIDAYTREE_LEDS_CHANNELS >= 2
+        (gpio_num_t) CONFIG_HOLIDAYTREE_LEDS_CHANNEL2_GPIO,
+#else
+        GPIO_NUM_NC,
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_CHANNELS >= 3
+        (gpio_num_t) CONFIG_HOLIDAYTREE_LEDS_CHANNEL3_GPIO
+#else
+        GPIO_NUM_NC
+#endif
+    };
+    const uint32_t channelCount = ledCount < CONFIG_HOLIDAYTREE_LEDS_CHANNELS ? ledCount : CONFIG_HOLIDAYTREE_LEDS_CHANNELS;
+    uint32_t firstIndex = 0;
+    for (uint32_t channelIndex = 0; channelIndex < channelCount; channelIndex++) {
+        led_string_channel_t* channel = &s_led_string_channels[channelIndex];
+        channel->firstIndex = firstIndex;
+        channel->ledCount = ledCount / channelCount + (channelIndex < ledCount % channelCount ? 1 : 0);
+        firstIndex += channel->ledCount;
+
+        const led_string_channel_config_t* config = &LedStringChannelConfigs[channelIndex];
+        ESP_RETURN_ON_ERROR(create_led_strip_device(config->backend, config->spiHost, dataPins[channelIndex], channel->ledCount, &channel->handle), LedStringTag, "create_led_string() - Channel %lu failed", channelIndex + 1);
+        s_led_string_channel_count = channelIndex + 1;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t create_led_strip_device(led_string_backend_t backend, spi_host_device_t spiHost, gpio_num_t dataPin, uint32_t ledCount, led_strip_handle_t* handle) {
+    // Configure LED string for the board
+    const led_strip_config_t ledStringConfig = {
+        .strip_gpio_num = dataPin,
+        .max_leds = ledCount,
+        .led_model = LED_MODEL_WS2812,
+        .color_component_format= {
+            .format = {
+                .r_pos = 1, // R is in second position
+                .g_pos = 0, // G is in first position
+                .b_pos = 2, // B is in third position
+                .num_components = 3
             }
-        };
-
-        const led_strip_spi_config_t spiConfig = {
-            .clk_src = SPI_CLK_SRC_DEFAULT,
-            .spi_bus = SPI2_HOST,
-            .flags.with_dma = true
-        };
-        
-        err = led_strip_new_spi_device(&ledStringConfig, &spiConfig, &s_led_string_handle);
+        },
+        .flags = {
+            .invert_out = false
+        }
+    };
+
+    switch (backend) {
+        case LedStringBackendSpi: {
+            // Each LED bit is encoded as 3 SPI bits - 9 bytes of DMA capable memory per LED, no interrupt while sending
+            const led_strip_spi_config_t spiConfig = {
+                .clk_src = SPI_CLK_SRC_DEFAULT,
+                .spi_bus = spiHost,
+                .flags.with_dma = true
+            };
+            return led_strip_new_spi_device(&ledStringConfig, &spiConfig, handle);
+        }
+
+        case LedStringBackendRmt: {
+            // The ESP32 RMT has no DMA - Symbols are encoded by interrupts refilling the RMT memory while sending
+            const led_strip_rmt_config_t rmtConfig = {
+                .clk_src = RMT_CLK_SRC_DEFAULT,
+                .resolution_hz = RmtResolutionHz,
+                .mem_block_symbols = 0,
+                .flags.with_dma = false
+            };
+            return led_strip_new_rmt_device(&ledStringConfig, &rmtConfig, handle);
+        }
     }
 
-    return err;
+    return ESP_ERR_INVALID_ARG;
 }
 
 
 esp_err_t set_led_string_on_off(led_string_state_t onOff) {
-    return gpio_set_level(s_leds_string_on_off_gpio, onOff == LedStringOn ? 1 : 0);
+    _lock_acquire(&s_led_string_lock);
+        // Let the last frame out before cutting or restoring power
+        esp_err_t err = wait_led_string_channels();
+        if (err == ESP_OK) {
+            s_led_string_blank = false;
+            err = gpio_set_level(s_leds_string_on_off_gpio, onOff == LedStringOn ? 1 : 0);
+        }
+    _lock_release(&s_led_string_lock);
+
+    return err;
 }
 
 esp_err_t set_led_string_pixel(uint32_t index, uint32_t red, uint32_t green, uint32_t blue) {
-    return led_strip_set_pixel(s_led_string_handle, index, red, green, blue);
+    esp_err_t err = ESP_ERR_INVALID_ARG;
+
+    _lock_acquire(&s_led_string_lock);
+        for (uint32_t channelIndex = 0; channelIndex < s_led_string_channel_count; channelIndex++) {
+            led_string_channel_t* channel = &s_led_string_channels[channelIndex];
+            if ((index >= channel->firstIndex) && (index < channel->firstIndex + channel->ledCount)) {
+                err = wait_led_string_channels();
+                if (err == ESP_OK) {
+                    err = led_strip_set_pixel(channel->handle, index - channel->firstIndex, red, green, blue);
+                }
+                break;
+            }
+        }
+    _lock_release(&s_led_string_lock);
+
+    return err;
 }
 
 esp_err_t refresh_led_string(void) {
-    return led_strip_refresh(s_led_string_handle);
+    _lock_acquire(&s_led_string_lock);
+        esp_err_t err = wait_led_string_channels();
+        if (err == ESP_OK) {
+            s_led_string_blank = false;
+            err = start_led_string_channels_refresh();
+        }
+        if (err == ESP_OK) {
+            err = wait_led_string_channels();
+        }
+    _lock_release(&s_led_string_lock);
+
+    return err;
+}
+
+esp_err_t write_led_string_pixels(const uint8_t* pixels, uint32_t firstIndex, uint32_t pixelCount) {
+    _lock_acquire(&s_led_string_lock);
+        // led_strip encodes pixels straight into the buffer the DMA reads - The previous frame must be out first
+        esp_err_t err = wait_led_string_channels();
+
+        // led_strip keeps its own copy in the LED color order - Only pixels which changed need to be updated before sending it
+        for (uint32_t channelIndex = 0; (channelIndex < s_led_string_channel_count) && (err == ESP_OK); channelIndex++) {
+            led_string_channel_t* channel = &s_led_string_channels[channelIndex];
+            const uint32_t first = firstIndex > channel->firstIndex ? firstIndex : channel->firstIndex;
+            const uint32_t end = firstIndex + pixelCount < channel->firstIndex + channel->ledCount ? firstIndex + pixelCount : channel->firstIndex + channel->ledCount;
+            for (uint32_t index = first; (index < end) && (err == ESP_OK); index++) {
+                const uint8_t* pixel = &pixels[(index - firstIndex) * 3];
+                err = led_strip_set_pixel(channel->handle, index - channel->firstIndex, pixel[0], pixel[1], pixel[2]);
+            }
+        }
+
+        // Every channel sends its segment at the same time
+        if (err == ESP_OK) {
+            s_led_string_blank = false;
+            err = start_led_string_channels_refresh();
+        }
+#if !CONFIG_HOLIDAYTREE_LEDS_ASYNC_TRANSMISSION
+        if (err == ESP_OK) {
+            err = wait_led_string_channels();
+        }
+#endif
+    _lock_release(&s_led_string_lock);
+
+    return err;
+}
+
+esp_err_t wait_led_string_transmission() {
+    _lock_acquire(&s_led_string_lock);
+        esp_err_t err = wait_led_string_channels();
+    _lock_release(&s_led_string_lock);
+
+    return err;
 }
 
 esp_err_t clear_led_string(void) {
-    return led_strip_clear(s_led_string_handle);
+    _lock_acquire(&s_led_string_lock);
+        // Nothing to send when every LED is already off
+        esp_err_t err = ESP_OK;
+        if (!s_led_string_blank) {
+            err = wait_led_string_channels();
+            for (uint32_t channelIndex = 0; (channelIndex < s_led_string_channel_count) && (err == ESP_OK); channelIndex++) {
+                err = led_strip_clear(s_led_string_channels[channelIndex].handle);
+            }
+            s_led_string_blank = err == ESP_OK;
+        }
+    _lock_release(&s_led_string_lock);
+
+    return err;
+}
+
+esp_err_t resend_led_string(bool oneChannelAtATime) {
+    _lock_acquire(&s_led_string_lock);
+        esp_err_t err = wait_led_string_channels();
+        if (oneChannelAtATime) {
+            for (uint32_t channelIndex = 0; (channelIndex < s_led_string_channel_count) && (err == ESP_OK); channelIndex++) {
+                err = led_strip_refresh(s_led_string_channels[channelIndex].handle);
+            }
+        } else {
+            if (err == ESP_OK) {
+                err = start_led_string_channels_refresh();
+            }
+            if (err == ESP_OK) {
+                err = wait_led_string_channels();
+            }
+        }
+    _lock_release(&s_led_string_lock);
+
+    return err;
+}
+
+uint32_t get_led_string_channel_count() {
+    return s_led_string_channel_count;
+}
+
+uint32_t get_led_string_wire_time_us(uint32_t ledCount) {
+    return (ledCount * Ws2812LedWireTimeNs) / 1000 + Ws2812ResetTimeUs;
+}
+
+bool is_led_string_blank() {
+    return s_led_string_blank;
+}
+
+static esp_err_t start_led_string_channels_refresh() {
+    // Returns while the DMA or RMT shifts the frames out
+    for (uint32_t channelIndex = 0; channelIndex < s_led_string_channel_count; channelIndex++) {
+        led_string_channel_t* channel = &s_led_string_channels[channelIndex];
+        esp_err_t err = led_strip_refresh_async(channel->handle);
+        if (err != ESP_OK) {
+            return err;
+        }
+        channel->transmitting = true;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t wait_led_string_channels() {
+    // Every channel is waited for, even after a failure, so none is left transmitting
+    esp_err_t result = ESP_OK;
+    for (uint32_t channelIndex = 0; channelIndex < s_led_string_channel_count; channelIndex++) {
+        led_string_channel_t* channel = &s_led_string_channels[channelIndex];
+        if (channel->transmitting) {
+            channel->transmitting = false;
+            esp_err_t err = led_strip_refresh_wait_done(channel->handle);
+            if (result == ESP_OK) {
+                result = err;
+            }
+        }
+    }
+
+    return result;
 }
\ No newline at end of file
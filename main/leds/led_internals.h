@@ -4,23 +4,62 @@
 
 #pragma once
 
+#include <stdbool.h>
+
 #include <esp_err.h>
 #include <driver/gpio.h>
 
+#include "led_strip.h"
+
 
 typedef enum {
     LedStringOff = 0,
     LedStringOn = 1
 } led_string_state_t;
 
+typedef enum {
+    LedStringBackendSpi = 0,
+    LedStringBackendRmt = 1
+} led_string_backend_t;
+
 
 extern const char* LedStringTag;
 
 
+// -----------------------------------------------------------------------------------
+// The logical LED string is split in CONFIG_HOLIDAYTREE_LEDS_CHANNELS equal segments, each driven by its own output
+// channel (SPI2, SPI3 then RMT, or RMT only with CONFIG_HOLIDAYTREE_LEDS_BACKEND_RMT) - Channels transmit their
+// segments at the same time so the wire time of a frame is the one of the longest segment. Functions below address
+// the logical string
+// -----------------------------------------------------------------------------------
+
+
 esp_err_t create_led_string(gpio_num_t dataPin, gpio_num_t onOffPin, uint32_t ledCount);
 
+// One led_strip device for 'ledCount' WS2812 LEDs on 'dataPin' - 'spiHost' is only used by the SPI backend
+esp_err_t create_led_strip_device(led_string_backend_t backend, spi_host_device_t spiHost, gpio_num_t dataPin, uint32_t ledCount, led_strip_handle_t* handle);
+
 esp_err_t set_led_string_on_off(led_string_state_t onOff);
 
 esp_err_t set_led_string_pixel(uint32_t index, uint32_t red, uint32_t green, uint32_t blue);
 esp_err_t refresh_led_string();
-esp_err_t clear_led_string();
\ No newline at end of file
+esp_err_t clear_led_string();
+
+// Update pixels 'firstIndex' to 'firstIndex + pixelCount - 1' from packed RGB (3 bytes per pixel) then send the whole string
+//  * With CONFIG_HOLIDAYTREE_LEDS_ASYNC_TRANSMISSION this returns as soon as the DMA transfer is started - Every other
+//    function of the LED string waits for it to complete first
+esp_err_t write_led_string_pixels(const uint8_t* pixels, uint32_t firstIndex, uint32_t pixelCount);
+
+// Wait for the frame started by write_led_string_pixels() to be on the LEDs - Returns its transmission outcome
+esp_err_t wait_led_string_transmission();
+
+// Send the current content again, on every channel at once or one channel after the other - Benchmarks only
+esp_err_t resend_led_string(bool oneChannelAtATime);
+
+uint32_t get_led_string_channel_count();
+
+// Time needed to shift a frame out to 'ledCount' WS2812 LEDs, reset included - Bounds the frame rate of any renderer
+uint32_t get_led_string_wire_time_us(uint32_t ledCount);
+
+// True when the string is powered and was cleared since anything else was sent - clear_led_string() sends nothing then
+bool is_led_string_blank();
\ No newline at end of file
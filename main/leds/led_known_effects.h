@@ -6,6 +6,16 @@
 
 typedef enum {
     LedProgressiveRevealEffect = 1,
+    LedBeatFlashEffect = 2,
+    LedLayeredBeatFlashEffect = 3,
+    LedTwinkleEffect = 4,
+    LedFireEffect = 5,
+    LedCandleEffect = 6,
+    LedColorWheelEffect = 7,
+    LedSnowfallEffect = 8,
+    LedShimmerEffect = 9,
+    LedShowPlayerEffect = 10,
+    LedProgramEffect = 11,
 
     LedEffectMax
 } led_known_effects_t;
@@ -0,0 +1,217 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include "leds/led_math.h"
+
+
+// sin() over a quarter turn, 64 steps - Q15
+static const int16_t QuarterSine[65] = {
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+     6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767
+};
+
+// Noise lattice hash - Ken Perlin's permutation of 0 to 255
+static const uint8_t Permutation[256] = {
+    151, 160, 137,  91,  90,  15, 131,  13, 201,  95,  96,  53, 194, 233,   7, 225,
+    140,  36, 103,  30,  69, 142,   8,  99,  37, 240,  21,  10,  23, 190,   6, 148,
+    247, 120, 234,  75,   0,  26, 197,  62,  94, 252, 219, 203, 117,  35,  11,  32,
+     57, 177,  33,  88, 237, 149,  56,  87, 174,  20, 125, 136, 171, 168,  68, 175,
+     74, 165,  71, 134, 139,  48,  27, 166,  77, 146, 158, 231,  83, 111, 229, 122,
+     60, 211, 133, 230, 220, 105,  92,  41,  55,  46, 245,  40, 244, 102, 143,  54,
+     65,  25,  63, 161,   1, 216,  80,  73, 209,  76, 132, 187, 208,  89,  18, 169,
+    200, 196, 135, 130, 116, 188, 159,  86, 164, 100, 109, 198, 173, 186,   3,  64,
+     52, 217, 226, 250, 124, 123,   5, 202,  38, 147, 118, 126, 255,  82,  85, 212,
+    207, 206,  59, 227,  47,  16,  58,  17, 182, 189,  28,  42, 223, 183, 170, 213,
+    119, 248, 152,   2,  44, 154, 163,  70, 221, 153, 101, 155, 167,  43, 172,   9,
+    129,  22,  39, 253,  19,  98, 108, 110,  79, 113, 224, 232, 178, 185, 112, 104,
+    218, 246,  97, 228, 251,  34, 242, 193, 238, 210, 144,  12, 191, 179, 162, 241,
+     81,  51, 145, 235, 249,  14, 239, 107,  49, 192, 214,  31, 181, 199, 106, 157,
+    184,  84, 204, 176, 115, 121,  50,  45, 127,   4, 150, 254, 138, 236, 205,  93,
+    222, 114,  67,  29,  24,  72, 243, 141, 128, 195,  78,  66, 215,  61, 156, 180
+};
+
+// Simplex skew and unskew factors - (sqrt(3) - 1) / 2 in Q31, (3 - sqrt(3)) / 6 and 1/6 in Q16. The 3D skew divides by 3
+static const int64_t Skew2 = 786033569;
+static const int32_t Unskew2 = 13849;
+static const int32_t Unskew3 = 10923;
+
+// Skewed lattice coordinates wrap every 256 cells, where the permutation repeats - Q8
+static const uint32_t LatticeMask = 0xFFFF;
+
+
+static int32_t get_noise_corner_2d(int32_t x, int32_t y, uint32_t hash);
+static int32_t get_noise_corner_3d(int32_t x, int32_t y, int32_t z, uint32_t hash);
+
+
+uint8_t led_sin8(uint8_t angle) {
+    return (uint8_t) (128 + (led_sin16((uint16_t) (angle << 8)) >> 8));
+}
+
+uint8_t led_cos8(uint8_t angle) {
+    return led_sin8((uint8_t) (angle + 64));
+}
+
+int16_t led_sin16(uint16_t angle) {
+    // Quarter turn, 6 bits of table index then 8 bits of fraction - Mirrored on the second and fourth quarters
+    uint32_t offset = angle & 0x3FFF;
+    if (angle & 0x4000) {
+        offset = 0x4000 - offset;
+    }
+    const uint32_t index = offset >> 8;
+    const int32_t fraction = (int32_t) (offset & 0xFF);
+    int32_t value = QuarterSine[index];
+    if (fraction != 0) {
+        value += ((QuarterSine[index + 1] - value) * fraction) >> 8;
+    }
+    return (int16_t) ((angle & 0x8000) ? -value : value);
+}
+
+int16_t led_cos16(uint16_t angle) {
+    return led_sin16((uint16_t) (angle + 0x4000));
+}
+
+int16_t led_noise_2d(int32_t x, int32_t y) {
+    // Skewed lattice position in 64 bits, wrapped to the lattice period - Then the cell and the position in the cell, Q8
+    const int64_t skew = (((int64_t) x + y) * Skew2) >> 31;
+    const uint32_t skewedX = (uint32_t) (x + skew) & LatticeMask;
+    const uint32_t skewedY = (uint32_t) (y + skew) & LatticeMask;
+    const uint32_t ii = skewedX >> 8;
+    const uint32_t jj = skewedY >> 8;
+    const int32_t cellX = (int32_t) (skewedX & 0xFF);
+    const int32_t cellY = (int32_t) (skewedY & 0xFF);
+
+    // Position from the origin corner of the cell - Unskewed
+    const int32_t unskew = ((cellX + cellY) * Unskew2 + 32768) >> 16;
+    const int32_t x0 = cellX - unskew;
+    const int32_t y0 = cellY - unskew;
+
+    // The triangle the point is in - Lower or upper
+    const int32_t i1 = x0 > y0 ? 1 : 0;
+    const int32_t j1 = 1 - i1;
+    const int32_t g2 = (Unskew2 + 128) >> 8;
+
+    int32_t sum = get_noise_corner_2d(x0, y0, Permutation[(ii + Permutation[jj]) & 0xFF]);
+    sum += get_noise_corner_2d(x0 - i1 * LED_NOISE_CELL + g2, y0 - j1 * LED_NOISE_CELL + g2, Permutation[(ii + i1 + Permutation[(jj + j1) & 0xFF]) & 0xFF]);
+    sum += get_noise_corner_2d(x0 - LED_NOISE_CELL + 2 * g2, y0 - LED_NOISE_CELL + 2 * g2, Permutation[(ii + 1 + Permutation[(jj + 1) & 0xFF]) & 0xFF]);
+
+    // Q24 scaled by 70 to about [-1, 1], then to Q15
+    sum = (sum * 70) >> 9;
+    return (int16_t) (sum > 32767 ? 32767 : (sum < -32767 ? -32767 : sum));
+}
+
+int16_t led_noise_3d(int32_t x, int32_t y, int32_t z) {
+    // Exact skew, rounded down - A shift of LED_NOISE_3D_PERIOD along any axis moves every skewed coordinate by whole periods
+    const int64_t coordinateSum = (int64_t) x + y + z;
+    const int64_t skew = (coordinateSum >= 0 ? coordinateSum : coordinateSum - 2) / 3;
+    const uint32_t skewedX = (uint32_t) (x + skew) & LatticeMask;
+    const uint32_t skewedY = (uint32_t) (y + skew) & LatticeMask;
+    const uint32_t skewedZ = (uint32_t) (z + skew) & LatticeMask;
+    const uint32_t ii = skewedX >> 8;
+    const uint32_t jj = skewedY >> 8;
+    const uint32_t kk = skewedZ >> 8;
+    const int32_t cellX = (int32_t) (skewedX & 0xFF);
+    const int32_t cellY = (int32_t) (skewedY & 0xFF);
+    const int32_t cellZ = (int32_t) (skewedZ & 0xFF);
+
+    const int32_t unskew = ((cellX + cellY + cellZ) * Unskew3 + 32768) >> 16;
+    const int32_t x0 = cellX - unskew;
+    const int32_t y0 = cellY - unskew;
+    const int32_t z0 = cellZ - unskew;
+
+    // The tetrahedron the point is in - Second and third corners from the order of the coordinates
+    int32_t i1, j1, k1, i2, j2, k2;
+    if (x0 >= y0) {
+        if (y0 >= z0) {
+            i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 1; k2 = 0;
+        } else if (x0 >= z0) {
+            i1 = 1; j1 = 0; k1 = 0; i2 = 1; j2 = 0; k2 = 1;
+        } else {
+            i1 = 0; j1 = 0; k1 = 1; i2 = 1; j2 = 0; k2 = 1;
+        }
+    } else {
+        if (y0 < z0) {
+            i1 = 0; j1 = 0; k1 = 1; i2 = 0; j2 = 1; k2 = 1;
+        } else if (x0 < z0) {
+            i1 = 0; j1 = 1; k1 = 0; i2 = 0; j2 = 1; k2 = 1;
+        } else {
+            i1 = 0; j1 = 1; k1 = 0; i2 = 1; j2 = 1; k2 = 0;
+        }
+    }
+    const int32_t g3 = (Unskew3 + 128) >> 8;
+
+    int32_t sum = get_noise_corner_3d(x0, y0, z0, Permutation[(ii + Permutation[(jj + Permutation[kk]) & 0xFF]) & 0xFF]);
+    sum += get_noise_corner_3d(x0 - i1 * LED_NOISE_CELL + g3, y0 - j1 * LED_NOISE_CELL + g3, z0 - k1 * LED_NOISE_CELL + g3,
+        Permutation[(ii + i1 + Permutation[(jj + j1 + Permutation[(kk + k1) & 0xFF]) & 0xFF]) & 0xFF]);
+    sum += get_noise_corner_3d(x0 - i2 * LED_NOISE_CELL + 2 * g3, y0 - j2 * LED_NOISE_CELL + 2 * g3, z0 - k2 * LED_NOISE_CELL + 2 * g3,
+        Permutation[(ii + i2 + Permutation[(jj + j2 + Permutation[(kk + k2) & 0xFF]) & 0xFF]) & 0xFF]);
+    sum += get_noise_corner_3d(x0 - LED_NOISE_CELL / 2, y0 - LED_NOISE_CELL / 2, z0 - LED_NOISE_CELL / 2,
+        Permutation[(ii + 1 + Permutation[(jj + 1 + Permutation[(kk + 1) & 0xFF]) & 0xFF]) & 0xFF]);
+
+    // Q24 scaled by 32 to about [-1, 1], then to Q15
+    sum >>= 4;
+    return (int16_t) (sum > 32767 ? 32767 : (sum < -32767 ? -32767 : sum));
+}
+
+void get_led_hue_color(uint8_t hue, uint8_t value, uint8_t* red, uint8_t* green, uint8_t* blue) {
+    // Six sectors of 43 hue steps - One channel ramps while the other two hold
+    const uint32_t sector = (hue * 6U) >> 8;
+    const uint32_t ramp = ((hue * 6U) & 0xFF) * value >> 8;
+    const uint8_t rising = (uint8_t) ramp;
+    const uint8_t falling = (uint8_t) (value - ramp);
+    switch (sector) {
+        case 0: *red = value; *green = rising; *blue = 0; break;
+        case 1: *red = falling; *green = value; *blue = 0; break;
+        case 2: *red = 0; *green = value; *blue = rising; break;
+        case 3: *red = 0; *green = falling; *blue = value; break;
+        case 4: *red = rising; *green = 0; *blue = value; break;
+        default: *red = value; *green = 0; *blue = falling; break;
+    }
+}
+
+static int32_t get_noise_corner_2d(int32_t x, int32_t y, uint32_t hash) {
+    // (0.5 - d^2)^4 times the gradient dot product - Q16 falloff, Q8 offsets
+    int32_t falloff = 32768 - x * x - y * y;
+    if (falloff <= 0) {
+        return 0;
+    }
+    falloff = (falloff * falloff) >> 16;
+    falloff = (falloff * falloff) >> 16;
+
+    // Eight gradients - The diagonals and the axes
+    int32_t dot;
+    switch (hash & 7) {
+        case 0: dot = x + y; break;
+        case 1: dot = -x + y; break;
+        case 2: dot = x - y; break;
+        case 3: dot = -x - y; break;
+        case 4: dot = x; break;
+        case 5: dot = -x; break;
+        case 6: dot = y; break;
+        default: dot = -y; break;
+    }
+    return falloff * dot;
+}
+
+static int32_t get_noise_corner_3d(int32_t x, int32_t y, int32_t z, uint32_t hash) {
+    // (0.6 - d^2)^4 times the gradient dot product - Q16 falloff, Q8 offsets
+    int32_t falloff = 39322 - x * x - y * y - z * z;
+    if (falloff <= 0) {
+        return 0;
+    }
+    falloff = (falloff * falloff) >> 16;
+    falloff = (falloff * falloff) >> 16;
+
+    // The twelve cube edge gradients, four of them twice
+    const uint32_t h = hash & 15;
+    const int32_t u = h < 8 ? x : y;
+    const int32_t v = h < 4 ? y : ((h == 12) || (h == 14) ? x : z);
+    return falloff * (((h & 1) ? -u : u) + ((h & 2) ? -v : v));
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+
+// -----------------------------------------------------------------------------------
+// Integer primitives for procedural LED effects - No floating point, no allocation
+//
+//  * xorshift32 pseudo random generator - Its state is a word of the effect state, so effects do not share a sequence
+//  * Sine and cosine from a quarter wave table - 8 bits angles (256 per turn, like LED geometry angles) and 16 bits angles
+//  * Simplex noise in 2 and 3 dimensions - Coordinates are Q8 fixed point (256 is one noise cell), values are signed 16 bits
+// -----------------------------------------------------------------------------------
+
+// One noise cell in noise coordinates
+#define LED_NOISE_CELL 256
+
+// 3D noise repeats every 768 cells along x, y and z - Time coordinates wrapped there never jump
+#define LED_NOISE_3D_PERIOD (768 * LED_NOISE_CELL)
+
+
+// Seed 'state' - Any seed, 0 included, gives a valid sequence
+static inline void seed_led_random(uint32_t* state, uint32_t seed) {
+    *state = seed != 0 ? seed : 0x9E3779B9U;
+}
+
+static inline uint32_t next_led_random(uint32_t* state) {
+    uint32_t value = *state;
+    value ^= value << 13;
+    value ^= value >> 17;
+    value ^= value << 5;
+    *state = value;
+    return value;
+}
+
+// Uniform in [0, bound) - bound <= 65536
+static inline uint32_t next_led_random_below(uint32_t* state, uint32_t bound) {
+    return ((next_led_random(state) >> 16) * bound) >> 16;
+}
+
+
+// 0 to 255, 128 at angle 0 - 'angle' in 256th of a turn
+uint8_t led_sin8(uint8_t angle);
+uint8_t led_cos8(uint8_t angle);
+
+// -32767 to 32767 - 'angle' in 65536th of a turn, linearly interpolated between 256 table entries per turn
+int16_t led_sin16(uint16_t angle);
+int16_t led_cos16(uint16_t angle);
+
+// About -32767 to 32767, smooth over a cell - Any int32 coordinate. Repeats every 256 cells along each skewed lattice axis,
+// which is every LED_NOISE_3D_PERIOD along the axes in 3D. 2D noise has no period along its axes: it jumps where callers wrap
+int16_t led_noise_2d(int32_t x, int32_t y);
+int16_t led_noise_3d(int32_t x, int32_t y, int32_t z);
+
+// Fully saturated color of 'hue' (0 red, 85 green, 170 blue) at 'value' brightness
+void get_led_hue_color(uint8_t hue, uint8_t value, uint8_t* red, uint8_t* green, uint8_t* blue);
\ No newline at end of file
@@ -0,0 +1,546 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/lock.h>
+
+#include <esp_check.h>
+#include <esp_console.h>
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+
+#include "sdkconfig.h"
+
+#include "configuration/nvs_configuration.h"
+
+#include "leds/led_internals.h"
+#include "leds/led_geometry.h"
+#include "leds/led_math.h"
+#include "leds/led_program.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+
+// Stored program - Version and instruction count then the instructions
+typedef struct led_program_blob_header {
+    uint16_t version;
+    uint16_t instructionCount;
+} __attribute__ ((__packed__)) led_program_blob_header_t;
+
+
+// NVS namespace and key of the LED program
+static const char LedProgramNamespace[NVS_NS_NAME_MAX_SIZE] = "led_program";
+static const char LedProgramKey[NVS_KEY_NAME_MAX_SIZE] = "program";
+
+// Version of the stored program
+static const uint16_t CurrentProgramVersion = 1;
+
+// Operands of each instruction - Checked when a program is loaded
+#define OPERAND_D 0x01
+#define OPERAND_A 0x02
+#define OPERAND_B 0x04
+#define OPERAND_TARGET 0x08
+
+static const uint8_t LedProgramOperands[LedProgramOpMax] = {
+    [LedProgramOpEnd] = 0,
+    [LedProgramOpLoad] = OPERAND_D,
+    [LedProgramOpMove] = OPERAND_D | OPERAND_A,
+    [LedProgramOpAdd] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpSubtract] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpMultiply] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpScale] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpDivide] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpModulo] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpMinimum] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpMaximum] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpAnd] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpOr] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpXor] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpShiftLeft] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpShiftRight] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpAddImmediate] = OPERAND_D | OPERAND_A,
+    [LedProgramOpSine] = OPERAND_D | OPERAND_A,
+    [LedProgramOpNoise] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpNoise3] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpRandom] = OPERAND_D,
+    [LedProgramOpJump] = OPERAND_TARGET,
+    [LedProgramOpJumpZero] = OPERAND_TARGET | OPERAND_A,
+    [LedProgramOpJumpNotZero] = OPERAND_TARGET | OPERAND_A,
+    [LedProgramOpJumpLess] = OPERAND_TARGET | OPERAND_A | OPERAND_B,
+    [LedProgramOpRgb] = OPERAND_D | OPERAND_A | OPERAND_B,
+    [LedProgramOpHue] = OPERAND_D | OPERAND_A
+};
+
+#if CONFIG_HOLIDAYTREE_CONSOLE
+// Mnemonics - Must match tools/build_led_program.py
+static const char* const LedProgramOpNames[LedProgramOpMax] = {
+    "end", "ldi", "mov", "add", "sub", "mul", "scale", "div", "mod", "min", "max", "and", "or", "xor", "shl", "shr",
+    "addi", "sin", "noise", "noise3", "rand", "jmp", "jz", "jnz", "jlt", "rgb", "hue"
+};
+#endif
+
+
+// Rainbow turning around the tree and rising up it
+static const led_program_instruction_t RainbowProgram[] = {
+    { LedProgramOpLoad, 11, 3, 0 },             //  0 ldi r11, 3
+    { LedProgramOpShiftRight, 10, 5, 11 },      //  1 shr r10, r5, r11      - Time / 8
+    { LedProgramOpAdd, 10, 10, 4 },             //  2 add r10, r10, r4      - Around the tree
+    { LedProgramOpLoad, 11, 1, 0 },             //  3 ldi r11, 1
+    { LedProgramOpShiftRight, 12, 3, 11 },      //  4 shr r12, r3, r11
+    { LedProgramOpAdd, 10, 10, 12 },            //  5 add r10, r10, r12     - Half a turn of hue up the tree
+    { LedProgramOpLoad, 11, 255, 0 },           //  6 ldi r11, 255
+    { LedProgramOpHue, 10, 11, 0 }              //  7 hue r10, r11
+};
+
+// Green and blue noise drifting over the tree, brighter with the music
+static const led_program_instruction_t AuroraProgram[] = {
+    { LedProgramOpLoad, 11, 2, 0 },             //  0 ldi r11, 2
+    { LedProgramOpShiftRight, 10, 5, 11 },      //  1 shr r10, r5, r11      - Noise time, a cell per second
+    { LedProgramOpShiftLeft, 12, 1, 11 },       //  2 shl r12, r1, r11      - Four cells across the tree
+    { LedProgramOpShiftLeft, 13, 3, 11 },       //  3 shl r13, r3, r11      - Four cells up the tree
+    { LedProgramOpNoise3, 10, 12, 13 },         //  4 noise3 r10, r12, r13
+    { LedProgramOpLoad, 11, 1, 0 },             //  5 ldi r11, 1
+    { LedProgramOpShiftRight, 14, 10, 11 },     //  6 shr r14, r10, r11
+    { LedProgramOpAddImmediate, 14, 14, 96 },   //  7 addi r14, r14, 96     - Green to blue
+    { LedProgramOpMaximum, 15, 10, 7 },         //  8 max r15, r10, r7      - Lifted by the loudest band
+    { LedProgramOpScale, 15, 15, 15 },          //  9 scale r15, r15, r15   - Squared, dark between the bands
+    { LedProgramOpHue, 14, 15, 0 }              // 10 hue r14, r15
+};
+
+// Three sine waves moving down the tree, summed in a loop, pushed up by the bass
+static const led_program_instruction_t RippleProgram[] = {
+    { LedProgramOpLoad, 11, 3, 0 },             //  0 ldi r11, 3            - Wave count
+    { LedProgramOpLoad, 14, 3, 0 },             //  1 ldi r14, 3
+    { LedProgramOpShiftRight, 13, 5, 14 },      //  2 shr r13, r5, r14      - Time / 8
+    { LedProgramOpMultiply, 12, 3, 11 },        //  3 mul r12, r3, r11      - Loop: wave r11 has r11 periods up the tree
+    { LedProgramOpAdd, 12, 12, 13 },            //  4 add r12, r12, r13
+    { LedProgramOpSine, 12, 12, 0 },            //  5 sin r12, r12
+    { LedProgramOpAdd, 10, 10, 12 },            //  6 add r10, r10, r12
+    { LedProgramOpAddImmediate, 11, 11, 0xFF }, //  7 addi r11, r11, -1
+    { LedProgramOpJumpNotZero, 3, 11, 0 },      //  8 jnz r11, 3
+    { LedProgramOpLoad, 14, 85, 0 },            //  9 ldi r14, 85
+    { LedProgramOpScale, 10, 10, 14 },          // 10 scale r10, r10, r14   - Average of the waves
+    { LedProgramOpMaximum, 10, 10, 6 },         // 11 max r10, r10, r6
+    { LedProgramOpHue, 4, 10, 0 }               // 12 hue r4, r10           - Hue around the tree
+};
+
+static const led_builtin_program_t LedBuiltinPrograms[] = {
+    { .name = "rainbow", .instructions = RainbowProgram, .instructionCount = sizeof(RainbowProgram) / sizeof(RainbowProgram[0]) },
+    { .name = "aurora", .instructions = AuroraProgram, .instructionCount = sizeof(AuroraProgram) / sizeof(AuroraProgram[0]) },
+    { .name = "ripple", .instructions = RippleProgram, .instructionCount = sizeof(RippleProgram) / sizeof(RippleProgram[0]) }
+};
+
+
+// Two program slots - The current program runs from one, the console task stages the next one in the other. The program
+// effect holds s_led_program_lock for a whole frame, the console task to write a slot and publish it: a slot is never
+// staged over while a frame still runs from it
+static led_program_instruction_t s_led_program_code[2][LED_PROGRAM_MAX_INSTRUCTIONS];
+static led_program_t s_led_programs[2] = { 0 };
+static uint32_t s_led_program_slot = 0;
+static uint32_t s_led_program_staged_count = 0;
+static _Atomic(const led_program_t*) s_atomic_led_program = NULL;
+static _lock_t s_led_program_lock;
+
+
+static esp_err_t read_led_program();
+static void publish_led_program(uint32_t slot);
+
+static inline uint8_t clamp_level(int32_t level) {
+    return (uint8_t) (level < 0 ? 0 : (level > 255 ? 255 : level));
+}
+
+
+esp_err_t load_led_program_code(const led_program_instruction_t* instructions, uint32_t instructionCount, led_program_t* program) {
+    ESP_RETURN_ON_FALSE((instructions != NULL) && (program != NULL), ESP_ERR_INVALID_ARG, LedStringTag, "load_led_program_code() - instructions and program cannot be NULL");
+    ESP_RETURN_ON_FALSE((instructionCount > 0) && (instructionCount <= LED_PROGRAM_MAX_INSTRUCTIONS), ESP_ERR_INVALID_SIZE, LedStringTag, "load_led_program_code() - Invalid instruction count %"PRIu32, instructionCount);
+
+    // Every operand the interpreter uses is checked here, once - Jumps may target the end of the program
+    for (uint32_t index = 0; index < instructionCount; index++) {
+        const led_program_instruction_t* instruction = &instructions[index];
+        ESP_RETURN_ON_FALSE(instruction->op < LedProgramOpMax, ESP_ERR_INVALID_ARG, LedStringTag, "load_led_program_code() - Unknown opcode %u at %"PRIu32, instruction->op, index);
+
+        const uint8_t operands = LedProgramOperands[instruction->op];
+        const bool valid = (!(operands & OPERAND_D) || (instruction->d < LED_PROGRAM_REGISTER_COUNT)) &&
+            (!(operands & OPERAND_A) || (instruction->a < LED_PROGRAM_REGISTER_COUNT)) &&
+            (!(operands & OPERAND_B) || (instruction->b < LED_PROGRAM_REGISTER_COUNT)) &&
+            (!(operands & OPERAND_TARGET) || (instruction->d <= instructionCount));
+        ESP_RETURN_ON_FALSE(valid, ESP_ERR_INVALID_ARG, LedStringTag, "load_led_program_code() - Invalid operand at %"PRIu32, index);
+    }
+
+    program->instructions = instructions;
+    program->instructionCount = instructionCount;
+    return ESP_OK;
+}
+
+void run_led_program(const led_program_t* program, const led_program_frame_t* frame, uint32_t* random, led_framebuffer_t* framebuffer) {
+    // The map covers the string - Longer framebuffers (benchmarks) get the fallback positions
+    const led_position_t* positions = get_led_positions(framebuffer->pixelCount);
+    const led_program_instruction_t* const code = program->instructions;
+    const uint32_t instructionCount = program->instructionCount;
+    const uint32_t ledCount = framebuffer->pixelCount;
+
+    uint8_t* pixel = framebuffer->pixels;
+    for (uint32_t index = 0; index < ledCount; index++, pixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        const led_position_t position = get_led_position(positions, index, ledCount);
+        int32_t r[LED_PROGRAM_REGISTER_COUNT] = {
+            (int32_t) index, position.x, position.y, position.height, position.angle,
+            frame->timeMs, frame->bassLevel, frame->level, frame->beatPhase, frame->beatCount
+        };
+        pixel[0] = 0;
+        pixel[1] = 0;
+        pixel[2] = 0;
+
+        // Operands were checked by load_led_program_code() - Arithmetic wraps on unsigned values, division guards 0 and
+        // INT32_MIN / -1, and the noise primitives take any coordinate: no register value is undefined behaviour
+        uint32_t pc = 0;
+        for (uint32_t steps = 0; (pc < instructionCount) && (steps < LED_PROGRAM_MAX_STEPS); steps++) {
+            const led_program_instruction_t instruction = code[pc++];
+            switch (instruction.op) {
+                case LedProgramOpLoad:
+                    r[instruction.d] = (int16_t) (instruction.a | (instruction.b << 8));
+                    break;
+                case LedProgramOpMove:
+                    r[instruction.d] = r[instruction.a];
+                    break;
+                case LedProgramOpAdd:
+                    r[instruction.d] = (int32_t) ((uint32_t) r[instruction.a] + (uint32_t) r[instruction.b]);
+                    break;
+                case LedProgramOpSubtract:
+                    r[instruction.d] = (int32_t) ((uint32_t) r[instruction.a] - (uint32_t) r[instruction.b]);
+                    break;
+                case LedProgramOpMultiply:
+                    r[instruction.d] = (int32_t) ((uint32_t) r[instruction.a] * (uint32_t) r[instruction.b]);
+                    break;
+                case LedProgramOpScale:
+                    r[instruction.d] = (int32_t) (((int64_t) r[instruction.a] * r[instruction.b]) >> 8);
+                    break;
+                case LedProgramOpDivide:
+                    // INT32_MIN / -1 overflows - Negate instead
+                    r[instruction.d] = r[instruction.b] == 0 ? 0 : (r[instruction.b] == -1 ? (int32_t) (0U - (uint32_t) r[instruction.a]) : r[instruction.a] / r[instruction.b]);
+                    break;
+                case LedProgramOpModulo:
+                    r[instruction.d] = (r[instruction.b] == 0) || (r[instruction.b] == -1) ? 0 : r[instruction.a] % r[instruction.b];
+                    break;
+                case LedProgramOpMinimum:
+                    r[instruction.d] = r[instruction.a] < r[instruction.b] ? r[instruction.a] : r[instruction.b];
+                    break;
+                case LedProgramOpMaximum:
+                    r[instruction.d] = r[instruction.a] > r[instruction.b] ? r[instruction.a] : r[instruction.b];
+                    break;
+                case LedProgramOpAnd:
+                    r[instruction.d] = r[instruction.a] & r[instruction.b];
+                    break;
+                case LedProgramOpOr:
+                    r[instruction.d] = r[instruction.a] | r[instruction.b];
+                    break;
+                case LedProgramOpXor:
+                    r[instruction.d] = r[instruction.a] ^ r[instruction.b];
+                    break;
+                case LedProgramOpShiftLeft:
+                    r[instruction.d] = (int32_t) ((uint32_t) r[instruction.a] << (r[instruction.b] & 31));
+                    break;
+                case LedProgramOpShiftRight:
+                    r[instruction.d] = r[instruction.a] >> (r[instruction.b] & 31);
+                    break;
+                case LedProgramOpAddImmediate:
+                    r[instruction.d] = (int32_t) ((uint32_t) r[instruction.a] + (uint32_t) (int8_t) instruction.b);
+                    break;
+                case LedProgramOpSine:
+                    r[instruction.d] = led_sin8((uint8_t) r[instruction.a]);
+                    break;
+                case LedProgramOpNoise:
+                    r[instruction.d] = 128 + (led_noise_2d(r[instruction.a], r[instruction.b]) >> 8);
+                    break;
+                case LedProgramOpNoise3:
+                    r[instruction.d] = 128 + (led_noise_3d(r[instruction.a], r[instruction.b], r[instruction.d]) >> 8);
+                    break;
+                case LedProgramOpRandom:
+                    r[instruction.d] = (int32_t) (next_led_random(random) >> 24);
+                    break;
+                case LedProgramOpJump:
+                    pc = instruction.d;
+                    break;
+                case LedProgramOpJumpZero:
+                    pc = r[instruction.a] == 0 ? instruction.d : pc;
+                    break;
+                case LedProgramOpJumpNotZero:
+                    pc = r[instruction.a] != 0 ? instruction.d : pc;
+                    break;
+                case LedProgramOpJumpLess:
+                    pc = r[instruction.a] < r[instruction.b] ? instruction.d : pc;
+                    break;
+                case LedProgramOpRgb:
+                    pixel[0] = clamp_level(r[instruction.d]);
+                    pixel[1] = clamp_level(r[instruction.a]);
+                    pixel[2] = clamp_level(r[instruction.b]);
+                    break;
+                case LedProgramOpHue:
+                    get_led_hue_color((uint8_t) r[instruction.d], clamp_level(r[instruction.a]), &pixel[0], &pixel[1], &pixel[2]);
+                    break;
+                case LedProgramOpEnd:
+                default:
+                    pc = instructionCount;
+                    break;
+            }
+        }
+    }
+}
+
+uint32_t get_led_builtin_program_count() {
+    return sizeof(LedBuiltinPrograms) / sizeof(LedBuiltinPrograms[0]);
+}
+
+const led_builtin_program_t* get_led_builtin_program(uint32_t index) {
+    return index < get_led_builtin_program_count() ? &LedBuiltinPrograms[index] : NULL;
+}
+
+esp_err_t load_led_program() {
+    // A missing or invalid program is not an error - The first built in program runs instead
+    esp_err_t err = read_led_program();
+    if (err != ESP_OK) {
+        ESP_LOGI(LedStringTag, "No LED program in NVS (%d) - Running built in program '%s'", err, LedBuiltinPrograms[0].name);
+        return select_led_builtin_program(0);
+    }
+
+    return ESP_OK;
+}
+
+const led_program_t* get_led_program() {
+    return atomic_load(&s_atomic_led_program);
+}
+
+bool run_current_led_program(const led_program_frame_t* frame, uint32_t* random, led_framebuffer_t* framebuffer) {
+    _lock_acquire(&s_led_program_lock);
+        const led_program_t* program = get_led_program();
+        if (program != NULL) {
+            run_led_program(program, frame, random, framebuffer);
+        }
+    _lock_release(&s_led_program_lock);
+
+    return program != NULL;
+}
+
+void begin_led_program() {
+    s_led_program_staged_count = 0;
+}
+
+esp_err_t add_led_program_instructions(const led_program_instruction_t* instructions, uint32_t instructionCount) {
+    ESP_RETURN_ON_FALSE(s_led_program_staged_count + instructionCount <= LED_PROGRAM_MAX_INSTRUCTIONS, ESP_ERR_INVALID_SIZE, LedStringTag, "add_led_program_instructions() - Programs have at most %d instructions", LED_PROGRAM_MAX_INSTRUCTIONS);
+
+    _lock_acquire(&s_led_program_lock);
+        const uint32_t slot = s_led_program_slot ^ 1;
+        memcpy(&s_led_program_code[slot][s_led_program_staged_count], instructions, instructionCount * sizeof(led_program_instruction_t));
+        s_led_program_staged_count += instructionCount;
+    _lock_release(&s_led_program_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t commit_led_program() {
+    _lock_acquire(&s_led_program_lock);
+        const uint32_t slot = s_led_program_slot ^ 1;
+        esp_err_t err = load_led_program_code(s_led_program_code[slot], s_led_program_staged_count, &s_led_programs[slot]);
+        if (err == ESP_OK) {
+            publish_led_program(slot);
+        }
+    _lock_release(&s_led_program_lock);
+
+    ESP_RETURN_ON_ERROR(err, LedStringTag, "commit_led_program() - Invalid program");
+    return ESP_OK;
+}
+
+esp_err_t select_led_builtin_program(uint32_t index) {
+    const led_builtin_program_t* builtin = get_led_builtin_program(index);
+    ESP_RETURN_ON_FALSE(builtin != NULL, ESP_ERR_INVALID_ARG, LedStringTag, "select_led_builtin_program() - Invalid program index %"PRIu32, index);
+
+    // Built in programs run straight from flash
+    _lock_acquire(&s_led_program_lock);
+        const uint32_t slot = s_led_program_slot ^ 1;
+        esp_err_t err = load_led_program_code(builtin->instructions, builtin->instructionCount, &s_led_programs[slot]);
+        if (err == ESP_OK) {
+            publish_led_program(slot);
+        }
+    _lock_release(&s_led_program_lock);
+
+    ESP_RETURN_ON_ERROR(err, LedStringTag, "select_led_builtin_program() - Invalid program");
+    return ESP_OK;
+}
+
+esp_err_t save_led_program() {
+    const led_program_t* program = get_led_program();
+    ESP_RETURN_ON_FALSE(program != NULL, ESP_ERR_INVALID_STATE, LedStringTag, "save_led_program() - load_led_program() must be called first");
+
+    const size_t blobSize = sizeof(led_program_blob_header_t) + program->instructionCount * LED_PROGRAM_INSTRUCTION_SIZE;
+    uint8_t* blob = heap_caps_malloc(blobSize, MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(blob != NULL, ESP_ERR_NO_MEM, LedStringTag, "save_led_program() - Not enough memory");
+
+    const led_program_blob_header_t header = { .version = CurrentProgramVersion, .instructionCount = (uint16_t) program->instructionCount };
+    memcpy(blob, &header, sizeof(header));
+    memcpy(&blob[sizeof(header)], program->instructions, program->instructionCount * LED_PROGRAM_INSTRUCTION_SIZE);
+
+    esp_err_t err = nvs_set_configuration(LedProgramNamespace, LedProgramKey, blob, blobSize);
+    heap_caps_free(blob);
+    return err;
+}
+
+esp_err_t reset_led_program() {
+    ESP_RETURN_ON_ERROR(select_led_builtin_program(0), LedStringTag, "reset_led_program() - select_led_builtin_program() failed");
+
+    esp_err_t err = nvs_erase_configuration(LedProgramNamespace, LedProgramKey);
+    return err == ESP_ERR_NVS_NOT_FOUND ? ESP_OK : err;
+}
+
+static esp_err_t read_led_program() {
+    const size_t maximumSize = sizeof(led_program_blob_header_t) + LED_PROGRAM_MAX_INSTRUCTIONS * LED_PROGRAM_INSTRUCTION_SIZE;
+    uint8_t* blob = heap_caps_malloc(maximumSize, MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(blob != NULL, ESP_ERR_NO_MEM, LedStringTag, "read_led_program() - Not enough memory");
+
+    size_t blobSize = maximumSize;
+    esp_err_t err = nvs_get_configuration(LedProgramNamespace, LedProgramKey, blob, &blobSize);
+    led_program_blob_header_t header = { 0 };
+    if (err == ESP_OK) {
+        memcpy(&header, blob, sizeof(header));
+        if ((blobSize < sizeof(header)) || (header.version != CurrentProgramVersion) || (blobSize != sizeof(header) + header.instructionCount * LED_PROGRAM_INSTRUCTION_SIZE)) {
+            err = ESP_ERR_INVALID_VERSION;
+        }
+    }
+
+    // Staged then committed like a program sent from the console - Checked before it runs
+    if (err == ESP_OK) {
+        begin_led_program();
+        err = add_led_program_instructions((const led_program_instruction_t*) &blob[sizeof(header)], header.instructionCount);
+    }
+    if (err == ESP_OK) {
+        err = commit_led_program();
+    }
+
+    heap_caps_free(blob);
+    return err;
+}
+
+static void publish_led_program(uint32_t slot) {
+    // Called with s_led_program_lock held - The program effect picks the program up on its next frame, the slot it ran
+    // from is staged over next time
+    s_led_program_slot = slot;
+    s_led_program_staged_count = 0;
+    atomic_store(&s_atomic_led_program, &s_led_programs[slot]);
+}
+
+
+#if CONFIG_HOLIDAYTREE_CONSOLE
+
+static int led_program_console_command(int argc, char** argv);
+static void print_led_program(const led_program_t* program);
+
+
+esp_err_t register_led_program_console_command() {
+    const esp_console_cmd_t programCommand = {
+        .command = "led_program",
+        .help = "LED program of the program effect - 'led_program show|begin|add <hex>...|commit|builtin <index>|save|reset'",
+        .hint = NULL,
+        .func = &led_program_console_command
+    };
+
+    ESP_RETURN_ON_ERROR(esp_console_cmd_register(&programCommand), LedStringTag, "esp_console_cmd_register() failed");
+    return ESP_OK;
+}
+
+static int led_program_console_command(int argc, char** argv) {
+    const char* const subCommand = argc > 1 ? argv[1] : "show";
+
+    esp_err_t err = ESP_OK;
+    if (strcmp(subCommand, "show") == 0) {
+        print_led_program(get_led_program());
+        for (uint32_t index = 0; index < get_led_builtin_program_count(); index++) {
+            printf("Built in program %lu: %s (%lu instructions)\n", index, LedBuiltinPrograms[index].name, LedBuiltinPrograms[index].instructionCount);
+        }
+    } else if (strcmp(subCommand, "begin") == 0) {
+        begin_led_program();
+    } else if ((strcmp(subCommand, "add") == 0) && (argc > 2)) {
+        // Instructions as 8 hexadecimal digits each - opcode, d, a, b
+        for (int arg = 2; (arg < argc) && (err == ESP_OK); arg++) {
+            const size_t digitCount = strlen(argv[arg]);
+            if ((digitCount == 0) || (digitCount % 8 != 0)) {
+                printf("Invalid instructions '%s' - 8 hexadecimal digits per instruction\n", argv[arg]);
+                return 1;
+            }
+            for (size_t digit = 0; (digit < digitCount) && (err == ESP_OK); digit += 8) {
+                char word[9] = { 0 };
+                memcpy(word, &argv[arg][digit], 8);
+                char* end = NULL;
+                const uint32_t value = strtoul(word, &end, 16);
+                if (*end != '\0') {
+                    printf("Invalid instructions '%s' - 8 hexadecimal digits per instruction\n", argv[arg]);
+                    return 1;
+                }
+                const led_program_instruction_t instruction = { .op = (uint8_t) (value >> 24), .d = (uint8_t) (value >> 16), .a = (uint8_t) (value >> 8), .b = (uint8_t) value };
+                err = add_led_program_instructions(&instruction, 1);
+            }
+        }
+    } else if (strcmp(subCommand, "commit") == 0) {
+        err = commit_led_program();
+    } else if ((strcmp(subCommand, "builtin") == 0) && (argc == 3)) {
+        err = select_led_builtin_program(strtoul(argv[2], NULL, 10));
+    } else if (strcmp(subCommand, "save") == 0) {
+        err = save_led_program();
+    } else if (strcmp(subCommand, "reset") == 0) {
+        err = reset_led_program();
+    } else {
+        printf("Unknown sub command '%s' - Use show, begin, add <hex>..., commit, builtin <index>, save or reset\n", subCommand);
+        return 1;
+    }
+
+    if (err != ESP_OK) {
+        printf("led_program %s failed (%d)\n", subCommand, err);
+        return 1;
+    }
+
+    return 0;
+}
+
+static void print_led_program(const led_program_t* program) {
+    if (program == NULL) {
+        printf("No LED program loaded\n");
+        return;
+    }
+
+    printf("Current program - %lu instructions\n", program->instructionCount);
+    for (uint32_t index = 0; index < program->instructionCount; index++) {
+        const led_program_instruction_t* instruction = &program->instructions[index];
+        const uint8_t operands = LedProgramOperands[instruction->op];
+        printf("%4lu: %-6s", index, LedProgramOpNames[instruction->op]);
+        if (instruction->op == LedProgramOpLoad) {
+            printf(" r%u, %d", instruction->d, (int16_t) (instruction->a | (instruction->b << 8)));
+        } else if (instruction->op == LedProgramOpAddImmediate) {
+            printf(" r%u, r%u, %d", instruction->d, instruction->a, (int8_t) instruction->b);
+        } else {
+            // Registers in d, a, b order - Jump targets last
+            const char* separator = " ";
+            if (operands & OPERAND_D) {
+                printf("%sr%u", separator, instruction->d);
+                separator = ", ";
+            }
+            if (operands & OPERAND_A) {
+                printf("%sr%u", separator, instruction->a);
+                separator = ", ";
+            }
+            if (operands & OPERAND_B) {
+                printf("%sr%u", separator, instruction->b);
+                separator = ", ";
+            }
+            if (operands & OPERAND_TARGET) {
+                printf("%s%u", separator, instruction->d);
+            }
+        }
+        printf("\n");
+    }
+}
+
+#endif
+
+#endif
\ No newline at end of file
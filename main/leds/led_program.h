@@ -0,0 +1,135 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <esp_err.h>
+
+#include "sdkconfig.h"
+
+#include "leds/led_framebuffer.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+
+// -----------------------------------------------------------------------------------
+// LED programs - Effects written as bytecode, loaded without reflashing. Assembled by tools/build_led_program.py
+//
+//  * A program runs once per pixel and per frame on 16 signed 32 bits registers, reset for every pixel:
+//      r0 pixel index  r1 x  r2 y  r3 height  r4 angle (LED geometry, 0 to 255)  r5 effect time in ms
+//      r6 bass level  r7 loudest band level (0 to 255)  r8 beat phase (0 to 255)  r9 beats since start up
+//      r10 to r15 zero
+//  * Instructions are 4 bytes: opcode, d, a, b - Registers in d, a and b, immediates in a and b, jump targets in d
+//  * The pixel is black unless the program sets its color with 'rgb' or 'hue' - Channels are clamped to 0 to 255
+//  * Jumps may go backwards: a pixel stops after LED_PROGRAM_MAX_STEPS instructions whatever its loops
+//  * Programs are checked once when loaded (opcodes, registers, jump targets) so the interpreter checks nothing and
+//    allocates nothing - Division by 0 gives 0
+//
+// Stored in the 'led_program' NVS namespace, or built into the firmware. The 'led_program' console command
+// (CONFIG_HOLIDAYTREE_CONSOLE) loads, saves and lists programs, 'led_bench program' measures the interpreter
+// -----------------------------------------------------------------------------------
+
+#define LED_PROGRAM_MAX_INSTRUCTIONS 128
+#define LED_PROGRAM_MAX_STEPS 256
+#define LED_PROGRAM_REGISTER_COUNT 16
+#define LED_PROGRAM_INSTRUCTION_SIZE 4
+
+typedef enum {
+    LedProgramOpEnd = 0,        // Stop - The pixel keeps its color
+    LedProgramOpLoad = 1,       // d = (int16_t) (a | b << 8)
+    LedProgramOpMove = 2,       // d = a
+    LedProgramOpAdd = 3,        // d = a + b
+    LedProgramOpSubtract = 4,   // d = a - b
+    LedProgramOpMultiply = 5,   // d = a * b
+    LedProgramOpScale = 6,      // d = (a * b) >> 8 - Fixed point multiply by an 8 bits fraction
+    LedProgramOpDivide = 7,     // d = a / b
+    LedProgramOpModulo = 8,     // d = a % b
+    LedProgramOpMinimum = 9,    // d = min(a, b)
+    LedProgramOpMaximum = 10,   // d = max(a, b)
+    LedProgramOpAnd = 11,       // d = a & b
+    LedProgramOpOr = 12,        // d = a | b
+    LedProgramOpXor = 13,       // d = a ^ b
+    LedProgramOpShiftLeft = 14, // d = a << (b & 31)
+    LedProgramOpShiftRight = 15,// d = a >> (b & 31), arithmetic
+    LedProgramOpAddImmediate = 16,  // d = a + (int8_t) b
+    LedProgramOpSine = 17,      // d = sin8(a) - 0 to 255, 128 at a = 0, a in 256th of a turn
+    LedProgramOpNoise = 18,     // d = noise(a, b) - 0 to 255, a and b in 256th of a noise cell, any value
+    LedProgramOpNoise3 = 19,    // d = noise(a, b, d) - Repeats every LED_NOISE_3D_PERIOD along each axis
+    LedProgramOpRandom = 20,    // d = random 0 to 255
+    LedProgramOpJump = 21,      // Go to instruction d
+    LedProgramOpJumpZero = 22,  // Go to instruction d if a == 0
+    LedProgramOpJumpNotZero = 23,   // Go to instruction d if a != 0
+    LedProgramOpJumpLess = 24,  // Go to instruction d if a < b
+    LedProgramOpRgb = 25,       // Pixel color d, a, b
+    LedProgramOpHue = 26,       // Pixel color of hue d at brightness a - Fully saturated
+
+    LedProgramOpMax
+} led_program_op_t;
+
+typedef struct {
+    uint8_t op;
+    uint8_t d;
+    uint8_t a;
+    uint8_t b;
+} led_program_instruction_t;
+
+// Checked program - Only built by load_led_program_code()
+typedef struct {
+    const led_program_instruction_t* instructions;
+    uint32_t instructionCount;
+} led_program_t;
+
+// Per frame inputs - Registers r5 to r9
+typedef struct {
+    int32_t timeMs;
+    int32_t bassLevel;
+    int32_t level;
+    int32_t beatPhase;
+    int32_t beatCount;
+} led_program_frame_t;
+
+// Program built into the firmware
+typedef struct {
+    const char* name;
+    const led_program_instruction_t* instructions;
+    uint32_t instructionCount;
+} led_builtin_program_t;
+
+
+// Check 'instructionCount' instructions and make 'program' run them - 'instructions' must outlive 'program'
+esp_err_t load_led_program_code(const led_program_instruction_t* instructions, uint32_t instructionCount, led_program_t* program);
+
+// Run 'program' for every pixel of 'framebuffer' - 'random' is the xorshift32 state of the caller (leds/led_math.h)
+void run_led_program(const led_program_t* program, const led_program_frame_t* frame, uint32_t* random, led_framebuffer_t* framebuffer);
+
+uint32_t get_led_builtin_program_count();
+const led_builtin_program_t* get_led_builtin_program(uint32_t index);
+
+// Start up - The program saved in NVS, the first built in program when there is none or it does not check
+esp_err_t load_led_program();
+
+// Any task - The program the program effect runs, loaded or saved last
+const led_program_t* get_led_program();
+
+// Program effect - Run the current program like run_led_program(), holding it so the console task does not stage over
+// it mid frame. False, and 'framebuffer' untouched, when there is no program
+bool run_current_led_program(const led_program_frame_t* frame, uint32_t* random, led_framebuffer_t* framebuffer);
+
+// Console task - Programs are staged, instruction by instruction, then checked and made current when committed. Staging
+// waits for a frame running the program to complete
+void begin_led_program();
+esp_err_t add_led_program_instructions(const led_program_instruction_t* instructions, uint32_t instructionCount);
+esp_err_t commit_led_program();
+esp_err_t select_led_builtin_program(uint32_t index);
+esp_err_t save_led_program();
+esp_err_t reset_led_program();
+
+#if CONFIG_HOLIDAYTREE_CONSOLE
+esp_err_t register_led_program_console_command();
+#endif
+
+#endif
\ No newline at end of file
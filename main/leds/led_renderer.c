@@ -0,0 +1,517 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <string.h>
+#include <sys/lock.h>
+
+#include <esp_check.h>
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "leds/led_internals.h"
+#include "leds/led_color_correction.h"
+#include "leds/led_transition.h"
+#include "leds/led_compositor.h"
+#include "leds/led_renderer.h"
+
+
+// Time between two frames
+static const uint32_t FramePeriodUs = 1000000 / CONFIG_HOLIDAYTREE_LEDS_FRAME_RATE;
+
+// Framebuffers effects render into, plus the color corrected or dimmed copy of the changed range sent to the string and the dithering residuals
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+    #define LED_RENDERER_PIXEL_BUFFER_COUNT 4
+#elif CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION || CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+    #define LED_RENDERER_PIXEL_BUFFER_COUNT 3
+#else
+    #define LED_RENDERER_PIXEL_BUFFER_COUNT 2
+#endif
+
+// Outgoing and incoming effect framebuffers of a transition, after the other buffers
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+    #define LED_RENDERER_TRANSITION_BUFFER_COUNT 2
+#else
+    #define LED_RENDERER_TRANSITION_BUFFER_COUNT 0
+#endif
+
+// Effect states - The incoming effect of a transition takes the slot the outgoing one does not use
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+    #define LED_RENDERER_EFFECT_SLOT_COUNT 2
+#else
+    #define LED_RENDERER_EFFECT_SLOT_COUNT 1
+#endif
+
+// Size of a state slot - Layered effects keep the states and framebuffers of their layers in theirs
+#if CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR
+    #define LED_RENDERER_EFFECT_STATE_SIZE (sizeof(led_composition_state_t) > LED_EFFECT_STATE_MAX_SIZE ? sizeof(led_composition_state_t) : LED_EFFECT_STATE_MAX_SIZE)
+#else
+    #define LED_RENDERER_EFFECT_STATE_SIZE LED_EFFECT_STATE_MAX_SIZE
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITION_WIPE
+    static const led_transition_kind_t TransitionKind = LedTransitionWipe;
+#elif CONFIG_HOLIDAYTREE_LEDS_TRANSITION_DISSOLVE
+    static const led_transition_kind_t TransitionKind = LedTransitionDissolve;
+#elif CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+    static const led_transition_kind_t TransitionKind = LedTransitionLinear;
+#endif
+
+
+// Both effects render into their own framebuffer, on top of their own previous frame - Blended into the back buffer
+typedef struct {
+    led_effect_instance_t outgoing;
+    led_framebuffer_t outgoingFramebuffer;
+    led_framebuffer_t incomingFramebuffer;
+    int64_t startUs;
+    bool outgoingFrozen;                    // Rendering both effects overran the frame period - The outgoing frame is held
+} led_renderer_transition_t;
+
+typedef struct {
+    uint8_t* pixels;                        // Both framebuffers then the corrected pixels, back to back
+    led_framebuffer_t framebuffers[2];
+#if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION || CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+    uint8_t* correctedPixels;               // Gamma and white balance corrected or dimmed pixels - Only the changed range is valid
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+    uint8_t* ditherResiduals;               // Fraction of each channel not shown by the last frame - Corrected pixels are the full frame on the string
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+    uint32_t powerScale;                    // Brightness scale the corrected pixels were computed with
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+    uint8_t* transitionPixels;              // Outgoing then incoming effect framebuffers
+#endif
+    led_effect_instance_t effect;           // Effect on the string - A transition starts from it
+    uint32_t effectSlot;                    // Index of its state in s_effect_states
+    uint32_t frontIndex;                    // Framebuffer last presented
+    bool frontOnString;                     // The LED string shows the front framebuffer
+    esp_timer_handle_t frameClock;          // Periodic timer - One notification per frame deadline
+} led_renderer_t;
+
+// Measurements of one frame
+typedef struct {
+    uint32_t renderTimeUs;
+    uint32_t correctionTimeUs;
+    uint32_t powerTimeUs;
+    uint32_t currentMa;                     // Estimated before dimming - 0 when not estimated
+    bool limited;                           // Dimmed to stay within the power budget
+    uint32_t waitTimeUs;                    // Time blocked on the previous frame transmission
+    uint32_t transmitTimeUs;
+    uint32_t blendTimeUs;                   // Part of the render time spent blending a transition
+    bool transition;                        // Rendered both effects of a transition
+    bool outgoingFrozen;                    // The outgoing effect was held on this frame
+    uint32_t pixelsUpdated;                 // 0 when the frame was not sent
+    uint32_t missedFrames;
+    uint32_t jitterUs;                      // Delay between the frame deadline and the task waking up
+} led_frame_stats_t;
+
+// Only accessed by the LED animation task once created
+static led_renderer_t s_renderer = { 0 };
+static uint32_t s_effect_states[LED_RENDERER_EFFECT_SLOT_COUNT][(LED_RENDERER_EFFECT_STATE_SIZE + sizeof(uint32_t) - 1) / sizeof(uint32_t)];
+
+// Frame statistics - Updated by the LED animation task, read by any task
+static _lock_t s_stats_lock;
+static led_renderer_stats_t s_stats = { 0 };
+
+
+static void on_frame_clock_tick(void* arg);
+static void render_frame(int64_t presentationTimeUs, led_renderer_transition_t* transition, uint32_t missedFrames, uint32_t jitterUs);
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+static bool render_transition_frame(int64_t presentationTimeUs, led_renderer_transition_t* transition, led_framebuffer_t* back, uint32_t* blendTimeUs);
+#endif
+#if !CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+static bool get_changed_pixel_range(const led_framebuffer_t* previous, const led_framebuffer_t* next, uint32_t* firstIndex, uint32_t* pixelCount);
+#endif
+static void record_frame_stats(const led_frame_stats_t* frameStats);
+
+
+esp_err_t create_led_renderer(uint32_t ledCount) {
+    ESP_RETURN_ON_FALSE(ledCount > 0, ESP_ERR_INVALID_ARG, LedStringTag, "create_led_renderer() - No LEDs");
+    ESP_RETURN_ON_FALSE(s_renderer.pixels == NULL, ESP_ERR_INVALID_STATE, LedStringTag, "create_led_renderer() - Already created");
+
+    const size_t framebufferSize = ledCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+    s_renderer.pixels = heap_caps_calloc(LED_RENDERER_PIXEL_BUFFER_COUNT + LED_RENDERER_TRANSITION_BUFFER_COUNT, framebufferSize, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_RETURN_ON_FALSE(s_renderer.pixels != NULL, ESP_ERR_NO_MEM, LedStringTag, "create_led_renderer() - Not enough memory for %lu LEDs", ledCount);
+
+    for (uint32_t index = 0; index < 2; index++) {
+        s_renderer.framebuffers[index].pixels = &s_renderer.pixels[index * framebufferSize];
+        s_renderer.framebuffers[index].pixelCount = ledCount;
+    }
+#if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION || CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+    s_renderer.correctedPixels = &s_renderer.pixels[2 * framebufferSize];
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+    s_renderer.ditherResiduals = &s_renderer.pixels[3 * framebufferSize];
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+    s_renderer.transitionPixels = &s_renderer.pixels[LED_RENDERER_PIXEL_BUFFER_COUNT * framebufferSize];
+#endif
+    s_renderer.frontIndex = 0;
+#if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+    s_renderer.powerScale = LED_COLOR_SCALE_FULL;
+#endif
+
+    // Every frame which changes is on the wire for the time of the longest segment
+    const uint32_t channelCount = get_led_string_channel_count() > 0 ? get_led_string_channel_count() : 1;
+    const uint32_t wireTimeUs = get_led_string_wire_time_us((ledCount + channelCount - 1) / channelCount);
+    if (wireTimeUs > FramePeriodUs) {
+        ESP_LOGW(LedStringTag, "create_led_renderer() - %lu LEDs take %lu us to send, more than the %lu us frame period", ledCount, wireTimeUs, FramePeriodUs);
+    }
+
+    _lock_acquire(&s_stats_lock);
+        memset(&s_stats, 0, sizeof(s_stats));
+        s_stats.ledCount = ledCount;
+        s_stats.framePeriodUs = FramePeriodUs;
+    _lock_release(&s_stats_lock);
+
+    return ESP_OK;
+}
+
+led_animation_task_notification_t run_led_effect(const led_effect_t* effect, bool transition) {
+    if (s_renderer.pixels == NULL) {
+        ESP_LOGE(LedStringTag, "run_led_effect() - create_led_renderer() must be called first");
+        return accept_task_notification_with_delay(portMAX_DELAY);
+    }
+    if (effect->stateSize > sizeof(s_effect_states[0])) {
+        ESP_LOGE(LedStringTag, "run_led_effect() - '%s' state (%u bytes) does not fit a %u bytes slot", effect->name, effect->stateSize, sizeof(s_effect_states[0]));
+        return accept_task_notification_with_delay(portMAX_DELAY);
+    }
+
+    // The frame clock notifies the task running effects - Created on the first effect
+    if (s_renderer.frameClock == NULL) {
+        const esp_timer_create_args_t frameClockArgs = {
+            .callback = &on_frame_clock_tick,
+            .arg = xTaskGetCurrentTaskHandle(),
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "ht-led-frame",
+            .skip_unhandled_events = true
+        };
+        esp_err_t err = esp_timer_create(&frameClockArgs, &s_renderer.frameClock);
+        if (err != ESP_OK) {
+            ESP_LOGE(LedStringTag, "run_led_effect() - esp_timer_create() failed (%d)", err);
+            return accept_task_notification_with_delay(portMAX_DELAY);
+        }
+    }
+
+    // Deadlines are on a fixed grid from the start of the effect - The periodic timer does not drift and a late frame does not delay the next ones
+    const int64_t startUs = esp_timer_get_time();
+
+    led_renderer_transition_t transitionState = { 0 };
+    led_renderer_transition_t* activeTransition = NULL;
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+    // The outgoing effect goes on from the frame on the string with its own state, and the incoming one starts from black
+    if (transition && (s_renderer.effect.effect != NULL) && s_renderer.frontOnString) {
+        const uint32_t pixelCount = s_renderer.framebuffers[0].pixelCount;
+        const size_t framebufferSize = pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+        transitionState.outgoing = s_renderer.effect;
+        transitionState.outgoingFramebuffer.pixels = s_renderer.transitionPixels;
+        transitionState.outgoingFramebuffer.pixelCount = pixelCount;
+        transitionState.incomingFramebuffer.pixels = &s_renderer.transitionPixels[framebufferSize];
+        transitionState.incomingFramebuffer.pixelCount = pixelCount;
+        transitionState.startUs = startUs;
+        memcpy(transitionState.outgoingFramebuffer.pixels, s_renderer.framebuffers[s_renderer.frontIndex].pixels, framebufferSize);
+        clear_led_framebuffer(&transitionState.incomingFramebuffer);
+        activeTransition = &transitionState;
+        s_renderer.effectSlot ^= 1;
+    }
+#else
+    (void) transition;
+    (void) transitionState;
+#endif
+    if (activeTransition == NULL) {
+        // Effects start from a black string - Nothing needs to be sent until a frame lights an LED if the string was cleared
+        clear_led_framebuffer(&s_renderer.framebuffers[0]);
+        clear_led_framebuffer(&s_renderer.framebuffers[1]);
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+        memset(s_renderer.correctedPixels, 0, 2 * s_renderer.framebuffers[0].pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL);
+#endif
+        s_renderer.frontOnString = is_led_string_blank();
+    }
+
+    start_led_effect_instance(&s_renderer.effect, effect, s_effect_states[s_renderer.effectSlot]);
+
+    esp_err_t err = esp_timer_start_periodic(s_renderer.frameClock, FramePeriodUs);
+    if (err != ESP_OK) {
+        ESP_LOGE(LedStringTag, "run_led_effect() - esp_timer_start_periodic() failed (%d)", err);
+        return accept_task_notification_with_delay(portMAX_DELAY);
+    }
+
+    render_frame(startUs, activeTransition, 0, 0);
+
+    uint32_t lastDeadline = 0;
+    for (;;) {
+        // Frame clock ticks and effect changes both wake the task - Effect changes win
+        ulTaskNotifyTakeIndexed(LedFrameClockNotificationIndex, pdTRUE, portMAX_DELAY);
+        led_animation_task_notification_t notification = accept_task_notification_with_delay(0);
+        if (notification != LedAnimationTaskNotificationNone) {
+            esp_timer_stop(s_renderer.frameClock);
+            return notification;
+        }
+
+        // Render for the latest deadline - Deadlines which already passed are skipped rather than rendered as a burst of late frames
+        const int64_t nowUs = esp_timer_get_time();
+        const uint32_t deadline = (uint32_t) ((nowUs - startUs) / FramePeriodUs);
+        if (deadline == lastDeadline) {
+            continue;
+        }
+
+        const int64_t presentationTimeUs = startUs + (int64_t) deadline * FramePeriodUs;
+        render_frame(presentationTimeUs, activeTransition, deadline - lastDeadline - 1, (uint32_t) (nowUs - presentationTimeUs));
+        lastDeadline = deadline;
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+        // Progress follows the frame time so the transition lasts as long whatever the frames skipped - Its last frame,
+        // blended at full progress, is the incoming frame the effect goes on from
+        if ((activeTransition != NULL) && (presentationTimeUs - activeTransition->startUs >= (int64_t) CONFIG_HOLIDAYTREE_LEDS_TRANSITION_MS * 1000)) {
+            activeTransition = NULL;
+        }
+#endif
+    }
+}
+
+static void on_frame_clock_tick(void* arg) {
+    xTaskNotifyGiveIndexed((TaskHandle_t) arg, LedFrameClockNotificationIndex);
+}
+
+static void render_frame(int64_t presentationTimeUs, led_renderer_transition_t* transition, uint32_t missedFrames, uint32_t jitterUs) {
+    // Render on top of the last presented frame - A transition blends two effects which render on top of their own
+    led_framebuffer_t* front = &s_renderer.framebuffers[s_renderer.frontIndex];
+    led_framebuffer_t* back = &s_renderer.framebuffers[s_renderer.frontIndex ^ 1];
+    if (transition == NULL) {
+        memcpy(back->pixels, front->pixels, back->pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL);
+    }
+
+    uint32_t blendTimeUs = 0;
+    bool outgoingFrozen = false;
+    const int64_t renderStartUs = esp_timer_get_time();
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+    if (transition != NULL) {
+        outgoingFrozen = render_transition_frame(presentationTimeUs, transition, back, &blendTimeUs);
+    } else
+#endif
+    {
+        step_led_effect_instance(&s_renderer.effect, presentationTimeUs, FramePeriodUs, back);
+    }
+    const int64_t renderEndUs = esp_timer_get_time();
+
+    // Swap then send the new front buffer - Unchanged frames are not sent
+    uint32_t firstIndex = 0;
+    uint32_t pixelCount = back->pixelCount;
+    uint32_t correctionTimeUs = 0;
+    uint32_t powerTimeUs = 0;
+    uint32_t currentMa = 0;
+    uint32_t waitTimeUs = 0;
+#if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION || CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+    uint32_t powerScale = LED_COLOR_SCALE_FULL;
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+#if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+    // The whole frame draws current - Estimated before dithering, which applies the scale
+    const int64_t powerStartUs = esp_timer_get_time();
+    powerScale = get_led_power_scale(back->pixels, back->pixelCount, &currentMa);
+    powerTimeUs = (uint32_t) (esp_timer_get_time() - powerStartUs);
+    s_renderer.powerScale = powerScale;
+#endif
+    // Every frame is corrected and dithered - Pixels between two output levels change from frame to frame even when
+    // the framebuffer does not, so the output is compared rather than the framebuffers
+    const int64_t correctionStartUs = esp_timer_get_time();
+    bool changed = dither_led_pixel_colors(back->pixels, s_renderer.correctedPixels, s_renderer.ditherResiduals, back->pixelCount, powerScale, &firstIndex, &pixelCount);
+    correctionTimeUs = (uint32_t) (esp_timer_get_time() - correctionStartUs);
+    if (!s_renderer.frontOnString) {
+        changed = true;
+        firstIndex = 0;
+        pixelCount = back->pixelCount;
+    }
+#else
+    const bool changed = !s_renderer.frontOnString || get_changed_pixel_range(front, back, &firstIndex, &pixelCount);
+#if CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+    if (changed) {
+        // The whole frame draws current, not only the changed range - A new scale makes every corrected pixel stale
+        const int64_t powerStartUs = esp_timer_get_time();
+        powerScale = get_led_power_scale(back->pixels, back->pixelCount, &currentMa);
+        powerTimeUs = (uint32_t) (esp_timer_get_time() - powerStartUs);
+        if (powerScale != s_renderer.powerScale) {
+            firstIndex = 0;
+            pixelCount = back->pixelCount;
+            s_renderer.powerScale = powerScale;
+        }
+    }
+#endif
+#endif
+    s_renderer.frontIndex ^= 1;
+
+    if (changed) {
+        const uint32_t firstByte = firstIndex * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+#if CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+        const uint8_t* const pixels = &s_renderer.correctedPixels[firstByte];
+#elif CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION
+        // Effects stay in linear RGB - Only the changed range is corrected, in one pass right before it is sent
+        const int64_t correctionStartUs = esp_timer_get_time();
+        correct_led_pixel_colors(&back->pixels[firstByte], &s_renderer.correctedPixels[firstByte], pixelCount, powerScale);
+        correctionTimeUs = (uint32_t) (esp_timer_get_time() - correctionStartUs);
+        const uint8_t* const pixels = &s_renderer.correctedPixels[firstByte];
+#elif CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+        // No correction - The changed range is only copied when the frame is dimmed
+        const uint8_t* pixels = &back->pixels[firstByte];
+        if (powerScale < LED_COLOR_SCALE_FULL) {
+            const int64_t correctionStartUs = esp_timer_get_time();
+            scale_led_pixel_colors(pixels, &s_renderer.correctedPixels[firstByte], pixelCount, powerScale);
+            correctionTimeUs = (uint32_t) (esp_timer_get_time() - correctionStartUs);
+            pixels = &s_renderer.correctedPixels[firstByte];
+        }
+#else
+        const uint8_t* const pixels = &back->pixels[firstByte];
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_ASYNC_TRANSMISSION
+        // The previous frame was shifted out while this one was rendered - Only what is left of it is waited for
+        const int64_t waitStartUs = esp_timer_get_time();
+        esp_err_t err = wait_led_string_transmission();
+        waitTimeUs = (uint32_t) (esp_timer_get_time() - waitStartUs);
+        if (err == ESP_OK) {
+            err = write_led_string_pixels(pixels, firstIndex, pixelCount);
+        }
+#else
+        esp_err_t err = write_led_string_pixels(pixels, firstIndex, pixelCount);
+#endif
+        s_renderer.frontOnString = err == ESP_OK;
+        if (err != ESP_OK) {
+            ESP_LOGW(LedStringTag, "render_frame() - write_led_string_pixels() failed (%d)", err);
+        }
+    }
+    const int64_t endUs = esp_timer_get_time();
+
+    const led_frame_stats_t frameStats = {
+        .renderTimeUs = (uint32_t) (renderEndUs - renderStartUs),
+        .correctionTimeUs = correctionTimeUs,
+        .powerTimeUs = powerTimeUs,
+        .currentMa = currentMa,
+#if CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION || CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT
+        .limited = powerScale < LED_COLOR_SCALE_FULL,
+#endif
+        .waitTimeUs = waitTimeUs,
+        .transmitTimeUs = (uint32_t) (endUs - renderEndUs) - correctionTimeUs - powerTimeUs - waitTimeUs,
+        .blendTimeUs = blendTimeUs,
+        .transition = transition != NULL,
+        .outgoingFrozen = outgoingFrozen,
+        .pixelsUpdated = changed ? pixelCount : 0,
+        .missedFrames = missedFrames,
+        .jitterUs = jitterUs
+    };
+    record_frame_stats(&frameStats);
+}
+
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+static bool render_transition_frame(int64_t presentationTimeUs, led_renderer_transition_t* transition, led_framebuffer_t* back, uint32_t* blendTimeUs) {
+    // The outgoing effect goes on with its own state and time line
+    const int64_t startUs = esp_timer_get_time();
+    const bool outgoingFrozen = transition->outgoingFrozen;
+    if (!outgoingFrozen) {
+        step_led_effect_instance(&transition->outgoing, presentationTimeUs, FramePeriodUs, &transition->outgoingFramebuffer);
+    }
+    step_led_effect_instance(&s_renderer.effect, presentationTimeUs, FramePeriodUs, &transition->incomingFramebuffer);
+
+    const int64_t blendStartUs = esp_timer_get_time();
+    const int64_t elapsedUs = presentationTimeUs - transition->startUs;
+    const uint32_t progress = (uint32_t) ((elapsedUs * LED_TRANSITION_PROGRESS_FULL) / ((int64_t) CONFIG_HOLIDAYTREE_LEDS_TRANSITION_MS * 1000));
+    blend_led_transition(TransitionKind, &transition->outgoingFramebuffer, &transition->incomingFramebuffer, progress, back);
+    const int64_t endUs = esp_timer_get_time();
+    *blendTimeUs = (uint32_t) (endUs - blendStartUs);
+
+    // Correcting and sending the frame needs the rest of the period - Past half of it, the outgoing frame is held for
+    // the rest of the transition, which brings the cost back to one effect and a blend
+    if (endUs - startUs > FramePeriodUs / 2) {
+        transition->outgoingFrozen = true;
+    }
+
+    return outgoingFrozen;
+}
+#endif
+
+void get_led_renderer_stats(led_renderer_stats_t* stats) {
+    _lock_acquire(&s_stats_lock);
+        *stats = s_stats;
+    _lock_release(&s_stats_lock);
+}
+
+void reset_led_renderer_stats() {
+    _lock_acquire(&s_stats_lock);
+        const uint32_t ledCount = s_stats.ledCount;
+        memset(&s_stats, 0, sizeof(s_stats));
+        s_stats.ledCount = ledCount;
+        s_stats.framePeriodUs = FramePeriodUs;
+    _lock_release(&s_stats_lock);
+}
+
+#if !CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING
+static bool get_changed_pixel_range(const led_framebuffer_t* previous, const led_framebuffer_t* next, uint32_t* firstIndex, uint32_t* pixelCount) {
+    const uint32_t byteCount = next->pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+
+    uint32_t first = 0;
+    while ((first < byteCount) && (previous->pixels[first] == next->pixels[first])) {
+        first++;
+    }
+    if (first == byteCount) {
+        return false;
+    }
+
+    uint32_t last = byteCount - 1;
+    while (previous->pixels[last] == next->pixels[last]) {
+        last--;
+    }
+
+    *firstIndex = first / LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+    *pixelCount = last / LED_FRAMEBUFFER_BYTES_PER_PIXEL - *firstIndex + 1;
+    return true;
+}
+#endif
+
+static void record_frame_stats(const led_frame_stats_t* frameStats) {
+    _lock_acquire(&s_stats_lock);
+        s_stats.framesRendered++;
+        s_stats.framesMissed += frameStats->missedFrames;
+        s_stats.jitterUs += frameStats->jitterUs;
+        if (frameStats->jitterUs > s_stats.maximumJitterUs) {
+            s_stats.maximumJitterUs = frameStats->jitterUs;
+        }
+        s_stats.renderTimeUs += frameStats->renderTimeUs;
+        if (frameStats->renderTimeUs > s_stats.maximumRenderTimeUs) {
+            s_stats.maximumRenderTimeUs = frameStats->renderTimeUs;
+        }
+        s_stats.correctionTimeUs += frameStats->correctionTimeUs;
+        if (frameStats->correctionTimeUs > s_stats.maximumCorrectionTimeUs) {
+            s_stats.maximumCorrectionTimeUs = frameStats->correctionTimeUs;
+        }
+        s_stats.powerTimeUs += frameStats->powerTimeUs;
+        if (frameStats->powerTimeUs > s_stats.maximumPowerTimeUs) {
+            s_stats.maximumPowerTimeUs = frameStats->powerTimeUs;
+        }
+        s_stats.framesLimited += frameStats->limited ? 1 : 0;
+        if (frameStats->transition) {
+            s_stats.transitionFrames++;
+            s_stats.transitionFramesFrozen += frameStats->outgoingFrozen ? 1 : 0;
+            s_stats.transitionRenderTimeUs += frameStats->renderTimeUs;
+            if (frameStats->renderTimeUs > s_stats.maximumTransitionRenderTimeUs) {
+                s_stats.maximumTransitionRenderTimeUs = frameStats->renderTimeUs;
+            }
+            s_stats.blendTimeUs += frameStats->blendTimeUs;
+        }
+        if (frameStats->currentMa > s_stats.maximumCurrentMa) {
+            s_stats.maximumCurrentMa = frameStats->currentMa;
+        }
+
+        // Unchanged frames only cost a comparison
+        if (frameStats->pixelsUpdated > 0) {
+            s_stats.framesTransmitted++;
+            s_stats.pixelsUpdated += frameStats->pixelsUpdated;
+            s_stats.waitTimeUs += frameStats->waitTimeUs;
+            s_stats.transmitTimeUs += frameStats->transmitTimeUs;
+            if (frameStats->transmitTimeUs > s_stats.maximumTransmitTimeUs) {
+                s_stats.maximumTransmitTimeUs = frameStats->transmitTimeUs;
+            }
+        }
+    _lock_release(&s_stats_lock);
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <esp_err.h>
+
+#include "leds/led_effect.h"
+
+
+// -----------------------------------------------------------------------------------
+// Frame based LED renderer - Runs on the LED animation task
+//
+//  * Effects step into the back framebuffer (packed RGB, 3 bytes per pixel) - They never touch led_strip
+//  * Every CONFIG_HOLIDAYTREE_LEDS_FRAME_RATE th of a second the back buffer is rendered, swapped with the front
+//    buffer and the front buffer is pushed to the LED string
+//  * Frames are paced by a periodic esp_timer which notifies the LED animation task on its own notification index
+//    (LedFrameClockNotificationIndex) - Deadlines are on a fixed grid so late frames do not accumulate drift
+//  * Frames which cannot be rendered on time are skipped - Effects see the frame time jump, not slow motion
+//  * Only frames which differ from the one on the string are sent, and only the range of pixels which changed is
+//    copied to led_strip - Static content costs a comparison per frame
+//  * With CONFIG_HOLIDAYTREE_LEDS_COLOR_CORRECTION the changed range goes through the gamma and white balance tables
+//    (leds/led_color_correction.h) into a third buffer right before it is sent - Framebuffers stay in linear RGB
+//  * With CONFIG_HOLIDAYTREE_LEDS_TEMPORAL_DITHERING every frame is corrected to 16 bits and dithered to 8 bits, and the
+//    dithered output is compared with what the string shows instead of the framebuffers
+//  * With CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS an effect started while another one runs takes over through a transition
+//    (leds/led_transition.h): both render into their own framebuffer and are blended for CONFIG_HOLIDAYTREE_LEDS_TRANSITION_MS
+//  * With CONFIG_HOLIDAYTREE_LEDS_POWER_LIMIT the current of every frame which changes is estimated from its corrected
+//    levels and the whole frame is dimmed while correcting when it exceeds CONFIG_HOLIDAYTREE_LEDS_POWER_BUDGET_MA -
+//    Without color correction the estimate uses the framebuffer levels and the changed range is dimmed into a third buffer
+//  * With CONFIG_HOLIDAYTREE_LEDS_ASYNC_TRANSMISSION sending a frame only starts the DMA - The next frame is rendered
+//    while it is on the wire and the renderer waits for the transfer to complete before it updates led_strip
+//
+// Frame statistics and the frame rate ceiling they allow are reported by 'led_bench frames' (CONFIG_HOLIDAYTREE_LEDS_BENCHMARK)
+// -----------------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t ledCount;
+    uint32_t framePeriodUs;
+    uint32_t framesRendered;
+    uint32_t framesTransmitted;     // Frames which differed from the one on the string
+    uint32_t framesMissed;          // Frame deadlines skipped because the previous frame ran late
+    uint64_t jitterUs;              // Total delay between frame deadlines and the task waking up
+    uint32_t maximumJitterUs;
+    uint64_t pixelsUpdated;         // Pixels in the changed ranges of transmitted frames
+    uint64_t renderTimeUs;          // Total time spent in effects
+    uint64_t correctionTimeUs;      // Total time spent correcting colors - Only transmitted frames unless dithering
+    uint64_t powerTimeUs;           // Total time spent estimating frame currents - Same frames as the correction
+    uint32_t framesLimited;         // Frames dimmed to stay within the power budget
+    uint32_t maximumCurrentMa;      // Highest frame current estimated before dimming
+    uint64_t waitTimeUs;            // Total time transmitted frames waited for the previous one to be out
+    uint64_t transmitTimeUs;        // Total time spent sending transmitted frames to the LED string - Only starting the DMA when asynchronous
+    uint32_t maximumRenderTimeUs;
+    uint32_t maximumCorrectionTimeUs;
+    uint32_t maximumPowerTimeUs;
+    uint32_t transitionFrames;      // Frames rendering both effects of a transition
+    uint32_t transitionFramesFrozen;    // Transition frames which held the outgoing effect to stay within the frame period
+    uint64_t transitionRenderTimeUs;    // Part of the render time spent in transition frames, blending included
+    uint64_t blendTimeUs;           // Total time spent blending transitions
+    uint32_t maximumTransitionRenderTimeUs;
+    uint32_t maximumTransmitTimeUs;
+} led_renderer_stats_t;
+
+
+esp_err_t create_led_renderer(uint32_t ledCount);
+
+// LED animation task - Steps 'effect' at the frame rate until an effect notification is received, which is returned
+//  * The effect state is one of the renderer slots of LED_EFFECT_STATE_MAX_SIZE bytes, or the state of a layered effect
+//    with CONFIG_HOLIDAYTREE_LEDS_COMPOSITOR - Nothing is allocated
+//  * 'transition' takes over from the effect still on the string (CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS) - Otherwise the
+//    effect starts from black
+led_animation_task_notification_t run_led_effect(const led_effect_t* effect, bool transition);
+
+// Any task
+void get_led_renderer_stats(led_renderer_stats_t* stats);
+void reset_led_renderer_stats();
\ No newline at end of file
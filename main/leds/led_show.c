@@ -0,0 +1,308 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <string.h>
+
+#include <esp_check.h>
+#include <esp_log.h>
+#include <esp_partition.h>
+
+#include "sdkconfig.h"
+
+#include "leds/led_show.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+
+// Light show bank log tag
+static const char* LedShowTag = "led_show";
+
+
+// Light show bank partition - See partitions.csv
+static const char* LedShowPartitionName = "shows";
+static const esp_partition_subtype_t LedShowPartitionSubtype = (esp_partition_subtype_t) 0x41;
+
+// Light show bank header constants
+static const char LedShowMagic[4] = { 'H', 'T', 'L', 'S' };
+static const uint16_t LedShowVersion = 1;
+static const size_t LedShowHeaderSize = 12;
+static const size_t LedShowEntrySize = 16;
+static const size_t LedShowKeyframeHeaderSize = 8;
+static const uint32_t LedShowMaximumLedCount = 1024;
+
+
+typedef struct __attribute__((packed)) {
+    char magic[4];
+    uint16_t version;
+    uint16_t showCount;
+    uint32_t totalSize;
+} led_show_bank_header_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t dataOffset;
+    uint32_t dataSize;
+    uint32_t durationMs;
+    uint16_t ledCount;
+    uint16_t keyframeCount;
+} led_show_bank_entry_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t timeMs;
+    uint16_t payloadSize;
+    uint8_t curve;
+    uint8_t reserved;
+} led_show_keyframe_header_t;
+
+
+// Flash mapping of the whole light show bank - It stays mapped for the lifetime of the application
+static const uint8_t* s_led_show_bank = NULL;
+static esp_partition_mmap_handle_t s_led_show_bank_mmap_handle = 0;
+static uint32_t s_led_show_count = 0;
+
+
+static esp_err_t read_led_show_bank_header(const esp_partition_t* partition, led_show_bank_header_t* header);
+static esp_err_t check_led_show(const uint8_t* bank, uint32_t totalSize, uint32_t showCount, uint32_t showIndex);
+static bool check_led_show_payload(const uint8_t* payload, uint32_t payloadSize, uint32_t ledCount);
+
+static inline uint8_t blend_level(uint32_t from, uint32_t to, uint32_t weight) {
+    return (uint8_t) ((from * (256 - weight) + to * weight) >> 8);
+}
+
+
+esp_err_t mount_led_show_bank() {
+    const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, LedShowPartitionSubtype, LedShowPartitionName);
+    ESP_RETURN_ON_FALSE(partition != NULL, ESP_ERR_NOT_FOUND, LedShowTag, "mount_led_show_bank() - Partition '%s' not found", LedShowPartitionName);
+
+    // Validate the header before mapping anything - An unflashed partition reads as 0xFF
+    led_show_bank_header_t header = { 0 };
+    ESP_RETURN_ON_ERROR(read_led_show_bank_header(partition, &header), LedShowTag, "mount_led_show_bank() - No valid light show bank in partition '%s'", LedShowPartitionName);
+
+    // Map only the bytes used by the bank - Mapping consumes MMU pages shared with the application read only data
+    const void* mappedBank = NULL;
+    ESP_RETURN_ON_ERROR(esp_partition_mmap(partition, 0, header.totalSize, ESP_PARTITION_MMAP_DATA, &mappedBank, &s_led_show_bank_mmap_handle), LedShowTag, "esp_partition_mmap() failed");
+
+    // Every keyframe is checked once here so the decoder never has to - Runs must cover each show exactly
+    for (uint32_t showIndex = 0; showIndex < header.showCount; showIndex++) {
+        esp_err_t err = check_led_show((const uint8_t*) mappedBank, header.totalSize, header.showCount, showIndex);
+        if (err != ESP_OK) {
+            esp_partition_munmap(s_led_show_bank_mmap_handle);
+            s_led_show_bank_mmap_handle = 0;
+            ESP_LOGE(LedShowTag, "mount_led_show_bank() - Show %lu is invalid (%d)", showIndex, err);
+            return err;
+        }
+    }
+
+    s_led_show_bank = (const uint8_t*) mappedBank;
+    s_led_show_count = header.showCount;
+
+    ESP_LOGI(LedShowTag, "Light show bank mounted - %u shows - %lu bytes", header.showCount, header.totalSize);
+    return ESP_OK;
+}
+
+uint32_t get_led_show_count() {
+    return s_led_show_count;
+}
+
+esp_err_t get_led_show(uint32_t showIndex, led_show_t* show) {
+    ESP_RETURN_ON_FALSE(show != NULL, ESP_ERR_INVALID_ARG, LedShowTag, "get_led_show() - show cannot be NULL");
+    if (showIndex >= s_led_show_count) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    led_show_bank_entry_t entry;
+    memcpy(&entry, s_led_show_bank + LedShowHeaderSize + showIndex * LedShowEntrySize, sizeof(entry));
+
+    show->data = s_led_show_bank + entry.dataOffset;
+    show->dataSize = entry.dataSize;
+    show->durationMs = entry.durationMs;
+    show->ledCount = entry.ledCount;
+    show->keyframeCount = entry.keyframeCount;
+    return ESP_OK;
+}
+
+esp_err_t get_led_show_keyframe(const led_show_t* show, uint32_t offset, led_show_keyframe_t* keyframe) {
+    if (offset + LedShowKeyframeHeaderSize > show->dataSize) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // Keyframes are 4 bytes aligned in the mapped bank
+    const led_show_keyframe_header_t* header = (const led_show_keyframe_header_t*) (show->data + offset);
+    keyframe->timeMs = header->timeMs;
+    keyframe->curve = (led_show_curve_t) header->curve;
+    keyframe->payload = show->data + offset + LedShowKeyframeHeaderSize;
+    keyframe->payloadSize = header->payloadSize;
+    keyframe->nextOffset = (offset + LedShowKeyframeHeaderSize + header->payloadSize + 3) & ~3U;
+    return ESP_OK;
+}
+
+void apply_led_show_keyframe(const led_show_keyframe_t* keyframe, uint8_t* pixels, uint32_t pixelCount) {
+    const uint8_t* code = keyframe->payload;
+    const uint8_t* const end = code + keyframe->payloadSize;
+    uint32_t index = 0;
+    while (code < end) {
+        const uint32_t operation = *code & LED_SHOW_RUN_OPERATION_MASK;
+        const uint32_t length = (*code++ & LED_SHOW_RUN_LENGTH_MASK) + 1;
+        const uint32_t count = index + length <= pixelCount ? length : (index < pixelCount ? pixelCount - index : 0);
+        uint8_t* pixel = &pixels[index * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+        switch (operation) {
+            case LED_SHOW_RUN_FILL:
+                for (uint32_t run = 0; run < count; run++, pixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+                    pixel[0] = code[0];
+                    pixel[1] = code[1];
+                    pixel[2] = code[2];
+                }
+                code += LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+                break;
+
+            case LED_SHOW_RUN_LITERAL:
+                memcpy(pixel, code, count * LED_FRAMEBUFFER_BYTES_PER_PIXEL);
+                code += length * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+                break;
+
+            default:
+                // Unchanged
+                break;
+        }
+        index += length;
+    }
+}
+
+void interpolate_led_show_keyframe(const uint8_t* pixels, const led_show_keyframe_t* next, uint32_t weight, led_framebuffer_t* output) {
+    const uint32_t pixelCount = output->pixelCount;
+    const uint8_t* code = next->payload;
+    const uint8_t* const end = code + next->payloadSize;
+    uint32_t index = 0;
+    while (code < end) {
+        const uint32_t operation = *code & LED_SHOW_RUN_OPERATION_MASK;
+        const uint32_t length = (*code++ & LED_SHOW_RUN_LENGTH_MASK) + 1;
+        const uint32_t count = index + length <= pixelCount ? length : (index < pixelCount ? pixelCount - index : 0);
+        const uint8_t* from = &pixels[index * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+        uint8_t* pixel = &output->pixels[index * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+        switch (operation) {
+            case LED_SHOW_RUN_FILL:
+                for (uint32_t run = 0; run < count; run++, from += LED_FRAMEBUFFER_BYTES_PER_PIXEL, pixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+                    pixel[0] = blend_level(from[0], code[0], weight);
+                    pixel[1] = blend_level(from[1], code[1], weight);
+                    pixel[2] = blend_level(from[2], code[2], weight);
+                }
+                code += LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+                break;
+
+            case LED_SHOW_RUN_LITERAL:
+                for (uint32_t level = 0; level < count * LED_FRAMEBUFFER_BYTES_PER_PIXEL; level++) {
+                    pixel[level] = blend_level(from[level], code[level], weight);
+                }
+                code += length * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+                break;
+
+            default:
+                // Unchanged - Both keyframes agree
+                memcpy(pixel, from, count * LED_FRAMEBUFFER_BYTES_PER_PIXEL);
+                break;
+        }
+        index += length;
+    }
+
+    // Pixels the show does not cover stay dark
+    if (index < pixelCount) {
+        memset(&output->pixels[index * LED_FRAMEBUFFER_BYTES_PER_PIXEL], 0, (pixelCount - index) * LED_FRAMEBUFFER_BYTES_PER_PIXEL);
+    }
+}
+
+uint32_t get_led_show_curve_weight(led_show_curve_t curve, uint32_t progress) {
+    progress = progress < 256 ? progress : 256;
+    switch (curve) {
+        case LedShowCurveStep:
+            return progress < 256 ? 0 : 256;
+        case LedShowCurveEaseIn:
+            return (progress * progress) >> 8;
+        case LedShowCurveEaseOut:
+            return 256 - (((256 - progress) * (256 - progress)) >> 8);
+        case LedShowCurveEaseInOut:
+            // Smoothstep - 3p^2 - 2p^3
+            return (progress * progress * (3 * 256 - 2 * progress)) >> 16;
+        case LedShowCurveLinear:
+        default:
+            return progress;
+    }
+}
+
+static esp_err_t read_led_show_bank_header(const esp_partition_t* partition, led_show_bank_header_t* header) {
+    ESP_RETURN_ON_ERROR(esp_partition_read(partition, 0, header, sizeof(*header)), LedShowTag, "esp_partition_read() failed");
+
+    if ((memcmp(header->magic, LedShowMagic, sizeof(LedShowMagic)) != 0) || (header->version != LedShowVersion)) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    const size_t entriesEnd = LedShowHeaderSize + header->showCount * LedShowEntrySize;
+    if ((header->totalSize < entriesEnd) || (header->totalSize > partition->size)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t check_led_show(const uint8_t* bank, uint32_t totalSize, uint32_t showCount, uint32_t showIndex) {
+    led_show_bank_entry_t entry;
+    memcpy(&entry, bank + LedShowHeaderSize + showIndex * LedShowEntrySize, sizeof(entry));
+
+    // The show lies within the bank, keyframes aligned
+    const size_t entriesEnd = LedShowHeaderSize + showCount * LedShowEntrySize;
+    if ((entry.dataOffset < entriesEnd) || (entry.dataOffset & 3) || (entry.dataOffset > totalSize) || (entry.dataSize > totalSize - entry.dataOffset)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if ((entry.ledCount == 0) || (entry.ledCount > LedShowMaximumLedCount) || (entry.keyframeCount == 0) || (entry.durationMs == 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Keyframes follow each other in time from 0, each payload covers the string exactly
+    const led_show_t show = { .data = bank + entry.dataOffset, .dataSize = entry.dataSize, .durationMs = entry.durationMs, .ledCount = entry.ledCount, .keyframeCount = entry.keyframeCount };
+    uint32_t offset = 0;
+    uint32_t previousTimeMs = 0;
+    for (uint32_t keyframeIndex = 0; keyframeIndex < entry.keyframeCount; keyframeIndex++) {
+        led_show_keyframe_t keyframe;
+        if (get_led_show_keyframe(&show, offset, &keyframe) != ESP_OK) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        if ((offset + LedShowKeyframeHeaderSize + keyframe.payloadSize > entry.dataSize) || (keyframe.curve >= LedShowCurveMax)) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        if (((keyframeIndex == 0) ? (keyframe.timeMs != 0) : (keyframe.timeMs <= previousTimeMs)) || (keyframe.timeMs >= entry.durationMs)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        if (!check_led_show_payload(keyframe.payload, keyframe.payloadSize, entry.ledCount)) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        previousTimeMs = keyframe.timeMs;
+        offset = keyframe.nextOffset;
+    }
+
+    return ESP_OK;
+}
+
+static bool check_led_show_payload(const uint8_t* payload, uint32_t payloadSize, uint32_t ledCount) {
+    uint32_t position = 0;
+    uint32_t pixelCount = 0;
+    while (position < payloadSize) {
+        const uint32_t operation = payload[position] & LED_SHOW_RUN_OPERATION_MASK;
+        const uint32_t length = (payload[position] & LED_SHOW_RUN_LENGTH_MASK) + 1;
+        position++;
+        switch (operation) {
+            case LED_SHOW_RUN_KEEP:
+                break;
+            case LED_SHOW_RUN_FILL:
+                position += LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+                break;
+            case LED_SHOW_RUN_LITERAL:
+                position += length * LED_FRAMEBUFFER_BYTES_PER_PIXEL;
+                break;
+            default:
+                return false;
+        }
+        pixelCount += length;
+    }
+    return (position == payloadSize) && (pixelCount == ledCount);
+}
+
+#endif
\ No newline at end of file
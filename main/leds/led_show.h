@@ -0,0 +1,86 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+#include <esp_err.h>
+
+#include "sdkconfig.h"
+
+#include "leds/led_framebuffer.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+
+// -----------------------------------------------------------------------------------
+// Light show bank stored in the 'shows' data partition - Built by tools/build_led_shows.py
+//
+//  Header (12 bytes):  char[4] "HTLS", uint16_t version (1), uint16_t showCount, uint32_t totalSize
+//  Entries (16 bytes): uint32_t dataOffset, uint32_t dataSize, uint32_t durationMs, uint16_t ledCount, uint16_t keyframeCount
+//  Keyframes of each show, 4 bytes aligned:
+//      uint32_t timeMs, uint16_t payloadSize, uint8_t curve, uint8_t reserved - Times rise from 0
+//      Payload - Runs of pixels against the previous keyframe (black for the first one), one code byte each:
+//          00nnnnnn            n + 1 pixels unchanged
+//          01nnnnnn r g b      n + 1 pixels of one color
+//          10nnnnnn rgb...     n + 1 pixels, one color each
+//  Each keyframe shows from its time and moves to the next one along its curve - The last one holds until durationMs
+//
+// The bank is memory mapped and checked once when mounted - Keyframes are decoded straight from flash
+// -----------------------------------------------------------------------------------
+
+// Run codes - Two bits of operation, six bits of length minus one
+#define LED_SHOW_RUN_KEEP 0x00
+#define LED_SHOW_RUN_FILL 0x40
+#define LED_SHOW_RUN_LITERAL 0x80
+#define LED_SHOW_RUN_OPERATION_MASK 0xC0
+#define LED_SHOW_RUN_LENGTH_MASK 0x3F
+#define LED_SHOW_RUN_MAX_LENGTH 64
+
+typedef enum {
+    LedShowCurveStep = 0,       // Holds, then jumps to the next keyframe
+    LedShowCurveLinear = 1,
+    LedShowCurveEaseIn = 2,
+    LedShowCurveEaseOut = 3,
+    LedShowCurveEaseInOut = 4,
+
+    LedShowCurveMax
+} led_show_curve_t;
+
+typedef struct {
+    const uint8_t* data;        // Flash mapped keyframes
+    uint32_t dataSize;
+    uint32_t durationMs;
+    uint32_t ledCount;
+    uint32_t keyframeCount;
+} led_show_t;
+
+typedef struct {
+    uint32_t timeMs;
+    led_show_curve_t curve;
+    const uint8_t* payload;
+    uint32_t payloadSize;
+    uint32_t nextOffset;        // Of the next keyframe in the show data - dataSize after the last one
+} led_show_keyframe_t;
+
+
+esp_err_t mount_led_show_bank();
+
+uint32_t get_led_show_count();
+esp_err_t get_led_show(uint32_t showIndex, led_show_t* show);
+
+// Keyframe at 'offset' in the show data - ESP_ERR_NOT_FOUND past the last one
+esp_err_t get_led_show_keyframe(const led_show_t* show, uint32_t offset, led_show_keyframe_t* keyframe);
+
+// Apply 'keyframe' onto the previous keyframe in 'pixels' (packed RGB) - Pixels past 'pixelCount' are dropped
+void apply_led_show_keyframe(const led_show_keyframe_t* keyframe, uint8_t* pixels, uint32_t pixelCount);
+
+// Blend the previous keyframe in 'pixels' towards 'next' at 'weight' (0 to 256) into 'output' - 'next' is decoded on the fly
+void interpolate_led_show_keyframe(const uint8_t* pixels, const led_show_keyframe_t* next, uint32_t weight, led_framebuffer_t* output);
+
+// Weight of the next keyframe 'progress' (0 to 256) of the way to it
+uint32_t get_led_show_curve_weight(led_show_curve_t curve, uint32_t progress);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdbool.h>
+
+#include "sdkconfig.h"
+
+#include "leds/led_geometry.h"
+#include "leds/led_transition.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_TRANSITIONS
+
+// Width of the soft edge of a wipe and of the fade of each dissolving pixel, in 256th of the key range - Powers of two
+#define WIPE_EDGE_WIDTH 32
+#define DISSOLVE_FADE_WIDTH 16
+
+
+static void blend_led_transition_ramp(const led_framebuffer_t* from, const led_framebuffer_t* to, uint32_t progress, uint32_t width, bool wipe, led_framebuffer_t* output);
+
+static inline uint8_t blend_level(uint32_t from, uint32_t to, uint32_t weight) {
+    return (uint8_t) ((from * (LED_TRANSITION_PROGRESS_FULL - weight) + to * weight) >> 8);
+}
+
+
+void blend_led_transition(led_transition_kind_t kind, const led_framebuffer_t* from, const led_framebuffer_t* to, uint32_t progress, led_framebuffer_t* output) {
+    if (progress > LED_TRANSITION_PROGRESS_FULL) {
+        progress = LED_TRANSITION_PROGRESS_FULL;
+    }
+
+    switch (kind) {
+        case LedTransitionWipe:
+            blend_led_transition_ramp(from, to, progress, WIPE_EDGE_WIDTH, true, output);
+            break;
+
+        case LedTransitionDissolve:
+            blend_led_transition_ramp(from, to, progress, DISSOLVE_FADE_WIDTH, false, output);
+            break;
+
+        case LedTransitionLinear:
+        default: {
+            // One weight for every byte
+            const uint8_t* fromLevel = from->pixels;
+            const uint8_t* toLevel = to->pixels;
+            uint8_t* outputLevel = output->pixels;
+            for (const uint8_t* const end = fromLevel + output->pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL; fromLevel < end; fromLevel++, toLevel++, outputLevel++) {
+                *outputLevel = blend_level(*fromLevel, *toLevel, progress);
+            }
+        }
+        break;
+    }
+}
+
+const char* get_led_transition_name(led_transition_kind_t kind) {
+    switch (kind) {
+        case LedTransitionLinear:
+            return "linear";
+        case LedTransitionWipe:
+            return "wipe";
+        case LedTransitionDissolve:
+            return "dissolve";
+        default:
+            return "N/A";
+    }
+}
+
+static void blend_led_transition_ramp(const led_framebuffer_t* from, const led_framebuffer_t* to, uint32_t progress, uint32_t width, bool wipe, led_framebuffer_t* output) {
+    // Each pixel has a key from 0 to 255 and fades in while the edge, which runs from 0 to 256 + width, goes past it
+    const led_position_t* positions = wipe ? get_led_positions(output->pixelCount) : NULL;
+    const uint32_t pixelCount = output->pixelCount;
+    const int32_t edge = (int32_t) ((progress * (LED_TRANSITION_PROGRESS_FULL + width)) >> 8);
+    const int32_t slope = (int32_t) (LED_TRANSITION_PROGRESS_FULL / width);
+
+    const uint8_t* fromPixel = from->pixels;
+    const uint8_t* toPixel = to->pixels;
+    uint8_t* outputPixel = output->pixels;
+    for (uint32_t index = 0; index < pixelCount; index++, fromPixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL, toPixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL, outputPixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        int32_t key;
+        if (wipe) {
+            // Bottom up - String order when there is no geometry
+            key = positions != NULL ? positions[index].height : (pixelCount > 1 ? (int32_t) ((index * 255) / (pixelCount - 1)) : 0);
+        } else {
+            // Multiplicative hash - A fixed order which looks random and needs no state
+            key = (int32_t) (((uint32_t) (index + 1) * 2654435761U) >> 24);
+        }
+
+        int32_t weight = (edge - key) * slope;
+        weight = weight < 0 ? 0 : (weight > LED_TRANSITION_PROGRESS_FULL ? LED_TRANSITION_PROGRESS_FULL : weight);
+        outputPixel[0] = blend_level(fromPixel[0], toPixel[0], (uint32_t) weight);
+        outputPixel[1] = blend_level(fromPixel[1], toPixel[1], (uint32_t) weight);
+        outputPixel[2] = blend_level(fromPixel[2], toPixel[2], (uint32_t) weight);
+    }
+}
+
+#endif
\ No newline at end of file
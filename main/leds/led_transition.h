@@ -0,0 +1,39 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+#include "sdkconfig.h"
+
+#include "leds/led_framebuffer.h"
+
+
+// -----------------------------------------------------------------------------------
+// Transitions between LED effects - The renderer runs the outgoing and the incoming effects in their own framebuffers
+// for CONFIG_HOLIDAYTREE_LEDS_TRANSITION_MS and blends them per pixel into the frame it sends
+//
+//  * Linear crossfades every pixel at once
+//  * Wipe sweeps the incoming effect up the tree with a soft edge, following the LED geometry
+//  * Dissolve switches pixels over one by one in a fixed pseudo random order, each with a short fade
+//  * 8 bits fixed point weights, no allocation - The incoming frame is exact at full progress
+// -----------------------------------------------------------------------------------
+
+// Transition progress - 0 shows the outgoing effect, LED_TRANSITION_PROGRESS_FULL the incoming one
+#define LED_TRANSITION_PROGRESS_FULL 256
+
+typedef enum {
+    LedTransitionLinear = 0,
+    LedTransitionWipe = 1,
+    LedTransitionDissolve = 2,
+
+    LedTransitionMax
+} led_transition_kind_t;
+
+
+// Blend 'from' and 'to' into 'output' at 'progress' - All framebuffers have the same pixel count, 'output' may be 'to'
+void blend_led_transition(led_transition_kind_t kind, const led_framebuffer_t* from, const led_framebuffer_t* to, uint32_t progress, led_framebuffer_t* output);
+
+const char* get_led_transition_name(led_transition_kind_t kind);
\ No newline at end of file
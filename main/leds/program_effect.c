@@ -0,0 +1,82 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include "sdkconfig.h"
+
+#include "leds/led_effect.h"
+#include "leds/led_math.h"
+#include "leds/led_program.h"
+#include "leds/program_effect.h"
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+#include "audio/audio_spectrum.h"
+#endif
+#if CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION
+#include "audio/audio_beat.h"
+#endif
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+
+// Band levels are RMS in 16 bits sample units - Loud music reaches 255 after the shift
+static const uint32_t BandLevelShift = 6;
+
+
+typedef struct {
+    uint32_t random;
+} program_state_t;
+
+_Static_assert(sizeof(program_state_t) <= LED_EFFECT_STATE_MAX_SIZE, "Program state does not fit LED_EFFECT_STATE_MAX_SIZE");
+
+
+static void step_program_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+
+static inline int32_t get_band_level(uint32_t level) {
+    level >>= BandLevelShift;
+    return (int32_t) (level > 255 ? 255 : level);
+}
+
+
+const led_effect_t ProgramLedEffect = {
+    .name = "program",
+    .stateSize = sizeof(program_state_t),
+    .step = &step_program_effect
+};
+
+
+static void step_program_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    program_state_t* programState = (program_state_t*) state;
+    if (now->frameIndex == 0) {
+        seed_led_random(&programState->random, (uint32_t) now->presentationTimeUs);
+    }
+
+    led_program_frame_t frame = { .timeMs = (int32_t) (now->timeUs / 1000) };
+
+    // The music heard when the frame is shown - Levels stay at 0 without audio analysis
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+    audio_spectrum_snapshot_t spectrum;
+    if (get_audio_spectrum_snapshot_at(now->presentationTimeUs, &spectrum) && (spectrum.sequence != 0)) {
+        uint32_t loudest = 0;
+        for (uint32_t band = 0; band < AUDIO_SPECTRUM_BAND_COUNT; band++) {
+            loudest = spectrum.bands[band] > loudest ? spectrum.bands[band] : loudest;
+        }
+        frame.bassLevel = get_band_level(spectrum.bands[0]);
+        frame.level = get_band_level(loudest);
+    }
+#endif
+#if CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION
+    audio_beat_snapshot_t beat;
+    if (get_audio_beat_snapshot_at(now->presentationTimeUs, &beat)) {
+        frame.beatPhase = beat.beatPhase >> 8;
+        frame.beatCount = (int32_t) beat.beatCount;
+    }
+#endif
+
+    // Picked up on every frame - A program committed from the console runs from the next frame
+    if (!run_current_led_program(&frame, &programState->random, framebuffer)) {
+        clear_led_framebuffer(framebuffer);
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "leds/led_effect.h"
+
+
+// Runs the current LED program (leds/led_program.h) on every pixel, fed with the time, the LED geometry and the music
+extern const led_effect_t ProgramLedEffect;
\ No newline at end of file
@@ -2,56 +2,97 @@
 // Copyright 2024, Gilles Zunino
 // -----------------------------------------------------------------------------------
 
-#include <freertos/portmacro.h>
+#include <stdlib.h>
 
 #include "leds/led_effect.h"
+#include "leds/led_geometry.h"
 #include "leds/progressive_reveal_effect.h"
 
 
-// LED indices on the board
-#define CENTER_LED_INDEX 0
+// LEDs within this distance of the trunk, left to right, are in the center column
+#define CENTER_COLUMN_HALF_WIDTH 16
 
-#define RIGHT_LED1_INDEX 1
-#define RIGHT_LED2_INDEX 2
+typedef enum {
+    RevealRegionCenter = 0,     // White
+    RevealRegionRight = 1,      // Red
+    RevealRegionLeft = 2        // Green
+} reveal_region_t;
 
-#define LEFT_LED1_INDEX 3
-#define LEFT_LED2_INDEX 4
 
+// A fifth of the LEDs is revealed per step - All off, then all LEDs
+static const int64_t TimePerStepUs = 1000000;
+static const uint32_t StepCount = 6;
 
-led_animation_task_notification_t progressive_reveal_led_effect() {
-    const TickType_t TimePerFrameMs = 1000;
-    for (;;) {
-        // All Off
-        clear_led_string();
-        refresh_led_string();
-        WAIT_OR_END_EFFECT(TimePerFrameMs);
 
-        // Center LED On - white
-        set_led_string_pixel(CENTER_LED_INDEX, 255, 255, 255);
-        refresh_led_string();
-        WAIT_OR_END_EFFECT(TimePerFrameMs);
+typedef struct {
+    uint16_t revealOrder[CONFIG_HOLIDAYTREE_LEDS_COUNT];    // LED indices in reveal order - Computed on the first step
+} progressive_reveal_state_t;
 
-        // Right 1 LED on - Red
-        set_led_string_pixel(RIGHT_LED1_INDEX, 255, 0, 0);
-        refresh_led_string();
-        WAIT_OR_END_EFFECT(TimePerFrameMs);
+_Static_assert(sizeof(progressive_reveal_state_t) <= LED_EFFECT_STATE_MAX_SIZE, "Progressive reveal state does not fit LED_EFFECT_STATE_MAX_SIZE");
 
-        // Right 2 LED on - Red
-        set_led_string_pixel(RIGHT_LED2_INDEX, 255, 0, 0);
-        refresh_led_string();
-        WAIT_OR_END_EFFECT(TimePerFrameMs);
 
-        // Left 1 LED on - Green
-        set_led_string_pixel(LEFT_LED1_INDEX, 0, 255, 0);
-        refresh_led_string();
-        WAIT_OR_END_EFFECT(TimePerFrameMs);
+static void step_progressive_reveal_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+static reveal_region_t get_reveal_region(const led_position_t* position);
+static int compare_reveal_order(const void* left, const void* right);
 
-        // Left 2 LED on - Green
-        set_led_string_pixel(LEFT_LED2_INDEX, 0, 255, 0);
-        refresh_led_string();
-        WAIT_OR_END_EFFECT(TimePerFrameMs);
 
-        // Hold the fully lit step before cycling
-        //WAIT_OR_END_EFFECT(TimePerFrameMs);
+const led_effect_t ProgressiveRevealLedEffect = {
+    .name = "progressive_reveal",
+    .stateSize = sizeof(progressive_reveal_state_t),
+    .step = &step_progressive_reveal_effect
+};
+
+
+static void step_progressive_reveal_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    progressive_reveal_state_t* reveal = (progressive_reveal_state_t*) state;
+    const uint32_t ledCount = framebuffer->pixelCount < CONFIG_HOLIDAYTREE_LEDS_COUNT ? framebuffer->pixelCount : CONFIG_HOLIDAYTREE_LEDS_COUNT;
+    const led_position_t* positions = get_led_positions(ledCount);
+    if (now->frameIndex == 0) {
+        for (uint32_t index = 0; index < ledCount; index++) {
+            reveal->revealOrder[index] = (uint16_t) index;
+        }
+        if (positions != NULL) {
+            qsort(reveal->revealOrder, ledCount, sizeof(reveal->revealOrder[0]), &compare_reveal_order);
+        }
     }
+
+    // The center column first, then the right side and the left side, each from the top down - One LED per step on the board
+    const uint32_t step = (uint32_t) ((now->timeUs / TimePerStepUs) % StepCount);
+    const uint32_t revealedCount = (ledCount * step) / (StepCount - 1);
+
+    // All Off
+    clear_led_framebuffer(framebuffer);
+
+    for (uint32_t rank = 0; rank < revealedCount; rank++) {
+        const uint32_t index = reveal->revealOrder[rank];
+        switch (positions != NULL ? get_reveal_region(&positions[index]) : RevealRegionCenter) {
+            case RevealRegionCenter:
+                set_led_framebuffer_pixel(framebuffer, index, 255, 255, 255);
+                break;
+            case RevealRegionRight:
+                set_led_framebuffer_pixel(framebuffer, index, 255, 0, 0);
+                break;
+            case RevealRegionLeft:
+                set_led_framebuffer_pixel(framebuffer, index, 0, 255, 0);
+                break;
+        }
+    }
+}
+
+static reveal_region_t get_reveal_region(const led_position_t* position) {
+    const int32_t offset = (int32_t) position->x - 128;
+    if (abs(offset) < CENTER_COLUMN_HALF_WIDTH) {
+        return RevealRegionCenter;
+    }
+    return offset > 0 ? RevealRegionRight : RevealRegionLeft;
+}
+
+static int compare_reveal_order(const void* left, const void* right) {
+    // Region first then from the top down - LED index breaks ties so the order does not depend on qsort()
+    const led_position_t* positions = get_led_positions(CONFIG_HOLIDAYTREE_LEDS_COUNT);
+    const uint32_t leftIndex = *(const uint16_t*) left;
+    const uint32_t rightIndex = *(const uint16_t*) right;
+    const int32_t leftKey = (int32_t) ((get_reveal_region(&positions[leftIndex]) << 8) | (255 - positions[leftIndex].height));
+    const int32_t rightKey = (int32_t) ((get_reveal_region(&positions[rightIndex]) << 8) | (255 - positions[rightIndex].height));
+    return leftKey != rightKey ? leftKey - rightKey : (int32_t) leftIndex - (int32_t) rightIndex;
 }
\ No newline at end of file
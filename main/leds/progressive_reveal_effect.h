@@ -4,5 +4,8 @@
 
 #pragma once
 
+#include "leds/led_effect.h"
 
-led_animation_task_notification_t progressive_reveal_led_effect();
\ No newline at end of file
+
+// The center column, then the right and the left sides of the tree light up from the top down, one fifth of the LEDs a second
+extern const led_effect_t ProgressiveRevealLedEffect;
\ No newline at end of file
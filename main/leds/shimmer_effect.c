@@ -0,0 +1,48 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include "leds/led_effect.h"
+#include "leds/led_geometry.h"
+#include "leds/led_math.h"
+#include "leds/shimmer_effect.h"
+
+
+// Noise cells across the tree, and noise cells the pattern drifts through a second
+static const int32_t CellsPerTree = 3;
+static const int64_t DriftCellsPerSecond = 1;
+
+// Deep blue where the noise is low, white where it peaks
+static const uint8_t DeepBlue[3] = { 0, 24, 96 };
+
+
+static void step_shimmer_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+
+
+// Stateless - Every frame only depends on the time
+const led_effect_t ShimmerLedEffect = {
+    .name = "shimmer",
+    .stateSize = 0,
+    .step = &step_shimmer_effect
+};
+
+
+static void step_shimmer_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    const led_position_t* positions = get_led_positions(framebuffer->pixelCount);
+    const uint32_t ledCount = framebuffer->pixelCount;
+    const int32_t time = (int32_t) (((now->timeUs * DriftCellsPerSecond * LED_NOISE_CELL) / 1000000) % LED_NOISE_3D_PERIOD);
+
+    uint8_t* pixel = framebuffer->pixels;
+    for (uint32_t index = 0; index < ledCount; index++, pixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        // Positions are 8 bits - Tree coordinates times CellsPerTree are noise coordinates
+        const led_position_t position = get_led_position(positions, index, ledCount);
+        const int32_t noise = led_noise_3d(position.x * CellsPerTree, position.height * CellsPerTree, time);
+
+        // Squared to keep highlights sparse
+        const uint32_t level = (uint32_t) (128 + (noise >> 8));
+        const uint32_t highlight = (level * level) >> 8;
+        pixel[0] = (uint8_t) (DeepBlue[0] + (((255 - DeepBlue[0]) * highlight) >> 8));
+        pixel[1] = (uint8_t) (DeepBlue[1] + (((255 - DeepBlue[1]) * highlight) >> 8));
+        pixel[2] = (uint8_t) (DeepBlue[2] + (((255 - DeepBlue[2]) * highlight) >> 8));
+    }
+}
\ No newline at end of file
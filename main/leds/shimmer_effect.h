@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "leds/led_effect.h"
+
+
+// Blue and white light shimmers over the tree, following 3D noise drifting over time
+extern const led_effect_t ShimmerLedEffect;
\ No newline at end of file
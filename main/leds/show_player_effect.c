@@ -0,0 +1,94 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <string.h>
+
+#include "sdkconfig.h"
+
+#include "leds/led_effect.h"
+#include "leds/led_show.h"
+#include "leds/show_player_effect.h"
+
+
+#if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+
+typedef struct {
+    uint32_t showIndex;
+    int64_t showStartUs;                // Effect time the show started
+    led_show_keyframe_t keyframe;       // Decoded in 'keyframePixels'
+    bool decoded;
+    uint8_t keyframePixels[CONFIG_HOLIDAYTREE_LEDS_COUNT * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+} show_player_state_t;
+
+_Static_assert(sizeof(show_player_state_t) <= LED_EFFECT_STATE_MAX_SIZE, "Show player state does not fit LED_EFFECT_STATE_MAX_SIZE");
+
+
+static void step_show_player_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+static void start_show(show_player_state_t* player, const led_show_t* show, int64_t startUs);
+
+
+const led_effect_t ShowPlayerLedEffect = {
+    .name = "show_player",
+    .stateSize = sizeof(show_player_state_t),
+    .step = &step_show_player_effect
+};
+
+
+static void step_show_player_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    show_player_state_t* player = (show_player_state_t*) state;
+    const uint32_t pixelCount = framebuffer->pixelCount < CONFIG_HOLIDAYTREE_LEDS_COUNT ? framebuffer->pixelCount : CONFIG_HOLIDAYTREE_LEDS_COUNT;
+
+    const uint32_t showCount = get_led_show_count();
+    led_show_t show;
+    if ((showCount == 0) || (get_led_show(player->showIndex % showCount, &show) != ESP_OK)) {
+        clear_led_framebuffer(framebuffer);
+        return;
+    }
+    if (!player->decoded) {
+        start_show(player, &show, now->timeUs);
+    }
+
+    // Next show once this one is over - Skipped frames may jump over a short show
+    while (now->timeUs - player->showStartUs >= (int64_t) show.durationMs * 1000) {
+        const int64_t startUs = player->showStartUs + (int64_t) show.durationMs * 1000;
+        player->showIndex = (player->showIndex + 1) % showCount;
+        get_led_show(player->showIndex, &show);
+        start_show(player, &show, startUs);
+    }
+
+    // Keyframes reached since the last frame are applied in order - Each one is a delta from the one before
+    const uint32_t showTimeMs = (uint32_t) ((now->timeUs - player->showStartUs) / 1000);
+    led_show_keyframe_t next;
+    bool hasNext = get_led_show_keyframe(&show, player->keyframe.nextOffset, &next) == ESP_OK;
+    while (hasNext && (showTimeMs >= next.timeMs)) {
+        apply_led_show_keyframe(&next, player->keyframePixels, CONFIG_HOLIDAYTREE_LEDS_COUNT);
+        player->keyframe = next;
+        hasNext = get_led_show_keyframe(&show, player->keyframe.nextOffset, &next) == ESP_OK;
+    }
+
+    // The last keyframe holds until the end of the show
+    const uint32_t nextTimeMs = hasNext ? next.timeMs : show.durationMs;
+    const uint32_t progress = ((showTimeMs - player->keyframe.timeMs) * 256) / (nextTimeMs - player->keyframe.timeMs);
+    const uint32_t weight = hasNext ? get_led_show_curve_weight(player->keyframe.curve, progress) : 0;
+    led_framebuffer_t output = { .pixels = framebuffer->pixels, .pixelCount = pixelCount };
+    if (weight == 0) {
+        memcpy(output.pixels, player->keyframePixels, pixelCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL);
+        if (show.ledCount < pixelCount) {
+            memset(&output.pixels[show.ledCount * LED_FRAMEBUFFER_BYTES_PER_PIXEL], 0, (pixelCount - show.ledCount) * LED_FRAMEBUFFER_BYTES_PER_PIXEL);
+        }
+    } else {
+        interpolate_led_show_keyframe(player->keyframePixels, &next, weight, &output);
+    }
+}
+
+static void start_show(show_player_state_t* player, const led_show_t* show, int64_t startUs) {
+    // The first keyframe is a delta from black
+    memset(player->keyframePixels, 0, sizeof(player->keyframePixels));
+    get_led_show_keyframe(show, 0, &player->keyframe);
+    apply_led_show_keyframe(&player->keyframe, player->keyframePixels, CONFIG_HOLIDAYTREE_LEDS_COUNT);
+    player->showStartUs = startUs;
+    player->decoded = true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "leds/led_effect.h"
+
+
+// Plays the light shows of the 'shows' partition one after the other, then starts over - Dark without shows
+extern const led_effect_t ShowPlayerLedEffect;
\ No newline at end of file
@@ -0,0 +1,105 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdlib.h>
+
+#include "leds/led_effect.h"
+#include "leds/led_geometry.h"
+#include "leds/led_math.h"
+#include "leds/snowfall_effect.h"
+
+
+#define SNOWFLAKE_COUNT 12
+
+// Flakes fall MinimumFallSpeed to MinimumFallSpeed + FallSpeedRange height units a second - The tree is 256 high
+static const uint32_t MinimumFallSpeed = 32;
+static const uint32_t FallSpeedRange = 64;
+
+// Flakes light LEDs within FlakeRadius, counting a 256th of a turn around the trunk as half a height unit
+static const int32_t FlakeRadius = 20;
+
+static const uint8_t NightBlue = 12;
+
+// Longest time step simulated - Longer gaps do not teleport flakes
+static const int64_t MaximumStepUs = 250000;
+
+
+typedef struct {
+    uint16_t height;    // Q8
+    uint8_t angle;
+    uint8_t speed;
+} snowflake_t;
+
+typedef struct {
+    uint32_t random;
+    int64_t lastTimeUs;
+    snowflake_t flakes[SNOWFLAKE_COUNT];
+} snowfall_state_t;
+
+_Static_assert(sizeof(snowfall_state_t) <= LED_EFFECT_STATE_MAX_SIZE, "Snowfall state does not fit LED_EFFECT_STATE_MAX_SIZE");
+
+
+static void step_snowfall_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+static void start_snowflake(snowflake_t* flake, uint32_t* random, uint32_t height);
+
+
+const led_effect_t SnowfallLedEffect = {
+    .name = "snowfall",
+    .stateSize = sizeof(snowfall_state_t),
+    .step = &step_snowfall_effect
+};
+
+
+static void step_snowfall_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    snowfall_state_t* snowfall = (snowfall_state_t*) state;
+    if (now->frameIndex == 0) {
+        // Flakes are spread over the tree from the start
+        seed_led_random(&snowfall->random, (uint32_t) now->presentationTimeUs);
+        snowfall->lastTimeUs = now->timeUs;
+        for (uint32_t index = 0; index < SNOWFLAKE_COUNT; index++) {
+            start_snowflake(&snowfall->flakes[index], &snowfall->random, next_led_random_below(&snowfall->random, 256));
+        }
+    }
+
+    int64_t elapsedUs = now->timeUs - snowfall->lastTimeUs;
+    elapsedUs = elapsedUs < MaximumStepUs ? elapsedUs : MaximumStepUs;
+    snowfall->lastTimeUs = now->timeUs;
+    for (uint32_t index = 0; index < SNOWFLAKE_COUNT; index++) {
+        snowflake_t* flake = &snowfall->flakes[index];
+        const uint32_t fall = (uint32_t) ((flake->speed * elapsedUs * 256) / 1000000);
+        if (fall >= flake->height) {
+            start_snowflake(flake, &snowfall->random, 255);
+        } else {
+            flake->height = (uint16_t) (flake->height - fall);
+        }
+    }
+
+    const led_position_t* positions = get_led_positions(framebuffer->pixelCount);
+    const uint32_t ledCount = framebuffer->pixelCount;
+    uint8_t* pixel = framebuffer->pixels;
+    for (uint32_t index = 0; index < ledCount; index++, pixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        const led_position_t position = get_led_position(positions, index, ledCount);
+        int32_t level = 0;
+        for (uint32_t flakeIndex = 0; flakeIndex < SNOWFLAKE_COUNT; flakeIndex++) {
+            const snowflake_t* flake = &snowfall->flakes[flakeIndex];
+            // Without geometry flakes fall along the string
+            const int32_t around = positions != NULL ? abs((int8_t) (position.angle - flake->angle)) / 2 : 0;
+            const int32_t distance = abs((int32_t) position.height - (flake->height >> 8)) + around;
+            if (distance < FlakeRadius) {
+                const int32_t flakeLevel = ((FlakeRadius - distance) * 255) / FlakeRadius;
+                level = flakeLevel > level ? flakeLevel : level;
+            }
+        }
+
+        pixel[0] = (uint8_t) level;
+        pixel[1] = (uint8_t) level;
+        pixel[2] = (uint8_t) (level > NightBlue ? level : NightBlue);
+    }
+}
+
+static void start_snowflake(snowflake_t* flake, uint32_t* random, uint32_t height) {
+    flake->height = (uint16_t) (height << 8);
+    flake->angle = (uint8_t) next_led_random(random);
+    flake->speed = (uint8_t) (MinimumFallSpeed + next_led_random_below(random, FallSpeedRange));
+}
\ No newline at end of file
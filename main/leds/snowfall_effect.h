@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "leds/led_effect.h"
+
+
+// Snowflakes fall down the tree over a dim blue night
+extern const led_effect_t SnowfallLedEffect;
\ No newline at end of file
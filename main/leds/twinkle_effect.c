@@ -0,0 +1,82 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include "leds/led_effect.h"
+#include "leds/led_math.h"
+#include "leds/twinkle_effect.h"
+
+
+// A twinkle rises and falls in TwinkleDurationUs - LEDs stay dark MeanDarkUs on average, so a quarter of them are lit
+static const int64_t TwinkleDurationUs = 1200000;
+static const int64_t MeanDarkUs = 3600000;
+
+// One twinkle in ColoredTwinkleOdds has a random hue, the others are warm white
+static const uint32_t ColoredTwinkleOdds = 4;
+static const uint8_t WarmWhite[3] = { 255, 170, 80 };
+
+// Longest time step simulated - Longer gaps restart the twinkles rather than fast forward
+static const int64_t MaximumStepUs = 250000;
+
+
+typedef struct {
+    uint32_t random;
+    int64_t lastTimeUs;
+    uint16_t phases[CONFIG_HOLIDAYTREE_LEDS_COUNT];     // Position in the twinkle - 0 while dark
+    uint8_t hues[CONFIG_HOLIDAYTREE_LEDS_COUNT];        // 0 for warm white, hue + 1 otherwise
+} twinkle_state_t;
+
+_Static_assert(sizeof(twinkle_state_t) <= LED_EFFECT_STATE_MAX_SIZE, "Twinkle state does not fit LED_EFFECT_STATE_MAX_SIZE");
+
+
+static void step_twinkle_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer);
+
+
+const led_effect_t TwinkleLedEffect = {
+    .name = "twinkle",
+    .stateSize = sizeof(twinkle_state_t),
+    .step = &step_twinkle_effect
+};
+
+
+static void step_twinkle_effect(void* state, const led_frame_time_t* now, led_framebuffer_t* framebuffer) {
+    twinkle_state_t* twinkle = (twinkle_state_t*) state;
+    const uint32_t ledCount = framebuffer->pixelCount < CONFIG_HOLIDAYTREE_LEDS_COUNT ? framebuffer->pixelCount : CONFIG_HOLIDAYTREE_LEDS_COUNT;
+    if (now->frameIndex == 0) {
+        seed_led_random(&twinkle->random, (uint32_t) now->presentationTimeUs);
+        twinkle->lastTimeUs = now->timeUs;
+    }
+
+    int64_t elapsedUs = now->timeUs - twinkle->lastTimeUs;
+    elapsedUs = elapsedUs < MaximumStepUs ? elapsedUs : MaximumStepUs;
+    twinkle->lastTimeUs = now->timeUs;
+
+    // Phases and odds are 16 bits fractions of the time step
+    const uint32_t advance = (uint32_t) ((elapsedUs * 65536) / TwinkleDurationUs);
+    const uint32_t startOdds = (uint32_t) ((elapsedUs * 65536) / MeanDarkUs);
+
+    uint8_t* pixel = framebuffer->pixels;
+    for (uint32_t index = 0; index < ledCount; index++, pixel += LED_FRAMEBUFFER_BYTES_PER_PIXEL) {
+        uint32_t phase = twinkle->phases[index];
+        if (phase == 0) {
+            if ((next_led_random(&twinkle->random) >> 16) < startOdds) {
+                phase = 1;
+                twinkle->hues[index] = next_led_random_below(&twinkle->random, ColoredTwinkleOdds) == 0 ? (uint8_t) (1 + next_led_random_below(&twinkle->random, 255)) : 0;
+            }
+        } else {
+            phase += advance;
+            phase = phase < 65536 ? phase : 0;
+        }
+        twinkle->phases[index] = (uint16_t) phase;
+
+        // Half a sine wave over the twinkle
+        const uint32_t level = phase != 0 ? (uint32_t) led_sin16((uint16_t) (phase >> 1)) >> 7 : 0;
+        if (twinkle->hues[index] == 0) {
+            pixel[0] = (uint8_t) ((WarmWhite[0] * level) >> 8);
+            pixel[1] = (uint8_t) ((WarmWhite[1] * level) >> 8);
+            pixel[2] = (uint8_t) ((WarmWhite[2] * level) >> 8);
+        } else {
+            get_led_hue_color(twinkle->hues[index] - 1, (uint8_t) level, &pixel[0], &pixel[1], &pixel[2]);
+        }
+    }
+}
\ No newline at end of file
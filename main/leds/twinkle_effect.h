@@ -0,0 +1,11 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "leds/led_effect.h"
+
+
+// LEDs twinkle at random, mostly warm white with a few colors, a quarter of the string lit at a time
+extern const led_effect_t TwinkleLedEffect;
\ No newline at end of file
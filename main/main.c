@@ -21,8 +21,39 @@
 
 #include "leds/led_init.h"
 #include "leds/led_animator.h"
+#if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+#include "leds/led_show.h"
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+#include "leds/led_program.h"
+#endif
 
 #include "bt/bt_init.h"
+#include "bt/i2s_output.h"
+
+#include "audio/sound_bank.h"
+#include "audio/audio_resampler.h"
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+#include "audio/audio_spectrum.h"
+#endif
+
+#if CONFIG_HOLIDAYTREE_CONSOLE
+#include "console/console_init.h"
+#include "leds/led_geometry.h"
+#endif
+
+#if CONFIG_HOLIDAYTREE_A2DP_TRACE_CAPTURE
+#include "bt/bt_a2d_trace.h"
+#endif
+
+#if CONFIG_HOLIDAYTREE_AUDIO_BENCHMARK
+#include "audio/audio_benchmark.h"
+#endif
+
+#if CONFIG_HOLIDAYTREE_LEDS_BENCHMARK
+#include "leds/led_benchmark.h"
+#endif
 
 
 
@@ -64,9 +95,19 @@ static const char* MainTag = "app_main";
 
 
 
+// Next sound bank entry to play when the button is pressed
+static uint32_t s_next_sound_index = 0;
+
+
 static void on_momentary_button_pressed(void) {
     ESP_LOGI(MainTag, "on_momentary_button_pressed() Button pressed");
-    // Currently no action
+
+    // Play the jingles from the sound bank one after the other
+    const uint32_t soundCount = get_sound_bank_sound_count();
+    if (soundCount > 0) {
+        ESP_ERROR_CHECK_WITHOUT_ABORT(play_i2s_output_sound(s_next_sound_index));
+        s_next_sound_index = (s_next_sound_index + 1) % soundCount;
+    }
 }
 
 
@@ -85,6 +126,27 @@ void app_main(void) {
     // Configure GPIO pin interrupts
     ESP_ERROR_CHECK(configure_gpio_isr_dispatcher());
 
+    // Mount local sounds - The tree works without them, the button just plays nothing
+    ESP_ERROR_CHECK_WITHOUT_ABORT(mount_sound_bank());
+#if CONFIG_HOLIDAYTREE_LEDS_SHOWS
+    // Mount light shows - The show player turns the tree off without them
+    ESP_ERROR_CHECK_WITHOUT_ABORT(mount_led_show_bank());
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+    // Load the LED program - A built in program runs when NVS has none
+    ESP_ERROR_CHECK(load_led_program());
+#endif
+
+#if CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM
+    // Start the spectrum analyzer before audio output feeds it
+    ESP_ERROR_CHECK(start_audio_spectrum_analyzer());
+#endif
+
+    // Configure audio output - It is shared by A2DP audio and local sounds, both converted by the resampler
+    audio_resampler_coefficients_init();
+    ESP_ERROR_CHECK(create_i2s_output());
+    ESP_ERROR_CHECK(start_i2s_output());
+
     // Configure Bluetooth Classic and start A2DP profile for tree sound player
     ESP_ERROR_CHECK(configure_bluetooth());
 
@@ -93,7 +155,48 @@ void app_main(void) {
 
     // Configure tree lights
     ESP_ERROR_CHECK(configure_led_string(LedDataGPIONum, LedSwitchGPIONum));
+#if CONFIG_HOLIDAYTREE_LEDS_LAYERED_BEAT_FLASH
+    ESP_ERROR_CHECK(start_led_string_effect(LedLayeredBeatFlashEffect));
+#elif CONFIG_HOLIDAYTREE_LEDS_BEAT_FLASH
+    ESP_ERROR_CHECK(start_led_string_effect(LedBeatFlashEffect));
+#elif CONFIG_HOLIDAYTREE_LEDS_TWINKLE
+    ESP_ERROR_CHECK(start_led_string_effect(LedTwinkleEffect));
+#elif CONFIG_HOLIDAYTREE_LEDS_FIRE
+    ESP_ERROR_CHECK(start_led_string_effect(LedFireEffect));
+#elif CONFIG_HOLIDAYTREE_LEDS_CANDLE
+    ESP_ERROR_CHECK(start_led_string_effect(LedCandleEffect));
+#elif CONFIG_HOLIDAYTREE_LEDS_COLOR_WHEEL
+    ESP_ERROR_CHECK(start_led_string_effect(LedColorWheelEffect));
+#elif CONFIG_HOLIDAYTREE_LEDS_SNOWFALL
+    ESP_ERROR_CHECK(start_led_string_effect(LedSnowfallEffect));
+#elif CONFIG_HOLIDAYTREE_LEDS_SHIMMER
+    ESP_ERROR_CHECK(start_led_string_effect(LedShimmerEffect));
+#elif CONFIG_HOLIDAYTREE_LEDS_SHOW_PLAYER
+    ESP_ERROR_CHECK(start_led_string_effect(LedShowPlayerEffect));
+#elif CONFIG_HOLIDAYTREE_LEDS_PROGRAM
+    ESP_ERROR_CHECK(start_led_string_effect(LedProgramEffect));
+#else
     ESP_ERROR_CHECK(start_led_string_effect(LedProgressiveRevealEffect));
+#endif
+
+#if CONFIG_HOLIDAYTREE_CONSOLE
+    // Configure diagnostic console and its commands
+    ESP_ERROR_CHECK(configure_console());
+    ESP_ERROR_CHECK(register_led_geometry_console_command());
+#if CONFIG_HOLIDAYTREE_LEDS_PROGRAMS
+    ESP_ERROR_CHECK(register_led_program_console_command());
+#endif
+#if CONFIG_HOLIDAYTREE_A2DP_TRACE_CAPTURE
+    ESP_ERROR_CHECK(register_a2d_trace_console_command());
+#endif
+#if CONFIG_HOLIDAYTREE_AUDIO_BENCHMARK
+    ESP_ERROR_CHECK(register_audio_benchmark_console_command());
+#endif
+#if CONFIG_HOLIDAYTREE_LEDS_BENCHMARK
+    ESP_ERROR_CHECK(register_led_benchmark_console_command());
+#endif
+    ESP_ERROR_CHECK(start_console());
+#endif
 
     // Dispatch GPIO events - This function blocks with portMAX_DELAY as timeout and never returns
     ESP_ERROR_CHECK(gpio_events_queue_dispatch());
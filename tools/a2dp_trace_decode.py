@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------------
+# Copyright 2026, Gilles Zunino
+# -----------------------------------------------------------------------------------
+"""
+Decode A2DP packet arrival traces captured with the 'a2dp_trace dump' console command.
+
+The input is a console log (for instance saved from 'idf.py monitor') containing a block
+delimited by '----- BEGIN A2DP TRACE -----' and '----- END A2DP TRACE -----'. The block is
+a hex dump of the binary format described in main/bt/bt_a2d_trace.h.
+
+Usage:
+    a2dp_trace_decode.py capture.log                  # Print CSV to stdout
+    a2dp_trace_decode.py capture.log -o trace.csv     # Write CSV
+    a2dp_trace_decode.py capture.log -b trace.bin     # Write the raw binary blob
+
+CSV columns are: timestamp_us (absolute esp_timer time), delta_us, length, ring_fill.
+A host simulator replays a trace by delivering 'length' bytes every 'delta_us'.
+"""
+
+import argparse
+import struct
+import sys
+
+
+BEGIN_MARKER = "----- BEGIN A2DP TRACE -----"
+END_MARKER = "----- END A2DP TRACE -----"
+
+HEADER_FORMAT = "<4sBBHIIQI"
+RECORD_FORMAT = "<IHH"
+MAGIC = b"HTA2"
+
+
+def extract_blob(lines):
+    hexDigits = []
+    inside = False
+    for line in lines:
+        line = line.strip()
+        if line.endswith(BEGIN_MARKER):
+            hexDigits = []
+            inside = True
+        elif line.endswith(END_MARKER):
+            if inside:
+                return bytes.fromhex("".join(hexDigits))
+        elif inside:
+            hexDigits.append(line)
+    raise ValueError("No complete A2DP trace block found in input")
+
+
+def decode(blob):
+    headerSize = struct.calcsize(HEADER_FORMAT)
+    magic, version, recordSize, _, recordCount, droppedCount, baseTimestampUs, ringbufferSize = struct.unpack_from(HEADER_FORMAT, blob, 0)
+    if magic != MAGIC:
+        raise ValueError(f"Bad magic {magic!r}")
+    if version != 1 or recordSize != struct.calcsize(RECORD_FORMAT):
+        raise ValueError(f"Unsupported trace version {version} / record size {recordSize}")
+    if len(blob) < headerSize + recordCount * recordSize:
+        raise ValueError("Truncated trace")
+
+    records = []
+    timestampUs = baseTimestampUs
+    for index in range(recordCount):
+        deltaUs, length, ringFill = struct.unpack_from(RECORD_FORMAT, blob, headerSize + index * recordSize)
+        timestampUs += deltaUs
+        records.append((timestampUs, deltaUs, length, ringFill))
+
+    return { "dropped": droppedCount, "ringbufferSize": ringbufferSize, "records": records }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode A2DP packet arrival traces")
+    parser.add_argument("input", help="Console log containing an 'a2dp_trace dump' block")
+    parser.add_argument("-o", "--output", help="CSV output file (default: stdout)")
+    parser.add_argument("-b", "--binary", help="Also write the raw binary trace to this file")
+    args = parser.parse_args()
+
+    with open(args.input, "r", errors="replace") as inputFile:
+        blob = extract_blob(inputFile)
+
+    if args.binary:
+        with open(args.binary, "wb") as binaryFile:
+            binaryFile.write(blob)
+
+    trace = decode(blob)
+
+    output = open(args.output, "w") if args.output else sys.stdout
+    output.write(f"# ring_buffer_size={trace['ringbufferSize']} dropped={trace['dropped']}\n")
+    output.write("timestamp_us,delta_us,length,ring_fill\n")
+    for record in trace["records"]:
+        output.write(",".join(str(field) for field in record) + "\n")
+    if output is not sys.stdout:
+        output.close()
+
+
+if __name__ == "__main__":
+    main()
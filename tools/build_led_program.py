@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------------
+# Copyright 2026, Gilles Zunino
+# -----------------------------------------------------------------------------------
+"""
+Assemble a Holiday Tree LED program and print the console commands loading it.
+
+The program runs once per pixel and per frame in the program LED effect (main/leds/led_program.h).
+Paste the printed commands in the device console: the program is checked, runs from the next
+frame, and 'led_program save' (or --save) keeps it in NVS across restarts.
+
+Usage:
+    build_led_program.py [--save] [-o program.bin] program.txt
+
+Assembly - One instruction per line, '#' starts a comment, 'name:' defines a jump label:
+    ldi   d, imm16              d = imm16 (-32768 to 32767)
+    mov   d, a                  d = a
+    add|sub|mul|div|mod|min|max|and|or|xor|shl|shr   d, a, b
+    scale d, a, b               d = (a * b) >> 8
+    addi  d, a, imm8            d = a + imm8 (-128 to 127)
+    sin   d, a                  d = sine of a, 0 to 255 - a in 256th of a turn
+    noise d, a, b               d = 2D noise at (a, b), 0 to 255 - 256 per noise cell
+    noise3 d, a, b              d = 3D noise at (a, b, d)
+    rand  d                     d = random 0 to 255
+    jmp   label
+    jz|jnz a, label             jump if a is (not) zero
+    jlt   a, b, label           jump if a < b
+    rgb   r, g, b               pixel color, channels clamped to 0 to 255
+    hue   h, v                  fully saturated color of hue h at brightness v
+    end                         stop - the pixel keeps its color
+
+Registers r0 to r15, reset for every pixel - Inputs have names:
+    r0 index  r1 x  r2 y  r3 height  r4 angle  r5 time (ms)  r6 bass  r7 level  r8 phase  r9 beats
+
+Stored program layout (little endian, the NVS blob) - Must match main/leds/led_program.c:
+    uint16_t version (1), uint16_t instructionCount, then 4 bytes per instruction: opcode, d, a, b
+"""
+
+import argparse
+import struct
+import sys
+
+
+VERSION = 1
+MAXIMUM_INSTRUCTIONS = 128
+REGISTER_COUNT = 16
+
+# Console lines are 128 characters at most - 'led_program add ' then 9 characters per instruction
+INSTRUCTIONS_PER_LINE = 12
+
+REGISTER_NAMES = {
+    "index": 0, "x": 1, "y": 2, "height": 3, "angle": 4, "time": 5,
+    "bass": 6, "level": 7, "phase": 8, "beats": 9
+}
+
+# Opcode and operand kinds - 'r' register, 'i16' / 'i8' immediate, 'l' label. Must match led_program_op_t
+OPCODES = {
+    "end": (0, []),
+    "ldi": (1, ["r", "i16"]),
+    "mov": (2, ["r", "r"]),
+    "add": (3, ["r", "r", "r"]),
+    "sub": (4, ["r", "r", "r"]),
+    "mul": (5, ["r", "r", "r"]),
+    "scale": (6, ["r", "r", "r"]),
+    "div": (7, ["r", "r", "r"]),
+    "mod": (8, ["r", "r", "r"]),
+    "min": (9, ["r", "r", "r"]),
+    "max": (10, ["r", "r", "r"]),
+    "and": (11, ["r", "r", "r"]),
+    "or": (12, ["r", "r", "r"]),
+    "xor": (13, ["r", "r", "r"]),
+    "shl": (14, ["r", "r", "r"]),
+    "shr": (15, ["r", "r", "r"]),
+    "addi": (16, ["r", "r", "i8"]),
+    "sin": (17, ["r", "r"]),
+    "noise": (18, ["r", "r", "r"]),
+    "noise3": (19, ["r", "r", "r"]),
+    "rand": (20, ["r"]),
+    "jmp": (21, ["l"]),
+    "jz": (22, ["r", "l"]),
+    "jnz": (23, ["r", "l"]),
+    "jlt": (24, ["r", "r", "l"]),
+    "rgb": (25, ["r", "r", "r"]),
+    "hue": (26, ["r", "r"]),
+}
+
+
+def parse_register(text):
+    text = text.lower()
+    if text in REGISTER_NAMES:
+        return REGISTER_NAMES[text]
+    if text.startswith("r") and text[1:].isdigit() and int(text[1:]) < REGISTER_COUNT:
+        return int(text[1:])
+    raise ValueError(f"invalid register '{text}'")
+
+
+def parse_immediate(text, bits):
+    value = int(text, 0)
+    if not -(1 << (bits - 1)) <= value < (1 << (bits - 1)):
+        raise ValueError(f"immediate {value} does not fit {bits} bits")
+    return value & ((1 << bits) - 1)
+
+
+def read_program(path):
+    # Labels are resolved once every instruction has an index
+    lines = []
+    labels = {}
+    with open(path) as programFile:
+        for lineNumber, line in enumerate(programFile, start=1):
+            line = line.split("#", 1)[0].strip()
+            while ":" in line:
+                label, line = line.split(":", 1)
+                label = label.strip()
+                if not label.isidentifier() or label in labels:
+                    raise ValueError(f"{path}:{lineNumber}: invalid or duplicate label '{label}'")
+                labels[label] = len(lines)
+                line = line.strip()
+            if line:
+                lines.append((lineNumber, line))
+
+    if not lines or len(lines) > MAXIMUM_INSTRUCTIONS:
+        raise ValueError(f"{path}: programs have 1 to {MAXIMUM_INSTRUCTIONS} instructions")
+
+    instructions = []
+    for lineNumber, line in lines:
+        mnemonic, _, operandText = line.partition(" ")
+        mnemonic = mnemonic.lower()
+        if mnemonic not in OPCODES:
+            raise ValueError(f"{path}:{lineNumber}: unknown instruction '{mnemonic}'")
+        opcode, kinds = OPCODES[mnemonic]
+        operands = [operand.strip() for operand in operandText.split(",")] if operandText.strip() else []
+        if len(operands) != len(kinds):
+            raise ValueError(f"{path}:{lineNumber}: '{mnemonic}' takes {len(kinds)} operands")
+
+        # Fields are d, a, b - Jump targets go in d, the registers they test in a and b
+        fields = [0, 0, 0]
+        registers = []
+        try:
+            for kind, operand in zip(kinds, operands):
+                if kind == "r":
+                    registers.append(parse_register(operand))
+                elif kind == "i16":
+                    value = parse_immediate(operand, 16)
+                    fields[1], fields[2] = value & 0xFF, value >> 8
+                elif kind == "i8":
+                    fields[2] = parse_immediate(operand, 8)
+                elif kind == "l":
+                    if operand not in labels:
+                        raise ValueError(f"unknown label '{operand}'")
+                    fields[0] = labels[operand]
+        except ValueError as error:
+            raise ValueError(f"{path}:{lineNumber}: {error}")
+
+        first = 1 if "l" in kinds else 0
+        for index, register in enumerate(registers):
+            fields[first + index] = register
+        instructions.append(bytes([opcode] + fields))
+
+    return instructions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Assemble a Holiday Tree LED program")
+    parser.add_argument("--save", action="store_true", help="Save the program in NVS once loaded")
+    parser.add_argument("-o", "--output", help="Also write the program as stored in NVS")
+    parser.add_argument("program", help="Program source")
+    args = parser.parse_args()
+
+    try:
+        instructions = read_program(args.program)
+    except ValueError as error:
+        sys.exit(str(error))
+
+    print("led_program begin")
+    for start in range(0, len(instructions), INSTRUCTIONS_PER_LINE):
+        print("led_program add " + " ".join(instruction.hex() for instruction in instructions[start:start + INSTRUCTIONS_PER_LINE]))
+    print("led_program commit")
+    if args.save:
+        print("led_program save")
+
+    if args.output:
+        with open(args.output, "wb") as output:
+            output.write(struct.pack("<HH", VERSION, len(instructions)))
+            output.write(b"".join(instructions))
+    print(f"{args.program}: {len(instructions)} instructions", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------------
+# Copyright 2026, Gilles Zunino
+# -----------------------------------------------------------------------------------
+"""
+Build the Holiday Tree light show bank from CSV show descriptions.
+
+Each CSV file holds one show. Keyframes are encoded as runs of pixels against the keyframe
+before them, so only what changes takes space. The resulting image is written to the 'shows'
+data partition (see partitions.csv), memory mapped by the firmware and played by the show
+player LED effect. Shows play in command line order.
+
+Usage:
+    build_led_shows.py -o shows/led_shows.bin intro.csv sparkle.csv ...
+
+When shows/led_shows.bin exists in the project directory, 'idf.py flash' writes it to the
+'shows' partition. It can also be written on its own with:
+    parttool.py write_partition --partition-name shows --input shows/led_shows.bin
+
+CSV show description - Blank lines and lines starting with '#' are ignored:
+    show,<ledCount>,<durationMs>
+    <timeMs>,<curve>,<color>,<color>,...
+    ...
+    * One keyframe per line, times rising from 0 and below durationMs
+    * <curve> is how the keyframe moves to the next one: step, linear, ease-in, ease-out or ease-in-out
+    * <color> is RRGGBB in hexadecimal, or RRGGBB*<count> for <count> LEDs of the same color
+    * When a keyframe lists fewer colors than LEDs, its colors repeat along the string
+
+Image layout (little endian) - Must match main/leds/led_show.h:
+    Header (12 bytes): char[4] "HTLS", uint16_t version (1), uint16_t showCount, uint32_t totalSize
+    Entries (16 bytes each): uint32_t dataOffset, uint32_t dataSize, uint32_t durationMs,
+                             uint16_t ledCount, uint16_t keyframeCount
+    Keyframes of each show, 4 bytes aligned:
+        uint32_t timeMs, uint16_t payloadSize, uint8_t curve, uint8_t reserved (0)
+        Runs - 00nnnnnn: n + 1 pixels unchanged, 01nnnnnn r g b: n + 1 pixels of one color,
+               10nnnnnn rgb...: n + 1 pixels, one color each
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+
+MAGIC = b"HTLS"
+VERSION = 1
+HEADER_FORMAT = "<4sHHI"
+ENTRY_FORMAT = "<IIIHH"
+KEYFRAME_FORMAT = "<IHBB"
+
+MAXIMUM_LED_COUNT = 1024
+MAXIMUM_RUN = 64
+RUN_KEEP = 0x00
+RUN_FILL = 0x40
+RUN_LITERAL = 0x80
+
+CURVES = {"step": 0, "linear": 1, "ease-in": 2, "ease-out": 3, "ease-in-out": 4}
+
+
+def parse_colors(path, lineNumber, fields, ledCount):
+    colors = []
+    for field in fields:
+        field = field.strip()
+        text, _, count = field.partition("*")
+        try:
+            value = int(text, 16)
+            count = int(count) if count else 1
+        except ValueError:
+            raise ValueError(f"{path}:{lineNumber}: invalid color '{field}'")
+        if len(text) != 6 or count < 1:
+            raise ValueError(f"{path}:{lineNumber}: invalid color '{field}'")
+        colors += [((value >> 16) & 0xFF, (value >> 8) & 0xFF, value & 0xFF)] * count
+
+    if not colors:
+        raise ValueError(f"{path}:{lineNumber}: keyframe without colors")
+    if len(colors) > ledCount:
+        raise ValueError(f"{path}:{lineNumber}: {len(colors)} colors for {ledCount} LEDs")
+    return [colors[index % len(colors)] for index in range(ledCount)]
+
+
+def read_show(path):
+    ledCount = None
+    durationMs = None
+    keyframes = []
+    with open(path, newline="") as showFile:
+        for lineNumber, fields in enumerate(csv.reader(showFile), start=1):
+            if not fields or not fields[0].strip() or fields[0].strip().startswith("#"):
+                continue
+            if fields[0].strip() == "show":
+                if ledCount is not None or len(fields) != 3:
+                    raise ValueError(f"{path}:{lineNumber}: expected one 'show,<ledCount>,<durationMs>' line")
+                ledCount = int(fields[1])
+                durationMs = int(fields[2])
+                if not 1 <= ledCount <= MAXIMUM_LED_COUNT or durationMs <= 0:
+                    raise ValueError(f"{path}:{lineNumber}: invalid LED count or duration")
+                continue
+
+            if ledCount is None:
+                raise ValueError(f"{path}:{lineNumber}: keyframe before the 'show' line")
+            timeMs = int(fields[0])
+            curve = fields[1].strip().lower() if len(fields) > 1 else ""
+            if curve not in CURVES:
+                raise ValueError(f"{path}:{lineNumber}: unknown curve '{curve}'")
+            previousTimeMs = keyframes[-1][0] if keyframes else None
+            if (previousTimeMs is None and timeMs != 0) or (previousTimeMs is not None and timeMs <= previousTimeMs) or timeMs >= durationMs:
+                raise ValueError(f"{path}:{lineNumber}: keyframe times must rise from 0 and stay below the show duration")
+            keyframes.append((timeMs, CURVES[curve], parse_colors(path, lineNumber, fields[2:], ledCount)))
+
+    if not keyframes:
+        raise ValueError(f"{path}: no keyframes")
+    return ledCount, durationMs, keyframes
+
+
+def encode_keyframe(previous, pixels):
+    # Greedy runs - Unchanged pixels first, then runs of one color, literal pixels otherwise
+    output = bytearray()
+    index = 0
+    ledCount = len(pixels)
+    while index < ledCount:
+        length = 1
+        if pixels[index] == previous[index]:
+            while index + length < ledCount and length < MAXIMUM_RUN and pixels[index + length] == previous[index + length]:
+                length += 1
+            output.append(RUN_KEEP | (length - 1))
+        elif index + 1 < ledCount and pixels[index + 1] == pixels[index]:
+            while index + length < ledCount and length < MAXIMUM_RUN and pixels[index + length] == pixels[index]:
+                length += 1
+            output.append(RUN_FILL | (length - 1))
+            output += bytes(pixels[index])
+        else:
+            # Literal until an unchanged pixel or two pixels of the same color
+            while (index + length < ledCount and length < MAXIMUM_RUN and pixels[index + length] != previous[index + length]
+                   and not (index + length + 1 < ledCount and pixels[index + length + 1] == pixels[index + length])):
+                length += 1
+            output.append(RUN_LITERAL | (length - 1))
+            for pixel in pixels[index:index + length]:
+                output += bytes(pixel)
+        index += length
+    return bytes(output)
+
+
+def decode_keyframe(previous, payload):
+    # Same arithmetic as main/leds/led_show.c - Checks every keyframe round trips
+    pixels = list(previous)
+    index = 0
+    position = 0
+    while position < len(payload):
+        code = payload[position]
+        length = (code & 0x3F) + 1
+        position += 1
+        if code & 0xC0 == RUN_FILL:
+            pixels[index:index + length] = [tuple(payload[position:position + 3])] * length
+            position += 3
+        elif code & 0xC0 == RUN_LITERAL:
+            pixels[index:index + length] = [tuple(payload[position + 3 * run:position + 3 * run + 3]) for run in range(length)]
+            position += 3 * length
+        index += length
+    return pixels
+
+
+def encode_show(ledCount, keyframes):
+    data = bytearray()
+    previous = [(0, 0, 0)] * ledCount
+    for timeMs, curve, pixels in keyframes:
+        payload = encode_keyframe(previous, pixels)
+        if len(payload) > 0xFFFF:
+            raise ValueError(f"keyframe at {timeMs} ms is too large")
+        if decode_keyframe(previous, payload) != pixels:
+            raise AssertionError(f"keyframe at {timeMs} ms does not round trip")
+        data += struct.pack(KEYFRAME_FORMAT, timeMs, len(payload), curve, 0)
+        data += payload
+        data += bytes(-len(data) % 4)
+        previous = pixels
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the Holiday Tree light show bank")
+    parser.add_argument("-o", "--output", required=True, help="Light show bank image to write")
+    parser.add_argument("csv", nargs="+", help="CSV show descriptions")
+    args = parser.parse_args()
+
+    shows = []
+    for path in args.csv:
+        try:
+            ledCount, durationMs, keyframes = read_show(path)
+        except ValueError as error:
+            sys.exit(str(error))
+        data = encode_show(ledCount, keyframes)
+        shows.append((path, ledCount, durationMs, len(keyframes), data))
+        rawSize = len(keyframes) * ledCount * 3
+        print(f"{path}: {len(keyframes)} keyframes for {ledCount} LEDs, {durationMs} ms -> {len(data)} bytes ({rawSize} bytes raw)", file=sys.stderr)
+
+    dataOffset = struct.calcsize(HEADER_FORMAT) + len(shows) * struct.calcsize(ENTRY_FORMAT)
+    entries = bytearray()
+    payload = bytearray()
+    for path, ledCount, durationMs, keyframeCount, data in shows:
+        offset = (dataOffset + len(payload) + 3) & ~3
+        payload += bytes(offset - dataOffset - len(payload))
+        entries += struct.pack(ENTRY_FORMAT, offset, len(data), durationMs, ledCount, keyframeCount)
+        payload += data
+
+    totalSize = dataOffset + len(payload)
+    with open(args.output, "wb") as output:
+        output.write(struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(shows), totalSize))
+        output.write(entries)
+        output.write(payload)
+    print(f"Light show bank: {len(shows)} shows, {totalSize} bytes", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
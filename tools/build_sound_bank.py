@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------------
+# Copyright 2026, Gilles Zunino
+# -----------------------------------------------------------------------------------
+"""
+Build the Holiday Tree sound bank from 16 bits PCM WAV files.
+
+Each WAV file is down mixed to mono and compressed to IMA-ADPCM (4 bits per sample).
+The resulting image is written to the 'sounds' data partition (see partitions.csv) and
+memory mapped by the firmware. Sounds are numbered in command line order.
+
+Usage:
+    build_sound_bank.py -o sounds/sound_bank.bin jingle1.wav jingle2.wav ...
+
+When sounds/sound_bank.bin exists in the project directory, 'idf.py flash' writes it to
+the 'sounds' partition. It can also be written on its own with:
+    parttool.py write_partition --partition-name sounds --input sounds/sound_bank.bin
+
+Image layout (little endian) - Must match main/audio/sound_bank.h:
+    Header (12 bytes): char[4] "HTSB", uint16_t version (1), uint16_t soundCount, uint32_t totalSize
+    Entries (16 bytes each): uint32_t dataOffset, uint32_t dataSize, uint32_t sampleCount,
+                             uint16_t sampleRate, uint16_t blockSize
+    ADPCM data for each sound, 4 bytes aligned
+"""
+
+import argparse
+import struct
+import sys
+import wave
+
+
+MAGIC = b"HTSB"
+VERSION = 1
+HEADER_FORMAT = "<4sHHI"
+ENTRY_FORMAT = "<IIIHH"
+
+STEP_TABLE = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+]
+INDEX_TABLE = [-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8]
+
+
+def read_wav_mono(path):
+    with wave.open(path, "rb") as wav:
+        if wav.getsampwidth() != 2:
+            raise ValueError(f"{path}: only 16 bits PCM WAV files are supported")
+        channels = wav.getnchannels()
+        sampleRate = wav.getframerate()
+        frames = wav.readframes(wav.getnframes())
+
+    samples = struct.unpack(f"<{len(frames) // 2}h", frames)
+    if channels > 1:
+        samples = [sum(samples[index:index + channels]) // channels for index in range(0, len(samples), channels)]
+    if sampleRate > 0xFFFF:
+        raise ValueError(f"{path}: sample rate {sampleRate} is not supported")
+    return list(samples), sampleRate
+
+
+def encode_nibble(sample, state):
+    predictor, stepIndex = state
+    step = STEP_TABLE[stepIndex]
+    difference = sample - predictor
+    nibble = 0
+    if difference < 0:
+        nibble = 8
+        difference = -difference
+
+    # Mirror the decoder arithmetic exactly so encoder and decoder stay in lock step
+    delta = step >> 3
+    if difference >= step:
+        nibble |= 4
+        difference -= step
+        delta += step
+    if difference >= step >> 1:
+        nibble |= 2
+        difference -= step >> 1
+        delta += step >> 1
+    if difference >= step >> 2:
+        nibble |= 1
+        delta += step >> 2
+
+    predictor = predictor - delta if nibble & 8 else predictor + delta
+    predictor = max(-32768, min(32767, predictor))
+    stepIndex = max(0, min(88, stepIndex + INDEX_TABLE[nibble]))
+    return nibble, (predictor, stepIndex)
+
+
+def encode_adpcm(samples, blockSize):
+    samplesPerBlock = 1 + 2 * (blockSize - 4)
+    output = bytearray()
+    state = (0, 0)
+    for blockStart in range(0, len(samples), samplesPerBlock):
+        block = samples[blockStart:blockStart + samplesPerBlock]
+        predictor = block[0]
+        output += struct.pack("<hBB", predictor, state[1], 0)
+        state = (predictor, state[1])
+
+        nibbles = []
+        for sample in block[1:]:
+            nibble, state = encode_nibble(sample, state)
+            nibbles.append(nibble)
+        if len(nibbles) % 2:
+            nibbles.append(0)
+        for index in range(0, len(nibbles), 2):
+            output.append(nibbles[index] | (nibbles[index + 1] << 4))
+    return bytes(output)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the Holiday Tree IMA-ADPCM sound bank")
+    parser.add_argument("-o", "--output", required=True, help="Sound bank image to write")
+    parser.add_argument("--block-size", type=int, default=256, help="ADPCM block size in bytes (default: 256)")
+    parser.add_argument("wav", nargs="+", help="16 bits PCM WAV files")
+    args = parser.parse_args()
+
+    if args.block_size <= 4 or args.block_size > 0xFFFF:
+        sys.exit("Invalid block size")
+
+    sounds = []
+    for path in args.wav:
+        samples, sampleRate = read_wav_mono(path)
+        sounds.append((path, sampleRate, len(samples), encode_adpcm(samples, args.block_size)))
+
+    dataOffset = struct.calcsize(HEADER_FORMAT) + len(sounds) * struct.calcsize(ENTRY_FORMAT)
+    entries = bytearray()
+    payload = bytearray()
+    for path, sampleRate, sampleCount, adpcm in sounds:
+        offset = (dataOffset + len(payload) + 3) & ~3
+        payload += bytes(offset - dataOffset - len(payload))
+        entries += struct.pack(ENTRY_FORMAT, offset, len(adpcm), sampleCount, sampleRate, args.block_size)
+        payload += adpcm
+        print(f"{path}: {sampleCount} samples @ {sampleRate} Hz -> {len(adpcm)} bytes", file=sys.stderr)
+
+    totalSize = dataOffset + len(payload)
+    with open(args.output, "wb") as output:
+        output.write(struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(sounds), totalSize))
+        output.write(entries)
+        output.write(payload)
+    print(f"Sound bank: {len(sounds)} sounds, {totalSize} bytes", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
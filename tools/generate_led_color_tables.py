@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------------
+# Copyright 2026, Gilles Zunino
+# -----------------------------------------------------------------------------------
+"""
+Generate the LED gamma and white balance lookup tables.
+
+WS2812 LEDs are linear in PWM duty cycle while perceived brightness is not: raw 8 bits values
+make fades step at the low end and everything look too bright. Each color channel gets one
+256 entries table combining a gamma curve and a white balance scale:
+
+    output = round(scale * (input / 255) ^ gamma)
+
+With --bits 16 the tables hold 8.8 fixed point levels (output times 256, at most 255 * 256) for the
+temporal dithering of the LED renderer, which spreads the fractional part over successive frames.
+
+Run by the build (see main/CMakeLists.txt) with the CONFIG_HOLIDAYTREE_LEDS_GAMMA and
+CONFIG_HOLIDAYTREE_LEDS_WHITE_BALANCE_* settings. The generated C file defines the constant
+tables declared in main/leds/led_color_correction.h, so nothing is computed at run time.
+
+Usage:
+    generate_led_color_tables.py --gamma 220 --red 255 --green 176 --blue 240 [--bits 16] -o led_color_tables.c
+"""
+
+import argparse
+import sys
+
+
+LEVELS = 256
+VALUES_PER_LINE = 16
+
+
+def build_table(gamma, scale, fractionBits):
+    return [int(round((scale << fractionBits) * ((level / (LEVELS - 1)) ** gamma))) for level in range(LEVELS)]
+
+
+def format_table(name, table, width):
+    lines = [f"    // {name}", "    {"]
+    for offset in range(0, LEVELS, VALUES_PER_LINE):
+        values = ", ".join(f"{value:{width}d}" for value in table[offset:offset + VALUES_PER_LINE])
+        lines.append(f"        {values}{',' if offset + VALUES_PER_LINE < LEVELS else ''}")
+    lines.append("    }")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the Holiday Tree LED gamma and white balance tables")
+    parser.add_argument("-o", "--output", required=True, help="C file to write")
+    parser.add_argument("--gamma", type=int, default=220, help="Gamma times 100 (default: 220)")
+    parser.add_argument("--red", type=int, default=255, help="Red white balance scale, 0 to 255 (default: 255)")
+    parser.add_argument("--green", type=int, default=255, help="Green white balance scale, 0 to 255 (default: 255)")
+    parser.add_argument("--blue", type=int, default=255, help="Blue white balance scale, 0 to 255 (default: 255)")
+    parser.add_argument("--bits", type=int, choices=[8, 16], default=8, help="Bits per table entry, 16 for 8.8 fixed point (default: 8)")
+    args = parser.parse_args()
+
+    if args.gamma < 100 or args.gamma > 300:
+        sys.exit("Gamma must be between 100 and 300")
+    for scale in (args.red, args.green, args.blue):
+        if scale < 0 or scale > 255:
+            sys.exit("White balance scales must be between 0 and 255")
+
+    gamma = args.gamma / 100
+    fractionBits = args.bits - 8
+    tables = [("Red", build_table(gamma, args.red, fractionBits)), ("Green", build_table(gamma, args.green, fractionBits)), ("Blue", build_table(gamma, args.blue, fractionBits))]
+    width = 3 if args.bits == 8 else 5
+
+    source = [
+        "// Generated by tools/generate_led_color_tables.py - Do not edit",
+        f"// Gamma {gamma:.2f} - White balance red {args.red}, green {args.green}, blue {args.blue} - {args.bits} bits levels",
+        "",
+        "#include \"leds/led_color_correction.h\"",
+        "",
+        "",
+        f"const uint{args.bits}_t LedColorCorrectionTables[LED_FRAMEBUFFER_BYTES_PER_PIXEL][LED_COLOR_CORRECTION_LEVELS] = {{",
+        ",\n".join(format_table(name, table, width) for name, table in tables),
+        "};",
+        ""
+    ]
+
+    with open(args.output, "w", newline="\n") as output:
+        output.write("\n".join(source))
+
+
+if __name__ == "__main__":
+    main()
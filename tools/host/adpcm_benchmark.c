@@ -0,0 +1,91 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include <esp_timer.h>
+
+#include "audio/adpcm_decoder.h"
+
+
+// -----------------------------------------------------------------------------------
+// IMA-ADPCM decoder throughput on the host - Same synthetic data and chunk size as 'audio_bench adpcm'
+//
+//   adpcm_benchmark [iterations]
+//
+// Fails when the decoder does not return every sample of the data
+// -----------------------------------------------------------------------------------
+
+#define BENCHMARK_CHUNK_SAMPLES 512
+
+static const size_t SyntheticAdpcmBlockSize = 256;
+static const size_t SyntheticAdpcmBlockCount = 16;
+static const uint32_t DefaultIterations = 20000;
+
+
+static uint8_t* create_synthetic_adpcm_data(size_t* dataSize, uint32_t* sampleCount) {
+    // Pseudo random nibbles behind valid block headers
+    const size_t syntheticSize = SyntheticAdpcmBlockSize * SyntheticAdpcmBlockCount;
+    uint8_t* syntheticData = malloc(syntheticSize);
+    if (syntheticData == NULL) {
+        return NULL;
+    }
+
+    uint32_t seed = 0x12345678;
+    for (size_t offset = 0; offset < syntheticSize; offset++) {
+        seed = seed * 1664525 + 1013904223;
+        syntheticData[offset] = (offset % SyntheticAdpcmBlockSize) < 4 ? 0 : (uint8_t) (seed >> 24);
+    }
+    for (size_t offset = 0; offset < syntheticSize; offset += SyntheticAdpcmBlockSize) {
+        syntheticData[offset + 2] = 40;
+    }
+
+    *dataSize = syntheticSize;
+    *sampleCount = SyntheticAdpcmBlockCount * (1 + 2 * (SyntheticAdpcmBlockSize - 4));
+    return syntheticData;
+}
+
+int main(int argc, char** argv) {
+    const uint32_t iterations = argc > 1 ? (uint32_t) strtoul(argv[1], NULL, 10) : DefaultIterations;
+
+    size_t dataSize = 0;
+    uint32_t sampleCount = 0;
+    uint8_t* data = create_synthetic_adpcm_data(&dataSize, &sampleCount);
+    if (data == NULL) {
+        printf("Not enough memory for synthetic ADPCM data\n");
+        return 1;
+    }
+
+    int16_t samples[BENCHMARK_CHUNK_SAMPLES];
+    uint64_t decodedSamples = 0;
+    uint32_t checksum = 0;
+    const int64_t startUs = esp_timer_get_time();
+    for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+        adpcm_decoder_t decoder;
+        adpcm_decoder_init(&decoder, data, dataSize, SyntheticAdpcmBlockSize, sampleCount);
+        while (!adpcm_decoder_done(&decoder)) {
+            const size_t decoded = adpcm_decode(&decoder, samples, BENCHMARK_CHUNK_SAMPLES);
+            if (decoded == 0) {
+                break;
+            }
+            decodedSamples += decoded;
+            checksum += (uint16_t) samples[decoded - 1];
+        }
+    }
+    const int64_t elapsedUs = esp_timer_get_time() - startUs;
+    free(data);
+
+    const uint64_t expectedSamples = (uint64_t) sampleCount * iterations;
+    if (decodedSamples != expectedSamples) {
+        printf("Decoded %" PRIu64 " samples, expected %" PRIu64 "\n", decodedSamples, expectedSamples);
+        return 1;
+    }
+
+    const double elapsedMs = elapsedUs > 0 ? elapsedUs / 1000.0 : 0.001;
+    printf("%-20s %10" PRIu64 " samples %10.1f ms %10.0f samples/ms %8.2f ns/sample (checksum %" PRIu32 ")\n",
+        "adpcm (host)", decodedSamples, elapsedMs, decodedSamples / elapsedMs, elapsedMs * 1e6 / decodedSamples, checksum);
+    return 0;
+}
@@ -0,0 +1,293 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "audio/audio_analysis.h"
+#include "audio/audio_spectrum.h"
+#include "audio/audio_beat.h"
+
+
+// -----------------------------------------------------------------------------------
+// Beat detector precision and recall on labelled WAV files
+//
+//   beat_eval [--min-onset-f F] [--min-beat-f F] track.wav ...
+//
+// Every 16 bits PCM WAV file goes through the firmware pipeline unchanged: analysis tap (decimation), spectrum analyzer
+// task and beat detector. Detected onsets and beats are matched one to one with the times listed in 'track.onsets' and
+// 'track.beats' (one time in seconds per line, see generate_beat_tracks.py):
+//  * Onsets match within OnsetToleranceUs, beats within BeatToleranceUs
+//  * Beats before BeatSettlingUs are left out while the tempo tracker locks
+// Fails when the onset F-measure over all tracks, or the beat F-measure of any track or over all tracks, is below the given
+// minimums - A track the tempo tracker cannot follow must not hide behind the others
+// -----------------------------------------------------------------------------------
+
+// Frames per analyzed block - Small enough that a block never completes two spectrum frames
+#define BEAT_EVAL_BLOCK_FRAMES 128
+
+#define BEAT_EVAL_MAX_EVENTS 4096
+
+static const int64_t OnsetToleranceUs = 50000;
+static const int64_t BeatToleranceUs = 70000;
+static const int64_t BeatSettlingUs = 5000000;
+
+
+typedef struct {
+    int64_t timesUs[BEAT_EVAL_MAX_EVENTS];
+    uint32_t count;
+} event_list_t;
+
+typedef struct {
+    uint32_t matched;
+    uint32_t detected;
+    uint32_t labelled;
+    int64_t offsetSumUs;
+} match_result_t;
+
+typedef struct {
+    uint32_t sampleRate;
+    uint16_t channelCount;
+    uint32_t frameCount;
+    int16_t* samples;
+} wav_file_t;
+
+
+static bool read_wav_file(const char* path, wav_file_t* wav) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return false;
+    }
+
+    uint8_t header[12];
+    bool valid = (fread(header, 1, sizeof(header), file) == sizeof(header)) && (memcmp(header, "RIFF", 4) == 0) && (memcmp(&header[8], "WAVE", 4) == 0);
+    bool formatFound = false;
+    memset(wav, 0, sizeof(*wav));
+    while (valid) {
+        uint8_t chunkHeader[8];
+        if (fread(chunkHeader, 1, sizeof(chunkHeader), file) != sizeof(chunkHeader)) {
+            valid = false;
+            break;
+        }
+        const uint32_t chunkSize = chunkHeader[4] | (chunkHeader[5] << 8) | (chunkHeader[6] << 16) | ((uint32_t) chunkHeader[7] << 24);
+
+        if (memcmp(chunkHeader, "fmt ", 4) == 0) {
+            uint8_t format[16];
+            valid = (chunkSize >= sizeof(format)) && (fread(format, 1, sizeof(format), file) == sizeof(format));
+            const uint16_t encoding = format[0] | (format[1] << 8);
+            const uint16_t bitsPerSample = format[14] | (format[15] << 8);
+            wav->channelCount = format[2] | (format[3] << 8);
+            wav->sampleRate = format[4] | (format[5] << 8) | (format[6] << 16) | ((uint32_t) format[7] << 24);
+            valid &= (encoding == 1) && (bitsPerSample == 16) && (wav->channelCount >= 1) && (wav->channelCount <= 2);
+            formatFound = valid;
+            fseek(file, (long) (chunkSize - sizeof(format) + (chunkSize & 1)), SEEK_CUR);
+        } else if (memcmp(chunkHeader, "data", 4) == 0) {
+            valid = formatFound;
+            if (valid) {
+                wav->frameCount = chunkSize / (2 * wav->channelCount);
+                wav->samples = malloc((size_t) wav->frameCount * wav->channelCount * sizeof(int16_t));
+                valid = (wav->samples != NULL) && (fread(wav->samples, 2 * wav->channelCount, wav->frameCount, file) == wav->frameCount);
+            }
+            break;
+        } else {
+            fseek(file, (long) (chunkSize + (chunkSize & 1)), SEEK_CUR);
+        }
+    }
+
+    fclose(file);
+    if (!valid) {
+        free(wav->samples);
+        wav->samples = NULL;
+    }
+    return valid;
+}
+
+static bool read_label_file(const char* wavPath, const char* extension, event_list_t* events) {
+    char path[1024];
+    const char* dot = strrchr(wavPath, '.');
+    const int baseLength = dot != NULL ? (int) (dot - wavPath) : (int) strlen(wavPath);
+    snprintf(path, sizeof(path), "%.*s%s", baseLength, wavPath, extension);
+
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return false;
+    }
+
+    events->count = 0;
+    double seconds = 0.0;
+    while ((events->count < BEAT_EVAL_MAX_EVENTS) && (fscanf(file, "%lf", &seconds) == 1)) {
+        events->timesUs[events->count++] = (int64_t) (seconds * 1e6);
+    }
+    fclose(file);
+    return true;
+}
+
+// One to one matching of two sorted lists - Each detection takes the first label still free within the tolerance
+static void match_events(const event_list_t* detected, const event_list_t* labelled, int64_t toleranceUs, int64_t fromUs, match_result_t* result) {
+    uint32_t labelIndex = 0;
+    for (uint32_t labelCount = 0; labelCount < labelled->count; labelCount++) {
+        result->labelled += labelled->timesUs[labelCount] >= fromUs ? 1 : 0;
+    }
+
+    for (uint32_t detectedIndex = 0; detectedIndex < detected->count; detectedIndex++) {
+        const int64_t detectedUs = detected->timesUs[detectedIndex];
+        if (detectedUs < fromUs) {
+            continue;
+        }
+        result->detected++;
+
+        while ((labelIndex < labelled->count) && (labelled->timesUs[labelIndex] < detectedUs - toleranceUs)) {
+            labelIndex++;
+        }
+        if ((labelIndex < labelled->count) && (labelled->timesUs[labelIndex] <= detectedUs + toleranceUs) && (labelled->timesUs[labelIndex] >= fromUs)) {
+            result->matched++;
+            result->offsetSumUs += detectedUs - labelled->timesUs[labelIndex];
+            labelIndex++;
+        }
+    }
+}
+
+static void print_result(const char* name, const char* kind, const match_result_t* result) {
+    const double precision = result->detected > 0 ? (double) result->matched / result->detected : 0.0;
+    const double recall = result->labelled > 0 ? (double) result->matched / result->labelled : 0.0;
+    const double fMeasure = precision + recall > 0.0 ? 2.0 * precision * recall / (precision + recall) : 0.0;
+    const double offsetMs = result->matched > 0 ? result->offsetSumUs / 1000.0 / result->matched : 0.0;
+    printf("%-16s %-6s precision %5.3f  recall %5.3f  F %5.3f  (%4" PRIu32 " matched, %4" PRIu32 " detected, %4" PRIu32 " labelled, mean offset %+6.1f ms)\n",
+        name, kind, precision, recall, fMeasure, result->matched, result->detected, result->labelled, offsetMs);
+}
+
+static double f_measure(const match_result_t* result) {
+    return result->detected + result->labelled > 0 ? 2.0 * result->matched / (result->detected + result->labelled) : 0.0;
+}
+
+// Runs one track through the pipeline - Times are relative to the start of the track
+static bool analyze_track(const wav_file_t* wav, event_list_t* onsets, event_list_t* beats) {
+    reset_audio_analysis();
+    host_wait_for_idle_tasks();
+
+    audio_beat_snapshot_t snapshot;
+    get_audio_beat_snapshot(&snapshot);
+    uint32_t sequence = snapshot.sequence;
+    uint32_t onsetCount = snapshot.onsetCount;
+    uint32_t beatCount = snapshot.beatCount;
+    int64_t previousPlayoutUs = 0;
+
+    // Playout times continue from the reset so snapshots stay ordered
+    const int64_t baseUs = esp_timer_get_time() + 1000000;
+    onsets->count = 0;
+    beats->count = 0;
+    for (uint32_t frame = 0; frame < wav->frameCount; frame += BEAT_EVAL_BLOCK_FRAMES) {
+        const uint32_t frameCount = wav->frameCount - frame < BEAT_EVAL_BLOCK_FRAMES ? wav->frameCount - frame : BEAT_EVAL_BLOCK_FRAMES;
+        const int64_t playoutUs = baseUs + ((int64_t) frame * 1000000) / wav->sampleRate;
+        analyze_audio_block(&wav->samples[(size_t) frame * wav->channelCount], frameCount, (uint8_t) wav->channelCount, wav->sampleRate, playoutUs);
+        host_wait_for_idle_tasks();
+
+        if (!get_audio_beat_snapshot(&snapshot) || (snapshot.sequence == sequence)) {
+            continue;
+        }
+        if (snapshot.sequence != sequence + 1) {
+            printf("Spectrum frames were skipped\n");
+            return false;
+        }
+        sequence = snapshot.sequence;
+
+        // An onset is reported one frame after its peak
+        if ((snapshot.onsetCount != onsetCount) && (onsets->count < BEAT_EVAL_MAX_EVENTS)) {
+            onsets->timesUs[onsets->count++] = previousPlayoutUs - baseUs;
+        }
+        if ((snapshot.beatCount != beatCount) && (beats->count < BEAT_EVAL_MAX_EVENTS)) {
+            beats->timesUs[beats->count++] = snapshot.lastBeatUs - baseUs;
+        }
+        onsetCount = snapshot.onsetCount;
+        beatCount = snapshot.beatCount;
+        previousPlayoutUs = snapshot.playoutTimeUs;
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    double minimumOnsetF = 0.0;
+    double minimumBeatF = 0.0;
+    int argumentIndex = 1;
+    for (; argumentIndex + 1 < argc; argumentIndex += 2) {
+        if (strcmp(argv[argumentIndex], "--min-onset-f") == 0) {
+            minimumOnsetF = atof(argv[argumentIndex + 1]);
+        } else if (strcmp(argv[argumentIndex], "--min-beat-f") == 0) {
+            minimumBeatF = atof(argv[argumentIndex + 1]);
+        } else {
+            break;
+        }
+    }
+    if (argumentIndex == argc) {
+        printf("Usage: beat_eval [--min-onset-f F] [--min-beat-f F] track.wav ...\n");
+        return 1;
+    }
+
+    if (start_audio_spectrum_analyzer() != ESP_OK) {
+        return 1;
+    }
+
+    static event_list_t detectedOnsets;
+    static event_list_t detectedBeats;
+    static event_list_t labelledOnsets;
+    static event_list_t labelledBeats;
+    match_result_t totalOnsets = { 0 };
+    match_result_t totalBeats = { 0 };
+    bool tracksPassed = true;
+    for (; argumentIndex < argc; argumentIndex++) {
+        const char* path = argv[argumentIndex];
+        wav_file_t wav;
+        if (!read_wav_file(path, &wav)) {
+            printf("%s is not a 16 bits PCM WAV file\n", path);
+            return 1;
+        }
+        if (!read_label_file(path, ".onsets", &labelledOnsets) || !read_label_file(path, ".beats", &labelledBeats)) {
+            printf("%s has no .onsets or .beats labels\n", path);
+            return 1;
+        }
+
+        const bool analyzed = analyze_track(&wav, &detectedOnsets, &detectedBeats);
+        free(wav.samples);
+        if (!analyzed) {
+            return 1;
+        }
+
+        const char* name = strrchr(path, '/') != NULL ? strrchr(path, '/') + 1 : path;
+        match_result_t onsets = { 0 };
+        match_result_t beats = { 0 };
+        match_events(&detectedOnsets, &labelledOnsets, OnsetToleranceUs, 0, &onsets);
+        match_events(&detectedBeats, &labelledBeats, BeatToleranceUs, BeatSettlingUs, &beats);
+        print_result(name, "onsets", &onsets);
+        print_result(name, "beats", &beats);
+        if (f_measure(&beats) < minimumBeatF) {
+            printf("%s beats are below the minimum F-measure %.3f\n", name, minimumBeatF);
+            tracksPassed = false;
+        }
+
+        totalOnsets.matched += onsets.matched;
+        totalOnsets.detected += onsets.detected;
+        totalOnsets.labelled += onsets.labelled;
+        totalOnsets.offsetSumUs += onsets.offsetSumUs;
+        totalBeats.matched += beats.matched;
+        totalBeats.detected += beats.detected;
+        totalBeats.labelled += beats.labelled;
+        totalBeats.offsetSumUs += beats.offsetSumUs;
+    }
+
+    print_result("all tracks", "onsets", &totalOnsets);
+    print_result("all tracks", "beats", &totalBeats);
+
+    const bool passed = tracksPassed && (f_measure(&totalOnsets) >= minimumOnsetF) && (f_measure(&totalBeats) >= minimumBeatF);
+    if (!passed) {
+        printf("Below the minimum F-measure: onsets %.3f, beats %.3f\n", minimumOnsetF, minimumBeatF);
+    }
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+
+#include <esp_timer.h>
+
+#include "audio/fixed_fft.h"
+
+
+// -----------------------------------------------------------------------------------
+// Fixed point FFT accuracy and cost on the host
+//
+//   fixed_fft_check [iterations]
+//
+// Every block is transformed by compute_fixed_real_fft() and by a double precision DFT of the same Hann windowed block:
+// the energy of the difference over all bins, against the energy of the reference, is the signal to error ratio. Fails
+// when a block is below its limit. Then reports the cost of one transform, like 'audio_bench fft'
+//
+// Rounding after every stage leaves an error of about one unit per bin once the peak is normalized to 15 bits: blocks
+// whose peak barely needs normalizing, like the two tones over noise, land near 50dB, enough for log spaced band levels
+// but a few dB under single tones. Limits are a few dB under the measured ratios
+// -----------------------------------------------------------------------------------
+
+typedef enum {
+    FftBlockTone,
+    FftBlockTwoTonesNoise,
+    FftBlockNoise,
+    FftBlockSquare
+} fft_block_kind_t;
+
+typedef struct {
+    const char* name;
+    fft_block_kind_t kind;
+    double amplitude;
+    double frequency;               // In bins
+    double minimumSnrDb;
+} fft_case_t;
+
+static const fft_case_t FftCases[] = {
+    { "tone on a bin", FftBlockTone, 16384.0, 32.0, 70.0 },
+    { "tone between bins", FftBlockTone, 16384.0, 37.3, 55.0 },
+    { "high tone", FftBlockTone, 16384.0, 241.7, 55.0 },
+    { "quiet tone", FftBlockTone, 40.0, 37.3, 50.0 },
+    { "full scale tone", FftBlockTone, 32767.0, 37.3, 60.0 },
+    { "two tones over noise", FftBlockTwoTonesNoise, 12000.0, 37.3, 47.0 },
+    { "white noise", FftBlockNoise, 8192.0, 0.0, 53.0 },
+    { "full scale noise", FftBlockNoise, 32767.0, 0.0, 53.0 },
+    { "full scale square", FftBlockSquare, 32767.0, 10.0, 60.0 }
+};
+
+static const uint32_t DefaultIterations = 20000;
+
+
+static void generate_block(const fft_case_t* fftCase, int16_t* samples) {
+    uint32_t seed = 0x12345678;
+    for (uint32_t index = 0; index < FIXED_FFT_SIZE; index++) {
+        seed = seed * 1664525 + 1013904223;
+        const double angle = 2.0 * M_PI * fftCase->frequency * index / FIXED_FFT_SIZE;
+        double value = 0.0;
+        switch (fftCase->kind) {
+            case FftBlockTone:
+                value = fftCase->amplitude * sin(angle);
+                break;
+            case FftBlockTwoTonesNoise:
+                // Same block as 'audio_bench fft'
+                value = fftCase->amplitude * sin(angle) + 0.5 * fftCase->amplitude * sin(2.0 * M_PI * 101.0 * index / FIXED_FFT_SIZE) + (double) ((int16_t) (seed >> 16) >> 3);
+                break;
+            case FftBlockNoise:
+                value = fftCase->amplitude * ((double) (int16_t) (seed >> 16) / 32768.0);
+                break;
+            case FftBlockSquare:
+                value = sin(angle) >= 0.0 ? fftCase->amplitude : -fftCase->amplitude - 1.0;
+                break;
+        }
+        const long quantized = lround(value);
+        samples[index] = (int16_t) (quantized > INT16_MAX ? INT16_MAX : (quantized < INT16_MIN ? INT16_MIN : quantized));
+    }
+}
+
+// Signal to error ratio in dB of the fixed point transform of 'samples' against a double precision DFT
+static double measure_snr(const int16_t* samples) {
+    fixed_fft_bin_t bins[FIXED_FFT_BIN_COUNT];
+    const uint32_t shift = compute_fixed_real_fft(samples, bins);
+    const double binScale = 1.0 / (double) (1UL << shift);
+
+    double windowed[FIXED_FFT_SIZE];
+    for (uint32_t index = 0; index < FIXED_FFT_SIZE; index++) {
+        windowed[index] = samples[index] * (0.5 - 0.5 * cos(2.0 * M_PI * index / FIXED_FFT_SIZE));
+    }
+
+    double signalEnergy = 0.0;
+    double errorEnergy = 0.0;
+    for (uint32_t bin = 0; bin < FIXED_FFT_BIN_COUNT; bin++) {
+        double real = 0.0;
+        double imaginary = 0.0;
+        for (uint32_t index = 0; index < FIXED_FFT_SIZE; index++) {
+            const double angle = 2.0 * M_PI * (double) ((bin * index) & (FIXED_FFT_SIZE - 1)) / FIXED_FFT_SIZE;
+            real += windowed[index] * cos(angle);
+            imaginary -= windowed[index] * sin(angle);
+        }
+        real /= FIXED_FFT_SIZE;
+        imaginary /= FIXED_FFT_SIZE;
+
+        const double realError = real - bins[bin].real * binScale;
+        const double imaginaryError = imaginary - bins[bin].imaginary * binScale;
+        signalEnergy += real * real + imaginary * imaginary;
+        errorEnergy += realError * realError + imaginaryError * imaginaryError;
+    }
+    return 10.0 * log10(signalEnergy / (errorEnergy > 0.0 ? errorEnergy : 1e-30));
+}
+
+int main(int argc, char** argv) {
+    const uint32_t iterations = argc > 1 ? (uint32_t) strtoul(argv[1], NULL, 10) : DefaultIterations;
+    fixed_fft_init();
+
+    bool passed = true;
+    int16_t samples[FIXED_FFT_SIZE];
+    for (size_t caseIndex = 0; caseIndex < sizeof(FftCases) / sizeof(FftCases[0]); caseIndex++) {
+        const fft_case_t* fftCase = &FftCases[caseIndex];
+        generate_block(fftCase, samples);
+        const double snrDb = measure_snr(samples);
+        const bool casePassed = snrDb >= fftCase->minimumSnrDb;
+        printf("fft %-22s SNR %6.1f dB (minimum %4.1f dB)  %s\n", fftCase->name, snrDb, fftCase->minimumSnrDb, casePassed ? "ok" : "FAILED");
+        passed &= casePassed;
+    }
+
+    // Cost on the block 'audio_bench fft' measures - The checksum keeps the transforms from being optimized out
+    generate_block(&FftCases[5], samples);
+    fixed_fft_bin_t bins[FIXED_FFT_BIN_COUNT];
+    int32_t checksum = 0;
+    const int64_t startUs = esp_timer_get_time();
+    for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+        checksum += (int32_t) compute_fixed_real_fft(samples, bins) + bins[iteration % FIXED_FFT_BIN_COUNT].real;
+    }
+    const int64_t elapsedUs = esp_timer_get_time() - startUs;
+    printf("fft (512 real) %.0f ns per transform over %u transforms (checksum %d)\n", iterations > 0 ? elapsedUs * 1000.0 / iterations : 0.0, (unsigned) iterations, (int) checksum);
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------------
+# Copyright 2026, Gilles Zunino
+# -----------------------------------------------------------------------------------
+"""
+Generate labelled test tracks for the beat detector harness (beat_eval).
+
+Each track is a 16 bits PCM WAV file of synthesized drums over bass and pad notes, with two
+label files next to it, one time in seconds per line:
+    <name>.onsets   Every drum hit - Hits closer than 30ms are one onset
+    <name>.beats    Every beat of the bar
+
+Tracks cover common tempos, a slow ballad, a 48kHz track, syncopated and quiet hits and a
+tempo change. Noise is seeded so the tracks are the same on every run.
+
+Usage:
+    generate_beat_tracks.py -o tracks_directory
+"""
+
+import argparse
+import functools
+import math
+import os
+import random
+import struct
+import wave
+
+
+DURATION_S = 30.0
+MERGE_WINDOW_S = 0.030
+
+
+# Track description - Patterns are one bar of sixteenth notes: 'x' full hit, 'o' softer hit, '.' nothing
+TRACKS = [
+    {
+        "name": "house_124", "rate": 44100, "bpm": [(0.0, 124.0)],
+        "kick": "x...x...x...x...", "snare": "....o.......o...", "hat": "..x...x...x...x.",
+        "bass": True, "pad": True, "noise": 0.002
+    },
+    {
+        "name": "rock_100", "rate": 44100, "bpm": [(0.0, 100.0)],
+        "kick": "x.......x.x.....", "snare": "....x.......x...", "hat": "x.x.x.x.x.x.x.x.",
+        "bass": True, "pad": False, "noise": 0.002
+    },
+    {
+        "name": "hiphop_90", "rate": 44100, "bpm": [(0.0, 90.0)],
+        "kick": "x.....x...x.....", "snare": "....x.......x...", "hat": "oooooooooooooooo",
+        "bass": True, "pad": True, "noise": 0.003
+    },
+    {
+        "name": "ballad_72", "rate": 44100, "bpm": [(0.0, 72.0)],
+        "kick": "x.......x.......", "snare": "....x.......x...", "hat": "................",
+        "bass": True, "pad": True, "noise": 0.004
+    },
+    {
+        "name": "techno_140", "rate": 48000, "bpm": [(0.0, 140.0)],
+        "kick": "x...x...x...x...", "snare": "....x.......x...", "hat": "..x...x...x...x.",
+        "bass": False, "pad": False, "noise": 0.002
+    },
+    {
+        "name": "tempo_110_132", "rate": 44100, "bpm": [(0.0, 110.0), (15.0, 132.0)],
+        "kick": "x...x...x...x...", "snare": "....x.......x...", "hat": "x.x.x.x.x.x.x.x.",
+        "bass": True, "pad": False, "noise": 0.002
+    },
+]
+
+
+def sixteenth_times(bpmChanges):
+    # Start of every sixteenth note and its step in the bar, tempo changes on a bar line
+    times = []
+    time = 0.0
+    step = 0
+    changeIndex = 0
+    while time < DURATION_S - 0.5:
+        while (changeIndex + 1 < len(bpmChanges)) and (time >= bpmChanges[changeIndex + 1][0]) and (step == 0):
+            changeIndex += 1
+        times.append((time, step))
+        time += 60.0 / bpmChanges[changeIndex][1] / 4.0
+        step = (step + 1) % 16
+    return times
+
+
+def add(buffer, start, samples, gain):
+    for index, sample in enumerate(samples):
+        position = start + index
+        if position >= len(buffer):
+            break
+        buffer[position] += gain * sample
+
+
+def kick(rate):
+    # Sine sweeping down from 150Hz to 45Hz with a fast decay
+    samples = []
+    phase = 0.0
+    for index in range(int(0.25 * rate)):
+        t = index / rate
+        frequency = 45.0 + 105.0 * math.exp(-t / 0.03)
+        phase += 2.0 * math.pi * frequency / rate
+        samples.append(math.sin(phase) * math.exp(-t / 0.09))
+    return samples
+
+
+def snare(rate, generator):
+    # Noise burst over a 190Hz body
+    samples = []
+    for index in range(int(0.2 * rate)):
+        t = index / rate
+        samples.append(0.6 * generator.uniform(-1.0, 1.0) * math.exp(-t / 0.05) + 0.5 * math.sin(2.0 * math.pi * 190.0 * t) * math.exp(-t / 0.04))
+    return samples
+
+
+def hat(rate, generator):
+    # High passed noise - Difference of successive noise samples
+    samples = []
+    previous = 0.0
+    for index in range(int(0.06 * rate)):
+        t = index / rate
+        noise = generator.uniform(-1.0, 1.0)
+        samples.append((noise - previous) * 0.5 * math.exp(-t / 0.015))
+        previous = noise
+    return samples
+
+
+@functools.lru_cache(maxsize=None)
+def tone(rate, frequency, count, attack, harmonics):
+    # Note of 'count' samples with a linear attack and an exponential release over its last quarter - Notes repeat, they are cached
+    samples = []
+    for index in range(count):
+        t = index / rate
+        envelope = min(1.0, t / attack) * (1.0 if index < 0.75 * count else math.exp(-(index - 0.75 * count) / (0.05 * rate)))
+        samples.append(envelope * sum(math.sin(2.0 * math.pi * frequency * harmonic * t) / harmonic for harmonic in range(1, harmonics + 1)))
+    return tuple(samples)
+
+
+def merge(times):
+    merged = []
+    for time in sorted(times):
+        if not merged or time - merged[-1] > MERGE_WINDOW_S:
+            merged.append(time)
+    return merged
+
+
+def render(track, generator):
+    rate = track["rate"]
+    buffer = [0.0] * int(DURATION_S * rate)
+    kickSamples = kick(rate)
+    onsets = []
+    beats = []
+
+    sixteenths = sixteenth_times(track["bpm"])
+    bassNotes = [55.0, 55.0, 65.41, 73.42]
+    padChords = [(220.0, 261.63, 329.63), (196.0, 246.94, 293.66)]
+    for index, (time, step) in enumerate(sixteenths):
+        start = int(time * rate)
+        if step % 4 == 0:
+            beats.append(time)
+
+        for instrument, render_hit, gain in (("kick", lambda: kickSamples, 0.55), ("snare", lambda: snare(rate, generator), 0.35), ("hat", lambda: hat(rate, generator), 0.18)):
+            hit = track[instrument][step]
+            if hit != ".":
+                add(buffer, start, render_hit(), gain * (1.0 if hit == "x" else 0.5))
+                onsets.append(time)
+
+        # Bass on every beat, pad on every bar - Soft attacks, they are not labelled as onsets
+        beatLength = (sixteenths[index + 1][0] - time) * 4.0 if index + 1 < len(sixteenths) else 0.5
+        if track["bass"] and step % 4 == 0:
+            add(buffer, start, tone(rate, bassNotes[(step // 4) % 4], int(beatLength * rate), 0.03, 3), 0.12)
+        if track["pad"] and step == 0:
+            chord = padChords[(len(beats) // 4) % 2]
+            for frequency in chord:
+                add(buffer, start, tone(rate, frequency, int(beatLength * 4.0 * rate), 0.4, 2), 0.04)
+
+    for index in range(len(buffer)):
+        buffer[index] += generator.gauss(0.0, track["noise"])
+
+    return buffer, merge(onsets), beats
+
+
+def write_wav(path, rate, buffer):
+    peak = max(1e-9, max(abs(sample) for sample in buffer))
+    scale = 0.9 * 32767 / peak
+    with wave.open(path, "wb") as output:
+        output.setnchannels(2)
+        output.setsampwidth(2)
+        output.setframerate(rate)
+        frames = bytearray()
+        for sample in buffer:
+            value = int(round(sample * scale))
+            frames += struct.pack("<hh", value, value)
+        output.writeframes(bytes(frames))
+
+
+def write_labels(path, times):
+    with open(path, "w", newline="\n") as output:
+        for time in times:
+            output.write(f"{time:.6f}\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate labelled test tracks for the Holiday Tree beat detector")
+    parser.add_argument("-o", "--output", required=True, help="Directory to write the tracks to")
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    for trackIndex, track in enumerate(TRACKS):
+        generator = random.Random(trackIndex + 1)
+        buffer, onsets, beats = render(track, generator)
+        base = os.path.join(args.output, track["name"])
+        write_wav(base + ".wav", track["rate"], buffer)
+        write_labels(base + ".onsets", onsets)
+        write_labels(base + ".beats", beats)
+        print(f"{track['name']}: {len(onsets)} onsets, {len(beats)} beats")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+
+// -----------------------------------------------------------------------------------
+// FreeRTOS tasks on POSIX threads - Enough for firmware tasks which wait for notifications and process queued work
+// -----------------------------------------------------------------------------------
+
+#define HOST_MAX_TASKS 4
+
+struct host_task {
+    pthread_t thread;
+    TaskFunction_t taskFunction;
+    void* parameters;
+    uint32_t notifications;
+    bool waiting;
+};
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_changed = PTHREAD_COND_INITIALIZER;
+
+static struct host_task s_tasks[HOST_MAX_TASKS];
+static uint32_t s_task_count = 0;
+
+static _Thread_local struct host_task* s_current_task = NULL;
+
+
+static void* run_task(void* argument) {
+    s_current_task = (struct host_task*) argument;
+    s_current_task->taskFunction(s_current_task->parameters);
+    return NULL;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t taskFunction, const char* name, uint32_t stackSize, void* parameters, UBaseType_t priority, TaskHandle_t* taskHandle, BaseType_t coreId) {
+    pthread_mutex_lock(&s_lock);
+    if (s_task_count == HOST_MAX_TASKS) {
+        pthread_mutex_unlock(&s_lock);
+        return pdFAIL;
+    }
+    struct host_task* task = &s_tasks[s_task_count++];
+    task->taskFunction = taskFunction;
+    task->parameters = parameters;
+    task->notifications = 0;
+    task->waiting = false;
+    pthread_mutex_unlock(&s_lock);
+
+    // The handle is set before the task runs, as FreeRTOS does when the creator has the higher priority
+    if (taskHandle != NULL) {
+        *taskHandle = task;
+    }
+    return pthread_create(&task->thread, NULL, run_task, task) == 0 ? pdPASS : pdFAIL;
+}
+
+void xTaskNotifyGiveIndexed(TaskHandle_t taskHandle, UBaseType_t indexToNotify) {
+    pthread_mutex_lock(&s_lock);
+    taskHandle->notifications++;
+    pthread_cond_broadcast(&s_changed);
+    pthread_mutex_unlock(&s_lock);
+}
+
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t indexToWaitOn, BaseType_t clearCountOnExit, TickType_t ticksToWait) {
+    struct host_task* task = s_current_task;
+
+    pthread_mutex_lock(&s_lock);
+    task->waiting = true;
+    pthread_cond_broadcast(&s_changed);
+    while (task->notifications == 0) {
+        pthread_cond_wait(&s_changed, &s_lock);
+    }
+    task->waiting = false;
+
+    const uint32_t notifications = task->notifications;
+    task->notifications = clearCountOnExit ? 0 : notifications - 1;
+    pthread_mutex_unlock(&s_lock);
+    return notifications;
+}
+
+void host_wait_for_idle_tasks() {
+    pthread_mutex_lock(&s_lock);
+    for (;;) {
+        bool idle = true;
+        for (uint32_t taskIndex = 0; taskIndex < s_task_count; taskIndex++) {
+            idle &= s_tasks[taskIndex].waiting && (s_tasks[taskIndex].notifications == 0);
+        }
+        if (idle) {
+            break;
+        }
+        pthread_cond_wait(&s_changed, &s_lock);
+    }
+    pthread_mutex_unlock(&s_lock);
+}
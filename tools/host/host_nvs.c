@@ -0,0 +1,99 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <nvs.h>
+
+
+// -----------------------------------------------------------------------------------
+// NVS in memory - Enough for configuration/nvs_configuration.c: a few blobs, lost when the program exits
+// -----------------------------------------------------------------------------------
+
+#define HOST_NVS_MAX_ENTRIES 8
+#define HOST_NVS_MAX_BLOB_SIZE 4096
+#define HOST_NVS_MAX_NAMESPACES 8
+
+typedef struct {
+    bool used;
+    nvs_handle_t handle;
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    size_t length;
+    uint8_t value[HOST_NVS_MAX_BLOB_SIZE];
+} host_nvs_entry_t;
+
+// Handles are the index of the namespace plus one
+static char s_namespaces[HOST_NVS_MAX_NAMESPACES][NVS_NS_NAME_MAX_SIZE];
+static host_nvs_entry_t s_entries[HOST_NVS_MAX_ENTRIES];
+
+
+static host_nvs_entry_t* find_entry(nvs_handle_t handle, const char* key) {
+    for (uint32_t index = 0; index < HOST_NVS_MAX_ENTRIES; index++) {
+        if (s_entries[index].used && (s_entries[index].handle == handle) && (strncmp(s_entries[index].key, key, NVS_KEY_NAME_MAX_SIZE) == 0)) {
+            return &s_entries[index];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t nvs_open(const char* namespaceName, nvs_open_mode_t openMode, nvs_handle_t* handle) {
+    for (uint32_t index = 0; index < HOST_NVS_MAX_NAMESPACES; index++) {
+        if ((s_namespaces[index][0] == '\0') || (strncmp(s_namespaces[index], namespaceName, NVS_NS_NAME_MAX_SIZE) == 0)) {
+            strncpy(s_namespaces[index], namespaceName, NVS_NS_NAME_MAX_SIZE - 1);
+            *handle = index + 1;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* value, size_t* length) {
+    const host_nvs_entry_t* entry = find_entry(handle, key);
+    if (entry == NULL) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    if (*length < entry->length) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    memcpy(value, entry->value, entry->length);
+    *length = entry->length;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t length) {
+    if (length > HOST_NVS_MAX_BLOB_SIZE) {
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+    host_nvs_entry_t* entry = find_entry(handle, key);
+    for (uint32_t index = 0; (entry == NULL) && (index < HOST_NVS_MAX_ENTRIES); index++) {
+        entry = s_entries[index].used ? NULL : &s_entries[index];
+    }
+    if (entry == NULL) {
+        return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    }
+
+    entry->used = true;
+    entry->handle = handle;
+    strncpy(entry->key, key, NVS_KEY_NAME_MAX_SIZE - 1);
+    memcpy(entry->value, value, length);
+    entry->length = length;
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char* key) {
+    host_nvs_entry_t* entry = find_entry(handle, key);
+    if (entry == NULL) {
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    entry->used = false;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) {
+}
@@ -0,0 +1,108 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "leds/led_math.h"
+
+
+// -----------------------------------------------------------------------------------
+// LED noise over the whole coordinate range on the host
+//
+// Noise is walked one unit at a time along each axis from origins up to the int32 limits: the largest step between
+// neighbours must stay close to the one near 0, and values must keep spanning most of the range. 3D noise must also
+// repeat exactly every LED_NOISE_3D_PERIOD. Build with -fsanitize=undefined to check the arithmetic too
+// -----------------------------------------------------------------------------------
+
+#define NOISE_WALK_UNITS (64 * LED_NOISE_CELL)
+#define NOISE_PERIOD_SAMPLES 100000
+
+// Largest step allowed away from 0, relative to the largest step near 0, and smallest span of values along a walk
+static const int32_t StepMarginPercent = 150;
+static const int32_t MinimumSpan = 32768;
+
+static const int64_t WalkOrigins[] = {
+    0, -12345, 1 << 21, 1 << 24, 1 << 27, 1 << 30, -(1 << 30), INT32_MAX - NOISE_WALK_UNITS, INT32_MIN
+};
+
+typedef struct {
+    int32_t minimum;
+    int32_t maximum;
+    int32_t largestStep;
+} noise_walk_t;
+
+
+static int16_t get_noise(uint32_t dimensions, const int32_t* point) {
+    return dimensions == 2 ? led_noise_2d(point[0], point[1]) : led_noise_3d(point[0], point[1], point[2]);
+}
+
+// Walk NOISE_WALK_UNITS from 'origin' along 'axis' - The other coordinates stay a few cells from 0
+static noise_walk_t walk_noise(uint32_t dimensions, uint32_t axis, int64_t origin) {
+    int32_t point[3];
+    for (uint32_t coordinate = 0; coordinate < dimensions; coordinate++) {
+        point[coordinate] = coordinate == axis ? (int32_t) origin : 3 * LED_NOISE_CELL + 77 * (int32_t) coordinate;
+    }
+
+    noise_walk_t walk = { .minimum = INT32_MAX, .maximum = INT32_MIN, .largestStep = 0 };
+    int32_t previous = get_noise(dimensions, point);
+    for (uint32_t unit = 1; unit < NOISE_WALK_UNITS; unit++) {
+        point[axis]++;
+        const int32_t value = get_noise(dimensions, point);
+        const int32_t step = abs(value - previous);
+        walk.largestStep = step > walk.largestStep ? step : walk.largestStep;
+        walk.minimum = value < walk.minimum ? value : walk.minimum;
+        walk.maximum = value > walk.maximum ? value : walk.maximum;
+        previous = value;
+    }
+    return walk;
+}
+
+static bool check_walks(uint32_t dimensions) {
+    bool passed = true;
+    for (uint32_t axis = 0; axis < dimensions; axis++) {
+        const noise_walk_t reference = walk_noise(dimensions, axis, 0);
+        const int32_t stepLimit = (reference.largestStep * StepMarginPercent) / 100;
+        for (size_t originIndex = 0; originIndex < sizeof(WalkOrigins) / sizeof(WalkOrigins[0]); originIndex++) {
+            const noise_walk_t walk = walk_noise(dimensions, axis, WalkOrigins[originIndex]);
+            const bool walkPassed = (walk.largestStep <= stepLimit) && (walk.maximum - walk.minimum >= MinimumSpan);
+            printf("noise %" PRIu32 "d axis %" PRIu32 " from %11lld  values %6d to %6d  largest step %5d (limit %5d)  %s\n", dimensions, axis,
+                (long long) WalkOrigins[originIndex], walk.minimum, walk.maximum, walk.largestStep, stepLimit, walkPassed ? "ok" : "FAILED");
+            passed &= walkPassed;
+        }
+    }
+    return passed;
+}
+
+static bool check_period() {
+    uint32_t random;
+    seed_led_random(&random, 48);
+
+    uint32_t mismatches = 0;
+    for (uint32_t sample = 0; sample < NOISE_PERIOD_SAMPLES; sample++) {
+        // Any point whose shifted coordinate still fits 32 bits
+        int32_t point[3];
+        for (uint32_t coordinate = 0; coordinate < 3; coordinate++) {
+            point[coordinate] = (int32_t) (next_led_random(&random) >> 1) - (int32_t) (1U << 30);
+        }
+        const int16_t value = led_noise_3d(point[0], point[1], point[2]);
+        const uint32_t axis = sample % 3;
+        point[axis] += LED_NOISE_3D_PERIOD;
+        mismatches += led_noise_3d(point[0], point[1], point[2]) != value ? 1 : 0;
+    }
+
+    const bool passed = mismatches == 0;
+    printf("noise 3d period %d  %" PRIu32 " of %d points differ  %s\n", LED_NOISE_3D_PERIOD, mismatches, NOISE_PERIOD_SAMPLES, passed ? "ok" : "FAILED");
+    return passed;
+}
+
+int main() {
+    bool passed = check_walks(2);
+    passed &= check_walks(3);
+    passed &= check_period();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include <esp_timer.h>
+
+#include "leds/led_framebuffer.h"
+#include "leds/led_program.h"
+
+
+// -----------------------------------------------------------------------------------
+// LED program interpreter cost on the host - Same string lengths and audio levels as 'led_bench program'
+//
+//   led_program_benchmark [frames]
+//
+// Prints the cost per frame and per LED of every built in program
+// -----------------------------------------------------------------------------------
+
+static const uint32_t ProgramBenchmarkLedCounts[] = { 50, 150, 300, 500 };
+static const uint32_t DefaultFrames = 2000;
+
+// Defined by leds/led_internals.c on the target
+const char* LedStringTag = "led_string";
+
+
+int main(int argc, char** argv) {
+    const uint32_t frameCount = argc > 1 ? (uint32_t) strtoul(argv[1], NULL, 10) : DefaultFrames;
+    const uint32_t maximumLedCount = ProgramBenchmarkLedCounts[sizeof(ProgramBenchmarkLedCounts) / sizeof(ProgramBenchmarkLedCounts[0]) - 1];
+    uint8_t* pixels = calloc(maximumLedCount, LED_FRAMEBUFFER_BYTES_PER_PIXEL);
+    if (pixels == NULL) {
+        printf("Not enough memory for the program benchmark\n");
+        return 1;
+    }
+
+    const uint32_t framePeriodUs = 1000000 / CONFIG_HOLIDAYTREE_LEDS_FRAME_RATE;
+    uint32_t random = 1;
+    for (uint32_t index = 0; index < get_led_builtin_program_count(); index++) {
+        const led_builtin_program_t* builtin = get_led_builtin_program(index);
+        led_program_t program;
+        if (load_led_program_code(builtin->instructions, builtin->instructionCount, &program) != ESP_OK) {
+            printf("Built in program '%s' does not check\n", builtin->name);
+            return 1;
+        }
+
+        for (uint32_t countIndex = 0; countIndex < sizeof(ProgramBenchmarkLedCounts) / sizeof(ProgramBenchmarkLedCounts[0]); countIndex++) {
+            led_framebuffer_t framebuffer = { .pixels = pixels, .pixelCount = ProgramBenchmarkLedCounts[countIndex] };
+
+            // Audio levels swept so programs take their loud and quiet branches
+            const int64_t startUs = esp_timer_get_time();
+            for (uint32_t frameIndex = 0; frameIndex < frameCount; frameIndex++) {
+                const led_program_frame_t frame = {
+                    .timeMs = (int32_t) ((frameIndex * framePeriodUs) / 1000),
+                    .bassLevel = (int32_t) ((frameIndex * 8) & 0xFF),
+                    .level = (int32_t) ((frameIndex * 16) & 0xFF),
+                    .beatPhase = (int32_t) ((frameIndex * 32) & 0xFF),
+                    .beatCount = (int32_t) (frameIndex / 8)
+                };
+                run_led_program(&program, &frame, &random, &framebuffer);
+            }
+            const double frameNs = (esp_timer_get_time() - startUs) * 1000.0 / frameCount;
+            printf("%-8s %3" PRIu32 " instructions %4" PRIu32 " LEDs  %10.0f ns/frame  %6.1f ns/LED\n", builtin->name, builtin->instructionCount,
+                framebuffer.pixelCount, frameNs, frameNs / framebuffer.pixelCount);
+        }
+    }
+
+    free(pixels);
+    return 0;
+}
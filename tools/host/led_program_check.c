@@ -0,0 +1,326 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "leds/led_framebuffer.h"
+#include "leds/led_geometry.h"
+#include "leds/led_program.h"
+
+
+// -----------------------------------------------------------------------------------
+// LED program checks on the host - The loader, the interpreter and program staging, run unchanged
+//
+//  * Loader - Built in programs load, bad opcodes, registers, jump targets and sizes are refused
+//  * Interpreter - Input registers, clamping, wrapping arithmetic, division by 0 and INT32_MIN / -1, bounded loops
+//  * Staging - Commit, built in selection, save, load and reset through NVS in memory (host_nvs.c)
+//  * Long runs - Built in programs stay smooth and keep moving days after start up, noise included
+//  * Slots - A thread runs the program effect path while programs of different lengths are committed: every frame
+//    must come whole from one of them. Build with -fsanitize=thread to check the locking too
+// -----------------------------------------------------------------------------------
+
+#define CHECK_LED_COUNT 5
+#define SLOT_CHECK_LED_COUNT 300
+#define SLOT_CHECK_COMMITS 2000
+#define LONG_RUN_LED_COUNT 50
+#define LONG_RUN_FRAMES 500
+
+// Effect times long runs start at - Up to 20 days, shortly before the millisecond clock of the program effect wraps
+static const int64_t LongRunStartsMs[] = { 0, 8280000, 64800000, 1728000000 };
+static const int32_t LongRunFrameMs = 20;
+
+// Largest change of a channel between frames and widest span of a channel, relative to the ones after start up
+static const int32_t LongRunStepMarginPercent = 150;
+static const int32_t LongRunSpanMarginPercent = 50;
+
+// Defined by leds/led_internals.c on the target
+const char* LedStringTag = "led_string";
+
+typedef struct {
+    const char* name;
+    led_program_instruction_t instructions[8];
+    uint32_t instructionCount;
+    esp_err_t expected;
+} loader_case_t;
+
+static const loader_case_t LoaderCases[] = {
+    { "valid", { { LedProgramOpLoad, 10, 1, 0 }, { LedProgramOpRgb, 10, 10, 10 } }, 2, ESP_OK },
+    { "immediates are not registers", { { LedProgramOpLoad, 10, 200, 200 }, { LedProgramOpAddImmediate, 10, 10, 200 } }, 2, ESP_OK },
+    { "jump to the end", { { LedProgramOpJump, 1, 0, 0 } }, 1, ESP_OK },
+    { "jump past the end", { { LedProgramOpJump, 2, 0, 0 } }, 1, ESP_ERR_INVALID_ARG },
+    { "unknown opcode", { { LedProgramOpMax, 0, 0, 0 } }, 1, ESP_ERR_INVALID_ARG },
+    { "bad destination", { { LedProgramOpMove, LED_PROGRAM_REGISTER_COUNT, 0, 0 } }, 1, ESP_ERR_INVALID_ARG },
+    { "bad first operand", { { LedProgramOpAdd, 0, LED_PROGRAM_REGISTER_COUNT, 0 } }, 1, ESP_ERR_INVALID_ARG },
+    { "bad second operand", { { LedProgramOpNoise, 0, 0, LED_PROGRAM_REGISTER_COUNT } }, 1, ESP_ERR_INVALID_ARG },
+    { "empty", { { LedProgramOpEnd, 0, 0, 0 } }, 0, ESP_ERR_INVALID_SIZE }
+};
+
+typedef struct {
+    const char* name;
+    led_program_instruction_t instructions[10];
+    uint32_t instructionCount;
+    uint8_t expected[3];
+} interpreter_case_t;
+
+// 'expected' is the color of every pixel - Registers r10 to r15 start at 0
+static const interpreter_case_t InterpreterCases[] = {
+    { "black without color", { { LedProgramOpLoad, 10, 100, 0 } }, 1, { 0, 0, 0 } },
+    { "clamped channels", { { LedProgramOpLoad, 10, 0x2C, 0x01 }, { LedProgramOpLoad, 11, 0xFB, 0xFF }, { LedProgramOpLoad, 12, 77, 0 }, { LedProgramOpRgb, 10, 11, 12 } }, 4, { 255, 0, 77 } },
+    { "division by 0", { { LedProgramOpLoad, 10, 9, 0 }, { LedProgramOpDivide, 11, 10, 15 }, { LedProgramOpModulo, 12, 10, 15 }, { LedProgramOpRgb, 10, 11, 12 } }, 4, { 9, 0, 0 } },
+    { "INT32_MIN / -1", { { LedProgramOpLoad, 10, 1, 0 }, { LedProgramOpLoad, 11, 31, 0 }, { LedProgramOpShiftLeft, 10, 10, 11 }, { LedProgramOpLoad, 11, 0xFF, 0xFF },
+        { LedProgramOpDivide, 12, 10, 11 }, { LedProgramOpSubtract, 13, 12, 10 }, { LedProgramOpJumpNotZero, 9, 13, 0 }, { LedProgramOpLoad, 14, 255, 0 },
+        { LedProgramOpRgb, 15, 14, 15 } }, 9, { 0, 255, 0 } },
+    { "wrapping add", { { LedProgramOpLoad, 10, 1, 0 }, { LedProgramOpLoad, 11, 31, 0 }, { LedProgramOpShiftLeft, 10, 10, 11 }, { LedProgramOpAddImmediate, 10, 10, 0xFF },
+        { LedProgramOpAddImmediate, 10, 10, 1 }, { LedProgramOpLoad, 12, 255, 0 }, { LedProgramOpJumpLess, 8, 15, 10 }, { LedProgramOpRgb, 12, 15, 15 } }, 8, { 255, 0, 0 } },
+    { "endless loop", { { LedProgramOpLoad, 10, 200, 0 }, { LedProgramOpRgb, 10, 10, 10 }, { LedProgramOpAddImmediate, 10, 10, 1 }, { LedProgramOpJump, 1, 0, 0 } }, 4, { 255, 255, 255 } },
+    { "end stops", { { LedProgramOpLoad, 10, 30, 0 }, { LedProgramOpRgb, 10, 10, 10 }, { LedProgramOpEnd, 0, 0, 0 }, { LedProgramOpRgb, 15, 15, 15 } }, 4, { 30, 30, 30 } }
+};
+
+// Two programs of different lengths for the slot check - 120 increments then red, or green straight away
+static led_program_instruction_t s_long_program[LED_PROGRAM_MAX_INSTRUCTIONS];
+static const uint32_t LongProgramIncrements = 120;
+static const led_program_instruction_t ShortProgram[] = { { LedProgramOpLoad, 11, 50, 0 }, { LedProgramOpRgb, 15, 11, 15 } };
+
+static atomic_bool s_atomic_slot_check_done = false;
+static atomic_uint s_atomic_torn_frames = 0;
+static atomic_uint s_atomic_slot_check_frames = 0;
+
+
+static void run_program(const led_program_t* program, uint8_t* pixels, uint32_t pixelCount) {
+    led_framebuffer_t framebuffer = { .pixels = pixels, .pixelCount = pixelCount };
+    const led_program_frame_t frame = { .timeMs = 1000, .bassLevel = 10, .level = 20, .beatPhase = 30, .beatCount = 4 };
+    uint32_t random = 1;
+    run_led_program(program, &frame, &random, &framebuffer);
+}
+
+static bool check_loader() {
+    bool passed = true;
+    led_program_t program;
+    for (uint32_t index = 0; index < get_led_builtin_program_count(); index++) {
+        const led_builtin_program_t* builtin = get_led_builtin_program(index);
+        const bool casePassed = load_led_program_code(builtin->instructions, builtin->instructionCount, &program) == ESP_OK;
+        printf("loader   built in %-22s %s\n", builtin->name, casePassed ? "ok" : "FAILED");
+        passed &= casePassed;
+    }
+    for (size_t caseIndex = 0; caseIndex < sizeof(LoaderCases) / sizeof(LoaderCases[0]); caseIndex++) {
+        const loader_case_t* loaderCase = &LoaderCases[caseIndex];
+        const bool casePassed = load_led_program_code(loaderCase->instructions, loaderCase->instructionCount, &program) == loaderCase->expected;
+        printf("loader   %-31s %s\n", loaderCase->name, casePassed ? "ok" : "FAILED");
+        passed &= casePassed;
+    }
+    const bool tooLongPassed = load_led_program_code(s_long_program, LED_PROGRAM_MAX_INSTRUCTIONS + 1, &program) == ESP_ERR_INVALID_SIZE;
+    printf("loader   %-31s %s\n", "too long", tooLongPassed ? "ok" : "FAILED");
+    return passed && tooLongPassed;
+}
+
+static bool check_interpreter() {
+    bool passed = true;
+    uint8_t pixels[CHECK_LED_COUNT * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+    led_program_t program;
+    for (size_t caseIndex = 0; caseIndex < sizeof(InterpreterCases) / sizeof(InterpreterCases[0]); caseIndex++) {
+        const interpreter_case_t* interpreterCase = &InterpreterCases[caseIndex];
+        bool casePassed = load_led_program_code(interpreterCase->instructions, interpreterCase->instructionCount, &program) == ESP_OK;
+        memset(pixels, 0xAA, sizeof(pixels));
+        run_program(&program, pixels, CHECK_LED_COUNT);
+        for (uint32_t index = 0; index < CHECK_LED_COUNT; index++) {
+            casePassed &= memcmp(&pixels[index * LED_FRAMEBUFFER_BYTES_PER_PIXEL], interpreterCase->expected, 3) == 0;
+        }
+        printf("run      %-31s %s\n", interpreterCase->name, casePassed ? "ok" : "FAILED");
+        passed &= casePassed;
+    }
+
+    // Input registers - Index and height from the LED geometry, the frame time in ms
+    const led_program_instruction_t inputs[] = { { LedProgramOpLoad, 10, 0xE8, 0x03 }, { LedProgramOpSubtract, 10, 5, 10 }, { LedProgramOpRgb, 0, 3, 10 } };
+    bool inputsPassed = load_led_program_code(inputs, sizeof(inputs) / sizeof(inputs[0]), &program) == ESP_OK;
+    run_program(&program, pixels, CHECK_LED_COUNT);
+    const led_position_t* positions = get_led_positions(CHECK_LED_COUNT);
+    for (uint32_t index = 0; index < CHECK_LED_COUNT; index++) {
+        const uint8_t* pixel = &pixels[index * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+        inputsPassed &= (positions != NULL) && (pixel[0] == index) && (pixel[1] == positions[index].height) && (pixel[2] == 0);
+    }
+    printf("run      %-31s %s\n", "input registers", inputsPassed ? "ok" : "FAILED");
+    return passed && inputsPassed;
+}
+
+static bool check_staging() {
+    // A program which does not check leaves the current one running
+    bool passed = select_led_builtin_program(1) == ESP_OK;
+    const led_program_t* builtin = get_led_program();
+    begin_led_program();
+    const led_program_instruction_t invalid = { LedProgramOpMax, 0, 0, 0 };
+    passed &= add_led_program_instructions(&invalid, 1) == ESP_OK;
+    passed &= commit_led_program() != ESP_OK;
+    passed &= (get_led_program() == builtin) && (builtin->instructions == get_led_builtin_program(1)->instructions);
+    printf("staging  %-31s %s\n", "invalid commit", passed ? "ok" : "FAILED");
+
+    // Staged over several calls, at most LED_PROGRAM_MAX_INSTRUCTIONS
+    begin_led_program();
+    bool stagedPassed = add_led_program_instructions(ShortProgram, 1) == ESP_OK;
+    stagedPassed &= add_led_program_instructions(&ShortProgram[1], 1) == ESP_OK;
+    stagedPassed &= add_led_program_instructions(s_long_program, LED_PROGRAM_MAX_INSTRUCTIONS - 1) == ESP_ERR_INVALID_SIZE;
+    stagedPassed &= commit_led_program() == ESP_OK;
+    const led_program_t* committed = get_led_program();
+    stagedPassed &= (committed->instructionCount == 2) && (memcmp(committed->instructions, ShortProgram, sizeof(ShortProgram)) == 0);
+    printf("staging  %-31s %s\n", "commit", stagedPassed ? "ok" : "FAILED");
+
+    // Saved, replaced, loaded back, then reset to the first built in program
+    bool savedPassed = save_led_program() == ESP_OK;
+    savedPassed &= select_led_builtin_program(2) == ESP_OK;
+    savedPassed &= load_led_program() == ESP_OK;
+    savedPassed &= (get_led_program()->instructionCount == 2) && (memcmp(get_led_program()->instructions, ShortProgram, sizeof(ShortProgram)) == 0);
+    savedPassed &= reset_led_program() == ESP_OK;
+    savedPassed &= get_led_program()->instructions == get_led_builtin_program(0)->instructions;
+    savedPassed &= load_led_program() == ESP_OK;
+    savedPassed &= get_led_program()->instructions == get_led_builtin_program(0)->instructions;
+    printf("staging  %-31s %s\n", "save, load and reset", savedPassed ? "ok" : "FAILED");
+
+    return passed && stagedPassed && savedPassed;
+}
+
+// Largest change of any channel between two frames, and the widest range a channel covers, over LONG_RUN_FRAMES
+static void run_long(const led_program_t* program, int64_t startMs, int32_t* largestStep, int32_t* widestSpan) {
+    static uint8_t pixels[2][LONG_RUN_LED_COUNT * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+    uint8_t minimum[LONG_RUN_LED_COUNT * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+    uint8_t maximum[LONG_RUN_LED_COUNT * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+    memset(minimum, 255, sizeof(minimum));
+    memset(maximum, 0, sizeof(maximum));
+
+    *largestStep = 0;
+    uint32_t random = 1;
+    for (uint32_t frameIndex = 0; frameIndex < LONG_RUN_FRAMES; frameIndex++) {
+        uint8_t* current = pixels[frameIndex & 1];
+        const uint8_t* previous = pixels[(frameIndex & 1) ^ 1];
+        led_framebuffer_t framebuffer = { .pixels = current, .pixelCount = LONG_RUN_LED_COUNT };
+        const led_program_frame_t frame = { .timeMs = (int32_t) (startMs + (int64_t) frameIndex * LongRunFrameMs) };
+        run_led_program(program, &frame, &random, &framebuffer);
+
+        for (uint32_t level = 0; level < sizeof(minimum); level++) {
+            if (frameIndex > 0) {
+                const int32_t step = abs(current[level] - previous[level]);
+                *largestStep = step > *largestStep ? step : *largestStep;
+            }
+            minimum[level] = current[level] < minimum[level] ? current[level] : minimum[level];
+            maximum[level] = current[level] > maximum[level] ? current[level] : maximum[level];
+        }
+    }
+
+    // Some pixels may hold still, ripple waves cancel out a third of the way up - Frozen output has no wide span at all
+    *widestSpan = 0;
+    for (uint32_t level = 0; level < sizeof(minimum); level++) {
+        *widestSpan = maximum[level] - minimum[level] > *widestSpan ? maximum[level] - minimum[level] : *widestSpan;
+    }
+}
+
+static bool check_long_runs() {
+    bool passed = true;
+    for (uint32_t index = 0; index < get_led_builtin_program_count(); index++) {
+        const led_builtin_program_t* builtin = get_led_builtin_program(index);
+        led_program_t program;
+        if (load_led_program_code(builtin->instructions, builtin->instructionCount, &program) != ESP_OK) {
+            return false;
+        }
+
+        int32_t referenceStep = 0;
+        int32_t referenceSpan = 0;
+        run_long(&program, LongRunStartsMs[0], &referenceStep, &referenceSpan);
+        const int32_t stepLimit = (referenceStep * LongRunStepMarginPercent) / 100;
+        const int32_t spanLimit = (referenceSpan * LongRunSpanMarginPercent) / 100;
+        for (size_t startIndex = 0; startIndex < sizeof(LongRunStartsMs) / sizeof(LongRunStartsMs[0]); startIndex++) {
+            int32_t largestStep = 0;
+            int32_t widestSpan = 0;
+            run_long(&program, LongRunStartsMs[startIndex], &largestStep, &widestSpan);
+            const bool runPassed = (largestStep <= stepLimit) && (widestSpan >= spanLimit);
+            printf("long run %-8s from %5.1f h  largest step %3d (limit %3d)  widest span %3d (limit %3d)  %s\n", builtin->name,
+                LongRunStartsMs[startIndex] / 3600000.0, largestStep, stepLimit, widestSpan, spanLimit, runPassed ? "ok" : "FAILED");
+            passed &= runPassed;
+        }
+    }
+    return passed;
+}
+
+static void* run_program_effect_frames(void* arg) {
+    // Every pixel of a frame must come from the same complete program
+    static uint8_t pixels[SLOT_CHECK_LED_COUNT * LED_FRAMEBUFFER_BYTES_PER_PIXEL];
+    static const uint8_t LongColor[3] = { 120, 0, 0 };
+    static const uint8_t ShortColor[3] = { 0, 50, 0 };
+    led_framebuffer_t framebuffer = { .pixels = pixels, .pixelCount = SLOT_CHECK_LED_COUNT };
+    const led_program_frame_t frame = { 0 };
+    uint32_t random = 1;
+    while (!atomic_load(&s_atomic_slot_check_done)) {
+        if (!run_current_led_program(&frame, &random, &framebuffer)) {
+            continue;
+        }
+        const uint8_t* expected = pixels[0] == LongColor[0] ? LongColor : ShortColor;
+        for (uint32_t index = 0; index < SLOT_CHECK_LED_COUNT; index++) {
+            if (memcmp(&pixels[index * LED_FRAMEBUFFER_BYTES_PER_PIXEL], expected, 3) != 0) {
+                atomic_fetch_add(&s_atomic_torn_frames, 1);
+                break;
+            }
+        }
+        atomic_fetch_add(&s_atomic_slot_check_frames, 1);
+
+        // Frames are periodic on the target - Give the committing thread the lock between them
+        sched_yield();
+    }
+    return NULL;
+}
+
+static bool check_slots() {
+    // The effect thread starts on one of the two programs
+    begin_led_program();
+    bool passed = add_led_program_instructions(ShortProgram, sizeof(ShortProgram) / sizeof(ShortProgram[0])) == ESP_OK;
+    passed &= commit_led_program() == ESP_OK;
+
+    pthread_t effectThread;
+    if (pthread_create(&effectThread, NULL, &run_program_effect_frames, NULL) != 0) {
+        printf("slots    Cannot start the effect thread\n");
+        return false;
+    }
+
+    // Long and short programs committed back to back - Each one is staged over the slot the previous frame ran from
+    for (uint32_t commit = 0; commit < SLOT_CHECK_COMMITS; commit++) {
+        begin_led_program();
+        if (commit & 1) {
+            passed &= add_led_program_instructions(ShortProgram, sizeof(ShortProgram) / sizeof(ShortProgram[0])) == ESP_OK;
+        } else {
+            passed &= add_led_program_instructions(s_long_program, LongProgramIncrements + 1) == ESP_OK;
+        }
+        passed &= commit_led_program() == ESP_OK;
+
+        // Frames and commits interleave - Waiting for a frame here would hand the slots over without the lock
+        sched_yield();
+    }
+    atomic_store(&s_atomic_slot_check_done, true);
+    pthread_join(effectThread, NULL);
+
+    const uint32_t tornFrames = atomic_load(&s_atomic_torn_frames);
+    passed &= tornFrames == 0;
+    printf("slots    %" PRIu32 " commits, %u frames, %" PRIu32 " torn  %s\n", (uint32_t) SLOT_CHECK_COMMITS, atomic_load(&s_atomic_slot_check_frames), tornFrames, passed ? "ok" : "FAILED");
+    return passed;
+}
+
+int main() {
+    for (uint32_t index = 0; index < LongProgramIncrements; index++) {
+        s_long_program[index] = (led_program_instruction_t) { LedProgramOpAddImmediate, 10, 10, 1 };
+    }
+    s_long_program[LongProgramIncrements] = (led_program_instruction_t) { LedProgramOpRgb, 10, 15, 15 };
+    if (load_led_geometry(CHECK_LED_COUNT) != ESP_OK) {
+        printf("Cannot load the LED geometry\n");
+        return 1;
+    }
+
+    bool passed = check_loader();
+    passed &= check_interpreter();
+    passed &= check_staging();
+    passed &= check_long_runs();
+    passed &= check_slots();
+    return passed ? 0 : 1;
+}
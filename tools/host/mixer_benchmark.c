@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include <esp_timer.h>
+
+#include "audio/audio_mixer.h"
+#include "audio/audio_resampler.h"
+
+
+// -----------------------------------------------------------------------------------
+// Mixer cost on the host - Same blocks as 'audio_bench mixer': 1023 stereo frames at 44.1kHz, A2DP audio with 0 to
+// CONFIG_HOLIDAYTREE_AUDIO_MIXER_VOICES effect voices playing 22.05kHz synthetic ADPCM
+//
+//   mixer_benchmark [iterations]
+//
+// Prints the cost per output frame for each voice count and the cost of one effect voice
+// -----------------------------------------------------------------------------------
+
+#define MIXER_BENCHMARK_FRAMES 1023
+
+static const uint32_t MixerBenchmarkSampleRate = 44100;
+static const uint32_t DefaultIterations = 2000;
+
+static const size_t SyntheticAdpcmBlockSize = 256;
+static const size_t SyntheticAdpcmBlockCount = 16;
+static const uint32_t SyntheticAdpcmSampleRate = 22050;
+
+
+static uint8_t* create_synthetic_adpcm_data(size_t* dataSize, uint32_t* sampleCount) {
+    // Pseudo random nibbles behind valid block headers - Long enough for a voice to play through a whole block
+    const size_t syntheticSize = SyntheticAdpcmBlockSize * SyntheticAdpcmBlockCount;
+    uint8_t* syntheticData = malloc(syntheticSize);
+    if (syntheticData == NULL) {
+        return NULL;
+    }
+
+    uint32_t seed = 0x12345678;
+    for (size_t offset = 0; offset < syntheticSize; offset++) {
+        seed = seed * 1664525 + 1013904223;
+        syntheticData[offset] = (offset % SyntheticAdpcmBlockSize) < 4 ? 0 : (uint8_t) (seed >> 24);
+    }
+    for (size_t offset = 0; offset < syntheticSize; offset += SyntheticAdpcmBlockSize) {
+        syntheticData[offset + 2] = 40;
+    }
+
+    *dataSize = syntheticSize;
+    *sampleCount = SyntheticAdpcmBlockCount * (1 + 2 * (SyntheticAdpcmBlockSize - 4));
+    return syntheticData;
+}
+
+int main(int argc, char** argv) {
+    const uint32_t iterations = argc > 1 ? (uint32_t) strtoul(argv[1], NULL, 10) : DefaultIterations;
+
+    size_t syntheticSize = 0;
+    uint32_t syntheticSampleCount = 0;
+    uint8_t* syntheticData = create_synthetic_adpcm_data(&syntheticSize, &syntheticSampleCount);
+    int16_t* samples = malloc(MIXER_BENCHMARK_FRAMES * 2 * sizeof(int16_t));
+    audio_mixer_t* mixer = malloc(sizeof(audio_mixer_t));
+    if ((syntheticData == NULL) || (samples == NULL) || (mixer == NULL)) {
+        printf("Not enough memory for the mixer benchmark\n");
+        return 1;
+    }
+    audio_resampler_coefficients_init();
+    audio_mixer_init(mixer);
+
+    const sound_bank_sound_t syntheticSound = {
+        .data = syntheticData,
+        .dataSize = syntheticSize,
+        .sampleCount = syntheticSampleCount,
+        .sampleRate = SyntheticAdpcmSampleRate,
+        .blockSize = SyntheticAdpcmBlockSize
+    };
+
+    double nsPerFrame[AUDIO_MIXER_EFFECT_VOICES + 1];
+    for (uint32_t voiceCount = 0; voiceCount <= AUDIO_MIXER_EFFECT_VOICES; voiceCount++) {
+        int64_t elapsedUs = 0;
+        uint64_t frames = 0;
+        for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+            for (uint32_t voice = 0; voice < voiceCount; voice++) {
+                if (start_audio_mixer_voice(mixer, &syntheticSound, AudioMixerUnityGain / 2) == AudioMixerNoVoice) {
+                    printf("No free mixer voice for voice %" PRIu32 "\n", voice);
+                    return 1;
+                }
+            }
+            for (uint32_t sampleIndex = 0; sampleIndex < MIXER_BENCHMARK_FRAMES * 2; sampleIndex++) {
+                samples[sampleIndex] = (int16_t) (sampleIndex * 97);
+            }
+
+            const int64_t startUs = esp_timer_get_time();
+            mix_audio_block(mixer, samples, MIXER_BENCHMARK_FRAMES, 2, MixerBenchmarkSampleRate, true, AudioMixerUnityGain);
+            elapsedUs += esp_timer_get_time() - startUs;
+            frames += MIXER_BENCHMARK_FRAMES;
+
+            // Release the voices outside of the measurement
+            stop_all_audio_mixer_voices(mixer);
+            mix_audio_block(mixer, samples, MIXER_BENCHMARK_FRAMES, 2, MixerBenchmarkSampleRate, false, AudioMixerUnityGain);
+        }
+        if (are_audio_mixer_voices_active(mixer)) {
+            printf("Mixer voices still active after being stopped\n");
+            return 1;
+        }
+
+        nsPerFrame[voiceCount] = elapsedUs * 1000.0 / frames;
+        printf("mixer (%" PRIu32 " voices)     %8.2f ns/frame\n", voiceCount, nsPerFrame[voiceCount]);
+    }
+
+    if (AUDIO_MIXER_EFFECT_VOICES > 0) {
+        const double voiceNsPerFrame = (nsPerFrame[AUDIO_MIXER_EFFECT_VOICES] - nsPerFrame[0]) / AUDIO_MIXER_EFFECT_VOICES;
+        printf("mixer (per voice)    %8.2f ns/frame, %.1f times the A2DP stream alone\n", voiceNsPerFrame, voiceNsPerFrame / nsPerFrame[0]);
+    }
+
+    free(syntheticData);
+    free(samples);
+    free(mixer);
+    return 0;
+}
@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "audio/audio_resampler.h"
+
+
+// -----------------------------------------------------------------------------------
+// Resampler distortion and noise (THD+N) on the host
+//
+// A -6dBFS sine is converted, then the best fitting sine at the same frequency is removed from the output: what is
+// left is distortion, aliasing, phase quantization and rounding noise. Fails when a conversion exceeds its limit
+// -----------------------------------------------------------------------------------
+
+#define THDN_INPUT_FRAMES 16384
+#define THDN_OUTPUT_FRAMES (3 * THDN_INPUT_FRAMES)
+
+// Output frames left out of the fit while the filter history fills
+#define THDN_SETTLING_FRAMES 64
+
+static const float SineAmplitude = 16384.0f;
+
+typedef struct {
+    uint32_t inputRate;
+    uint32_t outputRate;
+    uint8_t channelCount;
+    float frequency;
+    float limitDb;
+} thdn_case_t;
+
+static const thdn_case_t ThdnCases[] = {
+    { .inputRate = 44100, .outputRate = 48000, .channelCount = 2, .frequency = 997.0f, .limitDb = -60.0f },
+    { .inputRate = 48000, .outputRate = 44100, .channelCount = 2, .frequency = 997.0f, .limitDb = -60.0f },
+    { .inputRate = 32000, .outputRate = 48000, .channelCount = 2, .frequency = 997.0f, .limitDb = -60.0f },
+    { .inputRate = 22050, .outputRate = 48000, .channelCount = 1, .frequency = 997.0f, .limitDb = -55.0f },
+    { .inputRate = 44100, .outputRate = 48000, .channelCount = 2, .frequency = 6000.0f, .limitDb = -45.0f },
+    { .inputRate = 48000, .outputRate = 44100, .channelCount = 2, .frequency = 15000.0f, .limitDb = -35.0f }
+};
+
+
+static int16_t s_input[THDN_INPUT_FRAMES * AUDIO_RESAMPLER_MAX_CHANNELS];
+static int16_t s_output[THDN_OUTPUT_FRAMES * AUDIO_RESAMPLER_MAX_CHANNELS];
+
+
+// Residual energy over signal energy, in dB, of 'samples' after removing the best fitting sine of 'frequency'
+static double measure_thdn(const int16_t* samples, uint32_t frameCount, uint8_t channelCount, uint8_t channel, double frequency, double sampleRate) {
+    // Least squares fit of a * sin + b * cos + c - Normal equations solved by Cramer's rule
+    double sums[3][3] = { { 0 } };
+    double projections[3] = { 0 };
+    for (uint32_t frame = THDN_SETTLING_FRAMES; frame < frameCount; frame++) {
+        const double angle = 2.0 * M_PI * frequency * frame / sampleRate;
+        const double basis[3] = { sin(angle), cos(angle), 1.0 };
+        const double sample = samples[frame * channelCount + channel];
+        for (uint32_t row = 0; row < 3; row++) {
+            for (uint32_t column = 0; column < 3; column++) {
+                sums[row][column] += basis[row] * basis[column];
+            }
+            projections[row] += basis[row] * sample;
+        }
+    }
+
+    const double determinant =
+        sums[0][0] * (sums[1][1] * sums[2][2] - sums[1][2] * sums[2][1]) -
+        sums[0][1] * (sums[1][0] * sums[2][2] - sums[1][2] * sums[2][0]) +
+        sums[0][2] * (sums[1][0] * sums[2][1] - sums[1][1] * sums[2][0]);
+    double coefficients[3];
+    for (uint32_t unknown = 0; unknown < 3; unknown++) {
+        double matrix[3][3];
+        for (uint32_t row = 0; row < 3; row++) {
+            for (uint32_t column = 0; column < 3; column++) {
+                matrix[row][column] = column == unknown ? projections[row] : sums[row][column];
+            }
+        }
+        coefficients[unknown] = (
+            matrix[0][0] * (matrix[1][1] * matrix[2][2] - matrix[1][2] * matrix[2][1]) -
+            matrix[0][1] * (matrix[1][0] * matrix[2][2] - matrix[1][2] * matrix[2][0]) +
+            matrix[0][2] * (matrix[1][0] * matrix[2][1] - matrix[1][1] * matrix[2][0])) / determinant;
+    }
+
+    double signalEnergy = 0.0;
+    double residualEnergy = 0.0;
+    for (uint32_t frame = THDN_SETTLING_FRAMES; frame < frameCount; frame++) {
+        const double angle = 2.0 * M_PI * frequency * frame / sampleRate;
+        const double fitted = coefficients[0] * sin(angle) + coefficients[1] * cos(angle) + coefficients[2];
+        const double residual = samples[frame * channelCount + channel] - fitted;
+        signalEnergy += fitted * fitted;
+        residualEnergy += residual * residual;
+    }
+
+    return 10.0 * log10(residualEnergy / signalEnergy);
+}
+
+int main() {
+    audio_resampler_coefficients_init();
+
+    bool passed = true;
+    static audio_resampler_t resampler;
+    for (size_t caseIndex = 0; caseIndex < sizeof(ThdnCases) / sizeof(ThdnCases[0]); caseIndex++) {
+        const thdn_case_t* thdnCase = &ThdnCases[caseIndex];
+
+        // Same sine on every channel, a quarter turn apart so channels cannot be swapped unnoticed
+        for (uint32_t frame = 0; frame < THDN_INPUT_FRAMES; frame++) {
+            for (uint8_t channel = 0; channel < thdnCase->channelCount; channel++) {
+                const double angle = 2.0 * M_PI * thdnCase->frequency * frame / thdnCase->inputRate + channel * M_PI / 2.0;
+                s_input[frame * thdnCase->channelCount + channel] = (int16_t) lrint(SineAmplitude * sin(angle));
+            }
+        }
+
+        // Fed in uneven blocks like the I2S task does
+        audio_resampler_init(&resampler, thdnCase->inputRate, thdnCase->outputRate, thdnCase->channelCount);
+        uint32_t inputFrame = 0;
+        uint32_t outputFrames = 0;
+        while (inputFrame < THDN_INPUT_FRAMES) {
+            const uint32_t blockFrames = THDN_INPUT_FRAMES - inputFrame < 301 ? THDN_INPUT_FRAMES - inputFrame : 301;
+            uint32_t consumed = 0;
+            outputFrames += resample_audio(&resampler, &s_input[inputFrame * thdnCase->channelCount], blockFrames, &consumed,
+                &s_output[outputFrames * thdnCase->channelCount], THDN_OUTPUT_FRAMES - outputFrames);
+            inputFrame += consumed;
+        }
+
+        const uint32_t expectedFrames = (uint32_t) (((uint64_t) THDN_INPUT_FRAMES * thdnCase->outputRate) / thdnCase->inputRate);
+        const bool rateCorrect = (outputFrames + 1 >= expectedFrames) && (outputFrames <= expectedFrames + 1);
+
+        double worstDb = -200.0;
+        for (uint8_t channel = 0; channel < thdnCase->channelCount; channel++) {
+            const double thdnDb = measure_thdn(s_output, outputFrames, thdnCase->channelCount, channel, thdnCase->frequency, thdnCase->outputRate);
+            worstDb = thdnDb > worstDb ? thdnDb : worstDb;
+        }
+
+        const bool casePassed = rateCorrect && (worstDb <= thdnCase->limitDb);
+        printf("src %5u>%5u %-6s %6.0f Hz  THD+N %6.1f dB (limit %5.1f dB)  %u frames  %s\n", (unsigned) thdnCase->inputRate, (unsigned) thdnCase->outputRate,
+            thdnCase->channelCount == 1 ? "mono" : "stereo", thdnCase->frequency, worstDb, thdnCase->limitDb, (unsigned) outputFrames, casePassed ? "ok" : "FAILED");
+        passed &= casePassed;
+    }
+
+    return passed ? 0 : 1;
+}
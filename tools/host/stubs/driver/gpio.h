@@ -0,0 +1,14 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+
+
+// -----------------------------------------------------------------------------------
+// Host stand in for the GPIO driver types named by leds/led_internals.h
+// -----------------------------------------------------------------------------------
+
+typedef int32_t gpio_num_t;
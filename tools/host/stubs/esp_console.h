@@ -0,0 +1,21 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "esp_err.h"
+
+
+// -----------------------------------------------------------------------------------
+// Host stand in for the console command type - Host builds leave CONFIG_HOLIDAYTREE_CONSOLE off
+// -----------------------------------------------------------------------------------
+
+typedef int (*esp_console_cmd_func_t)(int argc, char** argv);
+
+typedef struct {
+    const char* command;
+    const char* help;
+    const char* hint;
+    esp_console_cmd_func_t func;
+} esp_console_cmd_t;
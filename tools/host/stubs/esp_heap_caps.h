@@ -0,0 +1,31 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+// -----------------------------------------------------------------------------------
+// Host stand in for the capabilities based heap - Capabilities are ignored
+// -----------------------------------------------------------------------------------
+
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+static inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+    return malloc(size);
+}
+
+static inline void* heap_caps_calloc(size_t count, size_t size, uint32_t caps) {
+    return calloc(count, size);
+}
+
+static inline void heap_caps_free(void* pointer) {
+    free(pointer);
+}
@@ -0,0 +1,19 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+
+// -----------------------------------------------------------------------------------
+// Host stand in for the ESP-IDF timer - Microseconds of the monotonic clock
+// -----------------------------------------------------------------------------------
+
+static inline int64_t esp_timer_get_time() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
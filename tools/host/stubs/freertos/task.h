@@ -0,0 +1,27 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+
+
+// -----------------------------------------------------------------------------------
+// Host stand in for FreeRTOS tasks and task notifications - Tasks are POSIX threads, see host_freertos.c
+//
+// Only what the firmware sources built on the host use: waits are always portMAX_DELAY and notification indexes
+// are ignored (each task has a single notification counter)
+// -----------------------------------------------------------------------------------
+
+typedef struct host_task* TaskHandle_t;
+typedef void (*TaskFunction_t)(void* parameters);
+
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t taskFunction, const char* name, uint32_t stackSize, void* parameters, UBaseType_t priority, TaskHandle_t* taskHandle, BaseType_t coreId);
+
+void xTaskNotifyGiveIndexed(TaskHandle_t taskHandle, UBaseType_t indexToNotify);
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t indexToWaitOn, BaseType_t clearCountOnExit, TickType_t ticksToWait);
+
+// Host only - Returns once every task waits for a notification with none pending, so the work handed over is done
+void host_wait_for_idle_tasks();
@@ -0,0 +1,21 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include "esp_err.h"
+#include "driver/gpio.h"
+
+
+// -----------------------------------------------------------------------------------
+// Host stand in for the led_strip component types named by leds/led_internals.h - No device is ever created
+// -----------------------------------------------------------------------------------
+
+typedef struct led_strip_t* led_strip_handle_t;
+
+typedef enum {
+    SPI1_HOST = 0,
+    SPI2_HOST = 1,
+    SPI3_HOST = 2
+} spi_host_device_t;
@@ -0,0 +1,26 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+
+// -----------------------------------------------------------------------------------
+// Host configuration - The Kconfig defaults of the options read by the sources built on the host
+// -----------------------------------------------------------------------------------
+
+#define CONFIG_HOLIDAYTREE_AUDIO_MIXER_VOICES 2
+#define CONFIG_HOLIDAYTREE_AUDIO_MIXER_DUCKING_PERCENT 30
+
+#define CONFIG_HOLIDAYTREE_AUDIO_ANALYSIS 1
+#define CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM 1
+#define CONFIG_HOLIDAYTREE_AUDIO_SPECTRUM_BANDS 16
+#define CONFIG_HOLIDAYTREE_AUDIO_BEAT_DETECTION 1
+
+#define CONFIG_HOLIDAYTREE_LEDS_COUNT 5
+#define CONFIG_HOLIDAYTREE_LEDS_CHANNELS 1
+#define CONFIG_HOLIDAYTREE_LEDS_FRAME_RATE 50
+#define CONFIG_HOLIDAYTREE_LEDS_GEOMETRY_SPIRAL_TURNS 8
+#define CONFIG_HOLIDAYTREE_LEDS_PROGRAMS 1
+
+#define CONFIG_BT_BLUEDROID_PINNED_TO_CORE 0
@@ -0,0 +1,22 @@
+// -----------------------------------------------------------------------------------
+// Copyright 2026, Gilles Zunino
+// -----------------------------------------------------------------------------------
+
+#pragma once
+
+#include <pthread.h>
+
+
+// -----------------------------------------------------------------------------------
+// Host stand in for the newlib locks of ESP-IDF - A zeroed _lock_t is ready to use, like a static one on the target
+// -----------------------------------------------------------------------------------
+
+typedef pthread_mutex_t _lock_t;
+
+static inline void _lock_acquire(_lock_t* lock) {
+    pthread_mutex_lock(lock);
+}
+
+static inline void _lock_release(_lock_t* lock) {
+    pthread_mutex_unlock(lock);
+}